@@ -0,0 +1,310 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: benchmark_filter.cpp
+ * Author: Mohammed Boujemaoui
+ * Date: 29/10/2018
+ */
+
+#include <edsp/auditory/erbspace.hpp>
+#include <edsp/filter.hpp>
+#include <edsp/windowing.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <vector>
+
+constexpr auto block_size = 4096;
+
+template <typename T>
+void FirDirectForm(benchmark::State& state) {
+    std::vector<T> coefficients(state.range(0)), input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(coefficients), std::end(coefficients));
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::fir<T> filter(std::cbegin(coefficients), std::cend(coefficients));
+    filter.set_fft_threshold(std::numeric_limits<std::size_t>::max());
+    for (auto _ : state) {
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void FirOverlapSave(benchmark::State& state) {
+    std::vector<T> coefficients(state.range(0)), input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(coefficients), std::end(coefficients));
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::fir<T> filter(std::cbegin(coefficients), std::cend(coefficients));
+    filter.set_fft_threshold(0);
+    for (auto _ : state) {
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void MovingPeak(benchmark::State& state) {
+    const auto window = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::moving_peak<T, 4096> meter(window);
+    for (auto _ : state) {
+        meter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void OctaveBankFlat(benchmark::State& state) {
+    // Ten octaves of third-octave bands, every band designed and filtered at the full sampling rate
+    using namespace edsp::filter;
+    const auto fs = T(48000);
+    std::vector<T> input(block_size), output(block_size), levels(30);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    std::vector<biquad_cascade<T, 4>> filters;
+    std::vector<moving_rms<T>> meters(30, moving_rms<T>(6000));
+    const auto half_band = std::pow(T(2), T(1) / 6);
+    for (auto band = 0; band < 30; ++band) {
+        const auto center = T(16000) * std::pow(T(2), -T(29 - band) / 3);
+        const auto lower = center / half_band, upper = center * half_band;
+        filters.push_back(make_filter<T, designer_type::Butterworth, filter_type::BandPass, 4>(
+            3ul, fs, (lower + upper) / 2, upper - lower));
+    }
+    for (auto _ : state) {
+        for (auto band = 0; band < 30; ++band) {
+            filters[band].filter(std::cbegin(input), std::cend(input), std::begin(output));
+            meters[band].filter(std::cbegin(output), std::cend(output), std::begin(output));
+            levels[band] = output.back();
+        }
+        benchmark::DoNotOptimize(levels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void OctaveBankMultirate(benchmark::State& state) {
+    std::vector<T> input(block_size), levels(30);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::octave_bank<T> bank(T(48000), T(16000), 10, 3);
+    for (auto _ : state) {
+        bank.filter(std::cbegin(input), std::cend(input));
+        bank.levels(std::begin(levels));
+        benchmark::DoNotOptimize(levels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void GammatonePerBand(benchmark::State& state) {
+    // Every band filtered on its own with std::complex, as a straightforward implementation would do
+    const auto bands = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(block_size), envelope(block_size * bands), frequencies(bands);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::auditory::erbspace(std::begin(frequencies), T(50), T(8000), bands);
+    std::vector<std::complex<T>> poles(bands), states(4 * bands);
+    std::vector<T> gains(bands);
+    for (auto k = 0ul; k < bands; ++k) {
+        const auto lambda = std::exp(-2 * edsp::constants<T>::pi * (T(24.7) + frequencies[k] / T(9.26449)) /
+                                     (T(0.98175) * T(44100)));
+        poles[k] = std::polar(lambda, 2 * edsp::constants<T>::pi * frequencies[k] / T(44100));
+        gains[k] = 2 * std::pow(1 - lambda, T(4));
+    }
+    for (auto _ : state) {
+        for (auto k = 0ul; k < bands; ++k) {
+            for (auto i = 0ul; i < input.size(); ++i) {
+                auto value = std::complex<T>(gains[k] * input[i], 0);
+                for (auto stage = 0; stage < 4; ++stage) {
+                    value = states[4 * k + stage] = value + poles[k] * states[4 * k + stage];
+                }
+                envelope[i * bands + k] = std::abs(value);
+            }
+        }
+        benchmark::DoNotOptimize(envelope.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void GammatoneBank(benchmark::State& state) {
+    const auto bands = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(block_size), envelope(block_size * bands);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::gammatone_bank<T> bank(T(44100), T(50), T(8000), bands);
+    for (auto _ : state) {
+        bank.envelope(std::cbegin(input), std::cend(input), std::begin(envelope));
+        benchmark::DoNotOptimize(envelope.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void ResponsePerStage(benchmark::State& state) {
+    using namespace edsp::filter;
+    const auto points  = static_cast<std::size_t>(state.range(0));
+    const auto cascade = make_filter<T, designer_type::Butterworth, filter_type::LowPass, 8>(8ul, T(44100), T(1000));
+    std::vector<std::complex<T>> stage(points), response(points);
+    for (auto _ : state) {
+        std::fill(std::begin(response), std::end(response), std::complex<T>(1, 0));
+        for (const auto& biquad : cascade) {
+            const T b[] = {biquad.b0(), biquad.b1(), biquad.b2()}, a[] = {biquad.a0(), biquad.a1(), biquad.a2()};
+            freq(std::cbegin(b), std::cend(b), std::cbegin(a), std::cend(a), std::begin(stage), points);
+            std::transform(std::cbegin(stage), std::cend(stage), std::cbegin(response), std::begin(response),
+                           std::multiplies<std::complex<T>>());
+        }
+        benchmark::DoNotOptimize(response.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+}
+
+template <typename T>
+void ResponseFreqz(benchmark::State& state) {
+    using namespace edsp::filter;
+    const auto points  = static_cast<std::size_t>(state.range(0));
+    const auto cascade = make_filter<T, designer_type::Butterworth, filter_type::LowPass, 8>(8ul, T(44100), T(1000));
+    for (auto _ : state) {
+        const auto response = freqz(cascade, points);
+        benchmark::DoNotOptimize(response.magnitude.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+}
+
+template <typename T>
+void BiquadStatic(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    auto filter = make_filter<T, designer_type::RBJ, filter_type::LowPass, 1>(T(1000), T(44100), T(0.707));
+    for (auto _ : state) {
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void BiquadSilent(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size, T(0)), output(block_size);
+    auto filter = make_filter<T, designer_type::RBJ, filter_type::LowPass, 1>(T(1000), T(44100), T(0.707));
+    for (auto _ : state) {
+        // Every block is the decaying tail of an impulse, which crosses the denormal range when unprotected
+        input.front() = state.range(0) ? T(1) : T(0);
+        filter.reset();
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void BiquadSilentTick(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size, T(0)), output(block_size);
+    auto filter = make_filter<T, designer_type::RBJ, filter_type::LowPass, 1>(T(1000), T(44100), T(0.707));
+    for (auto _ : state) {
+        // Same tail through the per-sample path, without the guard or the offset
+        input.front() = state.range(0) ? T(1) : T(0);
+        filter.reset();
+        std::transform(std::cbegin(input), std::cend(input), std::begin(output),
+                       [&filter](const T value) { return filter.tick(value); });
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void CascadeRecursive(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    auto filter = make_filter<T, designer_type::Butterworth, filter_type::LowPass, 8>(8ul, T(1e6), T(2e4));
+    for (auto _ : state) {
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T, std::size_t K>
+void CascadeLookahead(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    lookahead_cascade<T, K> filter(
+        make_filter<T, designer_type::Butterworth, filter_type::LowPass, 8>(8ul, T(1e6), T(2e4)));
+    for (auto _ : state) {
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void BiquadModulated(benchmark::State& state) {
+    using namespace edsp::filter;
+    std::vector<T> input(block_size), output(block_size);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    const auto rbj = designer<T, designer_type::RBJ, 1>{};
+    smoothed_biquad<T> filter(rbj.template design<filter_type::LowPass>(T(1000), T(44100), T(0.707)));
+    auto cutoff = T(1000);
+    for (auto _ : state) {
+        // A new target for every block, as an automated parameter would do
+        cutoff = (cutoff > 10000) ? T(1000) : cutoff * T(1.1);
+        filter.set_target(rbj.template design<filter_type::LowPass>(cutoff, T(44100), T(0.707)));
+        filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size);
+}
+
+template <typename T>
+void MovingRms(benchmark::State& state) {
+    // A bank of level meters: one 10 ms window per interleaved channel
+    const auto channels = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(block_size * channels), output(block_size * channels);
+    edsp::windowing::hamming(std::begin(input), std::end(input));
+    edsp::filter::moving_rms<T> meter(441, channels);
+    for (auto _ : state) {
+        meter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * block_size * channels);
+}
+
+BENCHMARK_TEMPLATE(BiquadStatic, float);
+BENCHMARK_TEMPLATE(BiquadModulated, float);
+BENCHMARK_TEMPLATE(CascadeRecursive, float);
+BENCHMARK_TEMPLATE(CascadeLookahead, float, 6);
+BENCHMARK_TEMPLATE(CascadeLookahead, float, 14);
+BENCHMARK_TEMPLATE(BiquadSilent, float)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BiquadSilentTick, float)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(MovingRms, float)->Arg(1)->Arg(512);
+BENCHMARK_TEMPLATE(MovingPeak, float)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(OctaveBankFlat, float);
+BENCHMARK_TEMPLATE(OctaveBankMultirate, float);
+BENCHMARK_TEMPLATE(GammatonePerBand, float)->Arg(32)->Arg(64);
+BENCHMARK_TEMPLATE(GammatoneBank, float)->Arg(32)->Arg(64);
+BENCHMARK_TEMPLATE(ResponsePerStage, double)->Arg(1024);
+BENCHMARK_TEMPLATE(ResponseFreqz, double)->Arg(1024);
+BENCHMARK_TEMPLATE(FirDirectForm, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(FirOverlapSave, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: benchmark_io.cpp
+ * Author: Mohammed Boujemaoui
+ * Date: 28/10/2018
+ */
+
+#include <edsp/io/decoder.hpp>
+#include <edsp/io/encoder.hpp>
+#include <edsp/io/parallel_decoder.hpp>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr auto benchmark_file = "edsp_benchmark_io.wav";
+    constexpr auto channels       = 2;
+    constexpr auto samplerate     = 48000;
+    constexpr auto frames         = samplerate * 600;
+
+    // Ten minutes of stereo audio at 24 bits, written once for all the benchmarks
+    void create_file() {
+        static const auto created = []() {
+            edsp::io::encoder<float> encoder;
+            std::vector<float> block(channels * samplerate);
+            encoder.open(benchmark_file, channels, samplerate, edsp::io::pcm_format::int24);
+            for (auto i = 0; i < frames / samplerate; ++i) {
+                for (auto j = 0; j < channels * samplerate; ++j) {
+                    block[j] = static_cast<float>(0.5 * std::sin(0.01 * (i * channels * samplerate + j)));
+                }
+                encoder.write(std::cbegin(block), std::cend(block));
+            }
+            encoder.close();
+            return true;
+        }();
+        benchmark::DoNotOptimize(created);
+    }
+} // namespace
+
+template <typename T>
+void SequentialDecoding(benchmark::State& state) {
+    create_file();
+    std::vector<T> output(channels * frames);
+    for (auto _ : state) {
+        edsp::io::decoder<T> decoder;
+        decoder.open(benchmark_file);
+        benchmark::DoNotOptimize(decoder.read(std::begin(output), std::end(output)));
+    }
+    state.SetBytesProcessed(state.iterations() * frames * channels * 3);
+}
+
+template <typename T>
+void ParallelDecoding(benchmark::State& state) {
+    create_file();
+    std::vector<T> output(channels * frames);
+    for (auto _ : state) {
+        edsp::io::parallel_decoder<T> decoder(state.range(0));
+        decoder.open(benchmark_file);
+        benchmark::DoNotOptimize(decoder.read(0, std::begin(output), std::end(output)));
+    }
+    state.SetBytesProcessed(state.iterations() * frames * channels * 3);
+}
+
+BENCHMARK_TEMPLATE(SequentialDecoding, float)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(ParallelDecoding, float)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_MAIN();
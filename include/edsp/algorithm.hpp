@@ -27,9 +27,12 @@
 #include <edsp/algorithm/ceil.hpp>
 #include <edsp/algorithm/clipper.hpp>
 #include <edsp/algorithm/concatenate.hpp>
+#include <edsp/algorithm/deinterleave.hpp>
+#include <edsp/algorithm/dot.hpp>
 #include <edsp/algorithm/equal.hpp>
 #include <edsp/algorithm/fix.hpp>
 #include <edsp/algorithm/floor.hpp>
+#include <edsp/algorithm/interleave.hpp>
 #include <edsp/algorithm/linspace.hpp>
 #include <edsp/algorithm/linspace.hpp>
 #include <edsp/algorithm/logspace.hpp>
@@ -0,0 +1,101 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: deinterleave.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-10-26
+ */
+#ifndef EDSP_ALGORITHM_DEINTERLEAVE_HPP
+#define EDSP_ALGORITHM_DEINTERLEAVE_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace edsp { inline namespace algorithm {
+
+    namespace internal {
+
+        template <std::size_t Channels, typename RandomIt, typename ChannelIt>
+        inline void deinterleave_fixed(RandomIt first, std::ptrdiff_t frames, ChannelIt channels,
+                                       std::ptrdiff_t offset) {
+            std::array<meta::value_type_t<ChannelIt>, Channels> outputs;
+            for (std::size_t c = 0; c < Channels; ++c, ++channels) {
+                outputs[c] = *channels + offset;
+            }
+
+            constexpr auto stride = static_cast<std::ptrdiff_t>(Channels);
+            for (std::ptrdiff_t i = 0; i < frames; ++i) {
+                for (std::size_t c = 0; c < Channels; ++c) {
+                    outputs[c][i] = first[i * stride + c];
+                }
+            }
+        }
+
+        /* Writes the frames [0, frames) of the interleaved input at the position offset of every channel */
+        template <typename RandomIt, typename ChannelIt>
+        inline void deinterleave_frames(RandomIt first, std::ptrdiff_t frames, ChannelIt channels,
+                                        std::ptrdiff_t count, std::ptrdiff_t offset) {
+            switch (count) {
+                case 1:
+                    return deinterleave_fixed<1>(first, frames, channels, offset);
+                case 2:
+                    return deinterleave_fixed<2>(first, frames, channels, offset);
+                case 4:
+                    return deinterleave_fixed<4>(first, frames, channels, offset);
+                case 6:
+                    return deinterleave_fixed<6>(first, frames, channels, offset);
+                case 8:
+                    return deinterleave_fixed<8>(first, frames, channels, offset);
+                default:
+                    for (std::ptrdiff_t c = 0; c < count; ++c, ++channels) {
+                        auto output = *channels + offset;
+                        for (std::ptrdiff_t i = 0; i < frames; ++i) {
+                            output[i] = first[i * count + c];
+                        }
+                    }
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Splits the interleaved elements in the range [first, last) in one range per channel.
+     *
+     * The range [d_first, d_last) contains the random access iterators where every channel is stored, so the number
+     * of channels is the size of that range. The most usual layouts (1, 2, 4, 6 and 8 channels) are handled with a
+     * fixed stride, that the compiler turns into vector shuffles.
+     *
+     * @param first Random access iterator defining the beginning of the interleaved range.
+     * @param last Random access iterator defining the ending of the interleaved range.
+     * @param d_first Input iterator defining the beginning of the range of channel iterators.
+     * @param d_last Input iterator defining the ending of the range of channel iterators.
+     */
+    template <typename RandomIt, typename ChannelIt>
+    inline void deinterleave(RandomIt first, RandomIt last, ChannelIt d_first, ChannelIt d_last) {
+        const auto channels = static_cast<std::ptrdiff_t>(std::distance(d_first, d_last));
+        const auto size     = static_cast<std::ptrdiff_t>(std::distance(first, last));
+        meta::expects(channels > 0, "Expected at least one channel");
+        meta::expects(size % channels == 0, "Expected an integer number of frames");
+        internal::deinterleave_frames(first, size / channels, d_first, channels, 0);
+    }
+
+}} // namespace edsp::algorithm
+
+#endif // EDSP_ALGORITHM_DEINTERLEAVE_HPP
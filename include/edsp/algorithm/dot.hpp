@@ -0,0 +1,68 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: dot.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-10-22
+ */
+#ifndef EDSP_ALGORITHM_DOT_HPP
+#define EDSP_ALGORITHM_DOT_HPP
+
+#include <edsp/meta/iterator.hpp>
+#include <iterator>
+
+namespace edsp { inline namespace algorithm {
+
+    /**
+     * @brief Computes the inner product of the range [first1, last1) and the range beginning at first2.
+     *
+     * \f[
+     *      y = \sum_{n=0}^{N-1} x_1(n) x_2(n)
+     * \f]
+     *
+     * The sum is split in 8 independent partial sums (lanes) that are combined at the end. Every lane only depends on
+     * itself, so the compiler maps the lanes to a SIMD register without reordering floating-point additions.
+     *
+     * @param first1 Random access iterator defining the beginning of the first range.
+     * @param last1 Random access iterator defining the ending of the first range.
+     * @param first2 Random access iterator defining the beginning of the second range.
+     * @returns The inner product of both ranges.
+     */
+    template <typename RandomIt1, typename RandomIt2>
+    inline meta::value_type_t<RandomIt1> dot(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2) {
+        using value_type      = meta::value_type_t<RandomIt1>;
+        using size_type       = meta::diff_type_t<RandomIt1>;
+        constexpr auto lanes  = 8;
+        const auto size       = std::distance(first1, last1);
+        const auto blocked    = size - size % lanes;
+        value_type acc[lanes] = {};
+        for (size_type i = 0; i < blocked; i += lanes) {
+            for (size_type j = 0; j < lanes; ++j) {
+                acc[j] += first1[i + j] * first2[i + j];
+            }
+        }
+
+        value_type result = ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+        for (size_type i = blocked; i < size; ++i) {
+            result += first1[i] * first2[i];
+        }
+        return result;
+    }
+
+}} // namespace edsp::algorithm
+
+#endif // EDSP_ALGORITHM_DOT_HPP
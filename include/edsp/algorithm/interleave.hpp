@@ -0,0 +1,91 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: interleave.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-10-26
+ */
+#ifndef EDSP_ALGORITHM_INTERLEAVE_HPP
+#define EDSP_ALGORITHM_INTERLEAVE_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace edsp { inline namespace algorithm {
+
+    namespace internal {
+
+        template <std::size_t Channels, typename ChannelIt, typename RandomIt>
+        inline void interleave_fixed(ChannelIt channels, std::ptrdiff_t frames, RandomIt d_first) {
+            std::array<meta::value_type_t<ChannelIt>, Channels> inputs;
+            for (std::size_t c = 0; c < Channels; ++c, ++channels) {
+                inputs[c] = *channels;
+            }
+
+            constexpr auto stride = static_cast<std::ptrdiff_t>(Channels);
+            for (std::ptrdiff_t i = 0; i < frames; ++i) {
+                for (std::size_t c = 0; c < Channels; ++c) {
+                    d_first[i * stride + c] = inputs[c][i];
+                }
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Merges one range per channel in a single interleaved range, beginning at d_first.
+     *
+     * The range [first, last) contains the random access iterators to the beginning of every channel, so the number
+     * of channels is the size of that range. The most usual layouts (1, 2, 4, 6 and 8 channels) are handled with a
+     * fixed stride, that the compiler turns into vector shuffles.
+     *
+     * @param first Input iterator defining the beginning of the range of channel iterators.
+     * @param last Input iterator defining the ending of the range of channel iterators.
+     * @param frames Number of elements in every channel.
+     * @param d_first Random access iterator defining the beginning of the interleaved range.
+     */
+    template <typename ChannelIt, typename RandomIt>
+    inline void interleave(ChannelIt first, ChannelIt last, std::ptrdiff_t frames, RandomIt d_first) {
+        const auto channels = static_cast<std::ptrdiff_t>(std::distance(first, last));
+        meta::expects(channels > 0, "Expected at least one channel");
+        switch (channels) {
+            case 1:
+                return internal::interleave_fixed<1>(first, frames, d_first);
+            case 2:
+                return internal::interleave_fixed<2>(first, frames, d_first);
+            case 4:
+                return internal::interleave_fixed<4>(first, frames, d_first);
+            case 6:
+                return internal::interleave_fixed<6>(first, frames, d_first);
+            case 8:
+                return internal::interleave_fixed<8>(first, frames, d_first);
+            default:
+                for (std::ptrdiff_t c = 0; c < channels; ++c, ++first) {
+                    const auto input = *first;
+                    for (std::ptrdiff_t i = 0; i < frames; ++i) {
+                        d_first[i * channels + c] = input[i];
+                    }
+                }
+        }
+    }
+
+}} // namespace edsp::algorithm
+
+#endif // EDSP_ALGORITHM_INTERLEAVE_HPP
@@ -24,8 +24,10 @@
 #define EDSP_ERBSPACE_HPP
 
 #include <edsp/auditory/converter/hertz2erb.hpp>
+#include <edsp/auditory/converter/erb2hertz.hpp>
 #include <edsp/algorithm/linspace.hpp>
 #include <algorithm>
+#include <iterator>
 
 namespace edsp { namespace auditory {
 
@@ -41,8 +43,10 @@ namespace edsp { namespace auditory {
     template <typename OutputIt, typename Numeric, typename Integer>
     constexpr void erbspace(OutputIt d_first, Numeric min, Numeric max, Integer N) {
         using output_type = typename std::iterator_traits<OutputIt>::value_type;
-        algorithm::linspace(d_first, min, max, N);
-        std::transform(d_first, d_first + N, converter::hertz2erb);
+        const auto first  = converter::hertz2erb<output_type>(min);
+        const auto last   = converter::hertz2erb<output_type>(max);
+        algorithm::linspace(d_first, first, last, N);
+        std::transform(d_first, d_first + N, d_first, converter::erb2hertz<output_type>);
     }
 
 }} // namespace edsp::auditory
@@ -28,9 +28,48 @@
 #include <edsp/algorithm/linspace.hpp>
 #include <edsp/converter/mag2db.hpp>
 #include <edsp/converter/rad2deg.hpp>
+#include <edsp/meta/unused.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace edsp { namespace chart {
 
+    inline namespace internal {
+
+        template <typename T, typename Float>
+        inline void plot_response(const filter::frequency_response<T>& response, Float samplerate) {
+#if defined(USE_MATPLOTLIB)
+            const auto N = response.magnitude.size();
+            std::vector<T> frequencies(N), magnitude(N), phase(N);
+            algorithm::linspace(std::begin(frequencies), (Float)0, samplerate / 2, N);
+            std::transform(std::cbegin(response.magnitude), std::cend(response.magnitude), std::begin(magnitude),
+                           [](const T element) -> T { return converter::mag2db(element); });
+            std::transform(std::cbegin(response.phase), std::cend(response.phase), std::begin(phase),
+                           [](const T element) -> T { return converter::rad2deg(element); });
+
+            plt::figure_size(640, 480);
+            plt::title("Magnitude Response (dB) and Phase Response");
+            plt::subplot(2, 1, 1);
+            plt::ylabel("Magnitude (dB)");
+            plt::xlabel("Frequency (Hz)");
+            plt::xlim((Float)0, samplerate / 2);
+            plt::plot(frequencies, magnitude);
+            plt::grid(true);
+            plt::subplot(2, 1, 2);
+            plt::ylabel("Phase (degrees)");
+            plt::xlabel("Frequency (Hz)");
+            plt::plot(frequencies, phase);
+            plt::xlim((Float)0, samplerate / 2);
+            plt::grid(true);
+            plt::pause(100);
+#else
+            meta::unused(response);
+            meta::unused(samplerate);
+#endif
+        }
+
+    } // namespace internal
+
     /**
      * @brief Plots the frequency response of a biquad digital filter.
      * @param biquad Biquad digital filter.
@@ -39,35 +78,7 @@ namespace edsp { namespace chart {
      */
     template <typename T, typename Numeric, typename Float>
     inline void freqz(const filter::biquad<T>& biquad, Numeric N, Float samplerate) {
-#if defined(USE_MATPLOTLIB)
-
-        std::vector<std::complex<T>> spectrum(N);
-        std::vector<T> frequencies(N), magnitude(N), phase(N);
-
-        std::array<T, 3> a = {{biquad.a0(), biquad.a1(), biquad.a2()}}, b = {{biquad.b0(), biquad.b1(), biquad.b2()}};
-        filter::freq(std::cbegin(b), std::cend(b), std::cbegin(a), std::cend(a), std::begin(spectrum), N);
-        algorithm::linspace(std::begin(frequencies), (Float)0, samplerate / 2, N);
-        std::transform(std::cbegin(spectrum), std::cend(spectrum), std::begin(magnitude),
-                       [](const auto& element) -> T { return converter::mag2db(std::abs(element)); });
-        std::transform(std::cbegin(spectrum), std::cend(spectrum), std::begin(phase),
-                       [](const auto& element) -> T { return std::arg(element); });
-
-        plt::figure_size(640, 480);
-        plt::title("Magnitude Response (dB) and Phase Response");
-        plt::subplot(2, 1, 1);
-        plt::ylabel("Magnitude (dB)");
-        plt::xlabel("Frequency (Hz)");
-        plt::xlim((Float)0, samplerate / 2);
-        plt::plot(frequencies, magnitude);
-        plt::grid(true);
-        plt::subplot(2, 1, 2);
-        plt::ylabel("Phase (degrees)");
-        plt::xlabel("Frequency (Hz)");
-        plt::plot(frequencies, phase);
-        plt::xlim((Float)0, samplerate / 2);
-        plt::grid(true);
-        plt::pause(100);
-#endif
+        internal::plot_response(filter::freqz(biquad, static_cast<std::size_t>(N)), samplerate);
     }
 
     /**
@@ -78,41 +89,18 @@ namespace edsp { namespace chart {
      */
     template <typename T, std::size_t Order, typename Numeric, typename Float>
     inline void freqz(const filter::biquad_cascade<T, Order>& cascade, Numeric N, Float samplerate) {
-#if defined(USE_MATPLOTLIB)
-
-        std::vector<std::complex<T>> spectrum(N), global(N, std::complex<T>(1, 1));
-        std::vector<T> frequencies(N), magnitude(N), phase(N);
-
-        for (const auto& biquad : cascade) {
-            std::array<T, 3> a = {{biquad.a0(), biquad.a1(), biquad.a2()}},
-                             b = {{biquad.b0(), biquad.b1(), biquad.b2()}};
-            filter::freq(std::cbegin(b), std::cend(b), std::cbegin(a), std::cend(a), std::begin(spectrum), N);
-            std::transform(std::cbegin(spectrum), std::cend(spectrum), std::cbegin(global), std::begin(global),
-                           std::multiplies<std::complex<T>>());
-        }
-
-        algorithm::linspace(std::begin(frequencies), (Float)0, samplerate / 2, N);
-        std::transform(std::cbegin(global), std::cend(global), std::begin(magnitude),
-                       [](const auto& element) -> T { return converter::mag2db(std::abs(element)); });
-        std::transform(std::cbegin(global), std::cend(global), std::begin(phase),
-                       [](const auto& element) -> T { return std::arg(element); });
+        internal::plot_response(filter::freqz(cascade, static_cast<std::size_t>(N)), samplerate);
+    }
 
-        plt::figure_size(640, 480);
-        plt::title("Magnitude Response (dB) and Phase Response");
-        plt::subplot(2, 1, 1);
-        plt::ylabel("Magnitude (dB)");
-        plt::xlabel("Frequency (Hz)");
-        plt::xlim((Float)0, samplerate / 2);
-        plt::plot(frequencies, magnitude);
-        plt::grid(true);
-        plt::subplot(2, 1, 2);
-        plt::ylabel("Phase (degrees)");
-        plt::xlabel("Frequency (Hz)");
-        plt::plot(frequencies, phase);
-        plt::xlim((Float)0, samplerate / 2);
-        plt::grid(true);
-        plt::pause(100);
-#endif
+    /**
+     * @brief Plots the frequency response of a cascade of biquad digital filters sized at runtime.
+     * @param cascade Cascade of digital filter.
+     * @param N Number of evaluation points.
+     * @param samplerate Sampling rate in Hz.
+     */
+    template <typename T, typename Allocator, typename Numeric, typename Float>
+    inline void freqz(const filter::dynamic_biquad_cascade<T, Allocator>& cascade, Numeric N, Float samplerate) {
+        internal::plot_response(filter::freqz(cascade, static_cast<std::size_t>(N)), samplerate);
     }
 
 }} // namespace edsp::chart
@@ -22,7 +22,12 @@
 #ifndef EDSP_DB2POW_HPP
 #define EDSP_DB2POW_HPP
 
+#include <edsp/meta/iterator.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/math/fast.hpp>
+#include <algorithm>
 #include <cmath>
+
 namespace edsp { inline namespace converter {
 
     /**
@@ -40,6 +45,23 @@ namespace edsp { inline namespace converter {
         return std::pow(10, db / static_cast<T>(10));
     }
 
+    /**
+     * @brief Converts the decibels in the range [first, last) to powers and stores the result in another range,
+     * beginning at d_first.
+     *
+     * The power of ten is evaluated as \f$ e^{x \ln(10) / 10} \f$ with the vectorizable exponential of math::fast.
+     * @param first Input iterator defining the beginning of the input range.
+     * @param last Input iterator defining the ending of the input range.
+     * @param d_first Output iterator defining the beginning of the destination range.
+     */
+    template <typename InputIt, typename OutputIt>
+    constexpr void db2pow(InputIt first, InputIt last, OutputIt d_first) {
+        using value_type     = meta::value_type_t<InputIt>;
+        constexpr auto scale = constants<value_type>::ln_ten / static_cast<value_type>(10);
+        std::transform(first, last, d_first,
+                       [=](const value_type val) -> value_type { return fast::exp(scale * val); });
+    }
+
 }} // namespace edsp::converter
 
 #endif // EDSP_DB2POW_HPP
@@ -23,6 +23,9 @@
 #define EDSP_MAG2DB_HPP
 
 #include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <edsp/math/fast.hpp>
+#include <algorithm>
 #include <cmath>
 
 namespace edsp { inline namespace converter {
@@ -42,6 +45,25 @@ namespace edsp { inline namespace converter {
         meta::expects(magnitude > 0, "Expected non negative value");
         return 20 * std::log10(magnitude);
     }
+
+    /**
+     * @brief Converts the magnitudes in the range [first, last) to decibels (dB) and stores the result in another
+     * range, beginning at d_first.
+     *
+     * The conversion uses the vectorizable logarithm of math::fast. Non positive magnitudes are mapped to -inf (zero)
+     * or NaN (negative) instead of being checked one by one.
+     * @param first Input iterator defining the beginning of the input range.
+     * @param last Input iterator defining the ending of the input range.
+     * @param d_first Output iterator defining the beginning of the destination range.
+     */
+    template <typename InputIt, typename OutputIt>
+    constexpr void mag2db(InputIt first, InputIt last, OutputIt d_first) {
+        using value_type = meta::value_type_t<InputIt>;
+        std::transform(first, last, d_first, [](const value_type val) -> value_type {
+            return static_cast<value_type>(20) * fast::log10(val);
+        });
+    }
+
 }} // namespace edsp::converter
 
 #endif // EDSP_MAG2DB_HPP
@@ -0,0 +1,137 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: denormal_guard.hpp
+* Author: Mohammed Boujemaoui
+* Date: 31/10/18
+*/
+
+#ifndef EDSP_DENORMAL_GUARD_HPP
+#define EDSP_DENORMAL_GUARD_HPP
+
+#include <edsp/core/internal/config.hpp>
+#include <edsp/core/tweakme.hpp>
+#include <cstdint>
+#include <limits>
+
+#if !defined(EDSP_DISABLE_DENORMAL_GUARD)
+#    if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#        include <xmmintrin.h>
+#        define EDSP_DENORMAL_GUARD_SSE
+#    elif defined(PROCESSOR_ARM_64) && defined(COMPILER_GNU)
+#        define EDSP_DENORMAL_GUARD_AARCH64
+#    elif defined(PROCESSOR_ARM_32) && defined(COMPILER_GNU) && defined(__ARM_FP)
+#        define EDSP_DENORMAL_GUARD_ARM
+#    endif
+#endif
+
+namespace edsp { inline namespace core {
+
+    /**
+     * @class denormal_guard
+     * @brief Scoped object that makes the floating point unit of the current thread treat denormal numbers as zero.
+     *
+     * The constructor enables the flush-to-zero and denormals-are-zero modes (the FZ flag on ARM) and the destructor
+     * restores the previous modes, so guards can be nested. The recursive processors of the library create a guard
+     * around every block they process, so the cost of setting the modes is paid once per block.
+     *
+     * On processors without such modes, or if EDSP_DISABLE_DENORMAL_GUARD is defined, the guard does nothing and
+     * active() returns false. The processors then fall back to adding a tiny offset to their input.
+     * @see denormal_offset
+     */
+    class denormal_guard {
+    public:
+        denormal_guard() noexcept;
+        ~denormal_guard();
+
+        denormal_guard(const denormal_guard&) = delete;
+        denormal_guard& operator=(const denormal_guard&) = delete;
+
+        /**
+         * @brief Checks if the denormal modes can be enabled in this platform.
+         */
+        static constexpr bool supported() noexcept;
+
+        /**
+         * @brief Checks if the guard has enabled the denormal modes.
+         */
+        constexpr bool active() const noexcept;
+
+    private:
+        std::uintptr_t previous_{0};
+    };
+
+    constexpr bool denormal_guard::supported() noexcept {
+#if defined(EDSP_DENORMAL_GUARD_SSE) || defined(EDSP_DENORMAL_GUARD_AARCH64) || defined(EDSP_DENORMAL_GUARD_ARM)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    constexpr bool denormal_guard::active() const noexcept {
+        return supported();
+    }
+
+    inline denormal_guard::denormal_guard() noexcept {
+#if defined(EDSP_DENORMAL_GUARD_SSE)
+        // Bit 15: flush to zero, bit 6: denormals are zero
+        previous_ = _mm_getcsr();
+        _mm_setcsr(static_cast<unsigned int>(previous_) | 0x8040u);
+#elif defined(EDSP_DENORMAL_GUARD_AARCH64)
+        // Bit 24 of FPCR: flush to zero, applied to both inputs and outputs
+        std::uintptr_t fpcr = 0;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        previous_ = fpcr;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (std::uintptr_t{1} << 24)));
+#elif defined(EDSP_DENORMAL_GUARD_ARM)
+        // Bit 24 of FPSCR: flush to zero
+        std::uintptr_t fpscr = 0;
+        asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+        previous_ = fpscr;
+        asm volatile("vmsr fpscr, %0" : : "r"(fpscr | (std::uintptr_t{1} << 24)));
+#endif
+    }
+
+    inline denormal_guard::~denormal_guard() {
+#if defined(EDSP_DENORMAL_GUARD_SSE)
+        _mm_setcsr(static_cast<unsigned int>(previous_));
+#elif defined(EDSP_DENORMAL_GUARD_AARCH64)
+        asm volatile("msr fpcr, %0" : : "r"(previous_));
+#elif defined(EDSP_DENORMAL_GUARD_ARM)
+        asm volatile("vmsr fpscr, %0" : : "r"(previous_));
+#endif
+    }
+
+    /**
+     * @brief Returns the offset added to the input of the recursive processors when the denormal guard is not active.
+     *
+     * The offset is far below the audible or measurable range, but big enough to keep the states of the processors away
+     * from the denormal range when the input is silent. It is zero for non floating point types, and when the guard is
+     * active.
+     * @param guard Guard protecting the processing.
+     */
+    template <typename T>
+    constexpr T denormal_offset(const denormal_guard& guard) noexcept {
+        return (guard.active() || !std::numeric_limits<T>::is_iec559)
+                   ? static_cast<T>(0)
+                   : static_cast<T>(sizeof(T) > sizeof(float) ? 1e-30 : 1e-18);
+    }
+
+}} // namespace edsp::core
+
+#endif // EDSP_DENORMAL_GUARD_HPP
@@ -28,6 +28,7 @@
 #include <edsp/thirdparty/spdlog/sinks/basic_file_sink.h>
 #include <edsp/thirdparty/termcolor/termcolor.hpp>
 #include <edsp/types/string_view.hpp>
+#include <mutex>
 #include <type_traits>
 #include <sstream>
 
@@ -214,6 +215,17 @@ namespace edsp { inline namespace core {
             return NAME;
         }
 
+        /**
+         * @brief Returns a reference to the mutex guarding the look-up and creation of the spd-loggers
+         *
+         * @note The loggers can be created from several threads at once, as the workers of the parallel decoders.
+         * @return Reference to the global mutex
+         */
+        static std::mutex& global_mutex() {
+            static std::mutex MUTEX;
+            return MUTEX;
+        }
+
     private:
         friend struct internal::logger_impl;
         std::shared_ptr<spdlog::logger> logger_{nullptr};
@@ -419,6 +431,7 @@ namespace edsp { inline namespace core {
     logger::logger(const edsp::string_view& name, const edsp::string_view& file, logger::levels message_type) :
         type_(message_type),
         msg_() {
+        std::lock_guard<std::mutex> lock(global_mutex());
         logger_ = spdlog::get(name.data());
         if (!logger_) {
             logger_ = spdlog::basic_logger_mt(name.data(), file.data());
@@ -426,6 +439,7 @@ namespace edsp { inline namespace core {
     }
 
     logger::logger(const edsp::string_view& name, logger::levels message_type) : type_(message_type), msg_() {
+        std::lock_guard<std::mutex> lock(global_mutex());
         logger_ = spdlog::get(name.data());
         if (!logger_) {
             logger_ = spdlog::stdout_color_mt(name.data());
@@ -433,6 +447,7 @@ namespace edsp { inline namespace core {
     }
 
     logger::logger(logger::levels message_type) : type_(message_type), msg_() {
+        std::lock_guard<std::mutex> lock(global_mutex());
         const auto& name = global_name();
         logger_          = spdlog::get(name);
         if (!logger_) {
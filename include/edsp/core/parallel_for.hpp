@@ -0,0 +1,101 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: parallel_for.hpp
+* Author: Mohammed Boujemaoui
+* Date: 02/11/18
+*/
+
+#ifndef EDSP_PARALLEL_FOR_HPP
+#define EDSP_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace edsp { inline namespace core {
+
+    /**
+     * @brief Returns the number of threads to use for the requested one, where zero means one per hardware thread.
+     */
+    inline std::size_t resolve_threads(std::size_t threads) noexcept {
+        return threads > 0 ? threads
+                           : std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t{1});
+    }
+
+    /**
+     * @brief Runs the tasks with indices in [0, count) on several threads.
+     *
+     * Every worker calls make_worker once to create its own state, a function then called with the index of every task
+     * taken by the worker. The workers take the next pending task until all of them have been run, so faster workers
+     * run more tasks, and the calling thread is one of the workers. No thread is created for a single worker.
+     *
+     * If a worker throws, the pending tasks are abandoned, and the first exception is rethrown once all the workers
+     * have finished.
+     *
+     * @param count Number of tasks.
+     * @param threads Maximum number of threads. Zero uses one thread per hardware thread.
+     * @param make_worker Function returning the function that runs a task in a worker.
+     */
+    template <typename WorkerFactory>
+    void parallel_for(std::size_t count, std::size_t threads, WorkerFactory make_worker) {
+        if (count == 0) {
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error{};
+        std::mutex error_mutex{};
+
+        const auto work = [&]() {
+            try {
+                auto worker = make_worker();
+                for (auto task = next.fetch_add(1); task < count; task = next.fetch_add(1)) {
+                    worker(task);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(count);
+            }
+        };
+
+        const auto workers = std::min(resolve_threads(threads), count);
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i) {
+            pool.emplace_back(work);
+        }
+        work();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+}} // namespace edsp::core
+
+#endif // EDSP_PARALLEL_FOR_HPP
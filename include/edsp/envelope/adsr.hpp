@@ -28,6 +28,7 @@
 #include <functional>
 #include <algorithm>
 
+#include <edsp/core/denormal_guard.hpp>
 #include <edsp/meta/expects.hpp>
 
 namespace edsp { namespace envelope {
@@ -193,8 +194,11 @@ namespace edsp { namespace envelope {
         }
 
         template <typename InIterator, typename OutputIt>
-        constexpr void apply(InIterator first, InIterator last, OutputIt d_first) {
-            std::transform(first, last, d_first, std::ref(*this));
+        void apply(InIterator first, InIterator last, OutputIt d_first) {
+            const core::denormal_guard guard;
+            for (; first != last; ++first, ++d_first) {
+                *d_first = (*this)(*first);
+            }
         }
 
     private:
@@ -22,6 +22,7 @@
 #ifndef EDSP_FEATURE_TEMPORAL_EnvelopeFollower_HPP
 #define EDSP_FEATURE_TEMPORAL_EnvelopeFollower_HPP
 
+#include <edsp/core/denormal_guard.hpp>
 #include <edsp/math/numeric.hpp>
 #include <numeric>
 #include <cmath>
@@ -123,7 +124,7 @@ namespace edsp { namespace envelope {
          * @param d_first Output iterator defining the beginning of the destination range.
          */
         template <typename InIterator, typename OutputIt>
-        constexpr void apply(InIterator first, InIterator last, OutputIt d_first);
+        void apply(InIterator first, InIterator last, OutputIt d_first);
 
         /**
          * @brief Computes the envelope of the element
@@ -203,8 +204,12 @@ namespace edsp { namespace envelope {
 
     template <typename T>
     template <typename InIterator, typename OutputIt>
-    constexpr void ar<T>::apply(InIterator first, InIterator last, OutputIt d_first) {
-        std::transform(first, last, d_first, std::ref(*this));
+    void ar<T>::apply(InIterator first, InIterator last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<value_type>(guard);
+        for (; first != last; ++first, ++d_first) {
+            *d_first = (*this)(*first + offset);
+        }
     }
 
     template <typename T>
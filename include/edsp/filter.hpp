@@ -24,15 +24,30 @@
 
 #include <edsp/filter/biquad.hpp>
 #include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/dynamic_biquad_cascade.hpp>
+#include <edsp/filter/filtfilt.hpp>
+#include <edsp/filter/fir.hpp>
+#include <edsp/filter/freqz.hpp>
+#include <edsp/filter/fir_decimator.hpp>
+#include <edsp/filter/fir_interpolator.hpp>
+#include <edsp/filter/gammatone_bank.hpp>
+#include <edsp/filter/lookahead_cascade.hpp>
+#include <edsp/filter/moving_extremum_filter.hpp>
 #include <edsp/filter/moving_median_filter.hpp>
 #include <edsp/filter/moving_average_filter.hpp>
 #include <edsp/filter/moving_rms_filter.hpp>
+#include <edsp/filter/octave_bank.hpp>
+#include <edsp/filter/smoothed_biquad.hpp>
 
 #include <edsp/filter/internal/rbj_designer.hpp>
 #include <edsp/filter/internal/zoelzer_designer.hpp>
 #include <edsp/filter/internal/butterworth_designer.hpp>
 #include <edsp/filter/internal/chebyshev_I_designer.hpp>
 #include <edsp/filter/internal/chebyshev_II_designer.hpp>
+#include <edsp/filter/internal/elliptic_designer.hpp>
+#include <edsp/filter/internal/bessel_designer.hpp>
+#include <edsp/filter/internal/legendre_designer.hpp>
+#include <edsp/filter/internal/order_estimator.hpp>
 
 namespace edsp { namespace filter {
 
@@ -47,7 +62,7 @@ namespace edsp { namespace filter {
         Butterworth, /*!< Digital implementation of the classic Butterworth filter by using the bilinear transform */
         ChebyshevI, /*!< Digital implementation of the Chebyshev polynomials (ripple in the passband) filter by using the bilinear transform */
         ChebyshevII, /*!< Digital implementation of the "Inverse Chebyshev" filters (ripple in the stopband) by using the bilinear transform */
-        Bessel,
+        Bessel, /*!< Digital implementation of the Bessel filters (maximally flat group delay) by using the bilinear transform */
         Elliptic, /*!< Elliptic filters design */
         Legendre  /*!< Legendre filters design */
     };
@@ -143,6 +158,137 @@ namespace edsp { namespace filter {
         }
     };
 
+    /**
+     * @brief Elliptic (Cauer) filter designer.
+     *
+     * The passband and the stopband are equiripple, which gives the narrowest transition band for a given order. The
+     * low pass and high pass filters take the order, the sampling frequency, the passband edge, the passband ripple in
+     * dB and the stopband attenuation in dB. The band pass and band stop filters take the center frequency and the
+     * bandwidth instead of the passband edge.
+     *
+     * @tparam T Arithmetic type.
+     * @tparam MaxOrder Maximum order.
+     */
+    template <typename T, std::size_t MaxOrder>
+    struct designer<T, designer_type::Elliptic, MaxOrder> {
+        template <filter_type Type, typename... Args>
+        constexpr auto design(Args... arg) const
+            -> decltype(elliptic_designer<T, Type, MaxOrder>{}(std::declval<Args&&>()...)) {
+            return elliptic_designer<T, Type, MaxOrder>{}(arg...);
+        }
+    };
+
+    /**
+     * @brief Bessel filter designer.
+     *
+     * The cutoff frequency is the -3 dB point.
+     *
+     * @tparam T Arithmetic type.
+     * @tparam MaxOrder Maximum order.
+     */
+    template <typename T, std::size_t MaxOrder>
+    struct designer<T, designer_type::Bessel, MaxOrder> {
+        template <filter_type Type, typename... Args>
+        constexpr auto design(Args... arg) const
+            -> decltype(bessel_designer<T, Type, MaxOrder>{}(std::declval<Args&&>()...)) {
+            return bessel_designer<T, Type, MaxOrder>{}(arg...);
+        }
+    };
+
+    /**
+     * @brief Legendre (Optimum L) filter designer.
+     *
+     * The cutoff frequency is the -3 dB point.
+     *
+     * @tparam T Arithmetic type.
+     * @tparam MaxOrder Maximum order.
+     */
+    template <typename T, std::size_t MaxOrder>
+    struct designer<T, designer_type::Legendre, MaxOrder> {
+        template <filter_type Type, typename... Args>
+        constexpr auto design(Args... arg) const
+            -> decltype(legendre_designer<T, Type, MaxOrder>{}(std::declval<Args&&>()...)) {
+            return legendre_designer<T, Type, MaxOrder>{}(arg...);
+        }
+    };
+
+    inline namespace internal {
+
+        template <typename T>
+        std::size_t estimate_order(designer_type designer, const order_specification<T>& spec) {
+            switch (designer) {
+                case designer_type::Butterworth:
+                    return butterworth_order(spec);
+                case designer_type::ChebyshevI:
+                case designer_type::ChebyshevII:
+                    return chebyshev_order(spec);
+                case designer_type::Elliptic:
+                    return elliptic_order(spec);
+                case designer_type::Bessel:
+                    return monotonic_order<bessel::LowPassAnalogDesigner>(spec);
+                case designer_type::Legendre:
+                    return monotonic_order<legendre::LowPassAnalogDesigner>(spec);
+                default:
+                    meta::expects(false, "Expected a designer based on an analog prototype");
+                    return 0;
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Estimates the minimum order of a low pass or high pass filter that meets the given specification.
+     *
+     * The response must stay within ripple_db of the passband gain up to the passband edge, and be attenuated at
+     * least stopband_db from the stopband edge. The edges are prewarped as in the bilinear transform.
+     *
+     * The elliptic and Chebyshev I filters meet the specification when designed with the passband edge as cutoff
+     * frequency, and the Chebyshev II filters with the stopband edge. The Butterworth, Bessel and Legendre filters are
+     * designed with the -3 dB point as cutoff, which has to be placed between both edges.
+     *
+     * @tparam Designer Designer of the filter.
+     * @tparam Type Low pass or high pass.
+     * @param sample_rate The sampling frequency in Hz.
+     * @param passband_edge Last frequency of the passband in Hz.
+     * @param stopband_edge First frequency of the stopband in Hz.
+     * @param ripple_db Maximum attenuation in the passband in dB.
+     * @param stopband_db Minimum attenuation in the stopband in dB.
+     * @return Minimum order of the filter.
+     */
+    template <designer_type Designer, filter_type Type, typename T>
+    std::size_t estimate_order(T sample_rate, T passband_edge, T stopband_edge, T ripple_db, T stopband_db) {
+        return internal::estimate_order(
+            Designer,
+            internal::make_specification(Type, sample_rate, passband_edge, stopband_edge, ripple_db, stopband_db));
+    }
+
+    /**
+     * @brief Estimates the minimum order of a band pass or band stop filter that meets the given specification.
+     *
+     * The order refers to the low pass prototype, so the designed filter has twice as many poles. The specification is
+     * mapped to the prototype with the geometric center and the width of the passband.
+     *
+     * @tparam Designer Designer of the filter.
+     * @tparam Type Band pass or band stop.
+     * @param sample_rate The sampling frequency in Hz.
+     * @param passband_low Lower edge of the passband in Hz.
+     * @param passband_high Upper edge of the passband in Hz.
+     * @param stopband_low Lower edge of the stopband in Hz.
+     * @param stopband_high Upper edge of the stopband in Hz.
+     * @param ripple_db Maximum attenuation in the passband in dB.
+     * @param stopband_db Minimum attenuation in the stopband in dB.
+     * @return Minimum order of the prototype.
+     * @see estimate_order
+     */
+    template <designer_type Designer, filter_type Type, typename T>
+    std::size_t estimate_order(T sample_rate, T passband_low, T passband_high, T stopband_low, T stopband_high,
+                               T ripple_db, T stopband_db) {
+        return internal::estimate_order(Designer,
+                                        internal::make_specification(Type, sample_rate, passband_low, passband_high,
+                                                                     stopband_low, stopband_high, ripple_db,
+                                                                     stopband_db));
+    }
+
     /**
      * @brief Creates a filter using args as the parameter list for the construction.
      * @tparam T Value type
@@ -165,6 +311,7 @@ namespace edsp { namespace filter {
      * @param a_last End of the range elements representing the IIR/AR filter coefficients.
      * @param d_first Output iterator defining the beginning of the destination range.
      * @param N Number of evaluation points.
+     * @see freqz
      */
     template <typename InputIt, typename OutputIt, typename Numeric>
     constexpr void freq(InputIt b_first, InputIt b_last, InputIt a_first, InputIt a_last, OutputIt d_first, Numeric K) {
@@ -23,6 +23,7 @@
 #ifndef EDSP_FILTER_BIQUAD_HPP
 #define EDSP_FILTER_BIQUAD_HPP
 
+#include <edsp/core/denormal_guard.hpp>
 #include <edsp/math/numeric.hpp>
 #include <edsp/meta/expects.hpp>
 #include <algorithm>
@@ -184,15 +185,30 @@ namespace edsp { namespace filter {
          * @param last Input iterator defining the ending of the input range.
          * @param d_first Output iterator defining the beginning of the destination range.
          * @see tick
+         * @see denormal_guard
          */
         template <typename InputIt, typename OutputIt>
-        constexpr void filter(InputIt first, InputIt last, OutputIt d_first);
+        void filter(InputIt first, InputIt last, OutputIt d_first);
 
         /**
          * @brief Reset the filter to the original state
          */
         constexpr void reset() noexcept;
 
+        /**
+         * @brief Sets the state reached after filtering a constant input for an infinite time.
+         *
+         * Filtering a signal starting with the given value does not produce the transient of a filter at rest. If
+         * the filter has a pole at \f$ z = 1 \f$, there is no such a state and the filter is reset.
+         * @param value Value of the constant input.
+         */
+        constexpr void prime(value_type value) noexcept;
+
+        /**
+         * @brief Returns the gain of the filter at zero frequency.
+         */
+        constexpr value_type dc_gain() const noexcept;
+
         /**
          * @brief Checks if the Biquad Filter is stable.
          *
@@ -279,6 +295,24 @@ namespace edsp { namespace filter {
         w1_ = 0;
     }
 
+    template <typename T>
+    constexpr typename biquad<T>::value_type biquad<T>::dc_gain() const noexcept {
+        return (b0_ + b1_ + b2_) / (1 + a1_ + a2_);
+    }
+
+    template <typename T>
+    constexpr void biquad<T>::prime(const value_type value) noexcept {
+        if (1 + a1_ + a2_ == 0) {
+            reset();
+            return;
+        }
+
+        // Constant input and output in the transposed direct form II
+        const auto out = dc_gain() * value;
+        w1_            = b2_ * value - a2_ * out;
+        w0_            = b1_ * value - a1_ * out + w1_;
+    }
+
     template <typename T>
     constexpr bool biquad<T>::stability() const noexcept {
         return std::abs(a2_) < 1 && (std::abs(a1_) < (1 + a2_));
@@ -322,9 +356,11 @@ namespace edsp { namespace filter {
 
     template <typename T>
     template <typename InputIt, typename OutputIt>
-    constexpr void biquad<T>::filter(InputIt first, InputIt last, OutputIt d_first) {
+    void biquad<T>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<value_type>(guard);
         for (; first != last; ++first, ++d_first) {
-            *d_first = tick(*first);
+            *d_first = tick(*first + offset);
         }
     }
 
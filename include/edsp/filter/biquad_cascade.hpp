@@ -22,10 +22,12 @@
 #ifndef EDSP_BIQUAD_CASCADE_HPP
 #define EDSP_BIQUAD_CASCADE_HPP
 
+#include <edsp/core/denormal_guard.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/ensure.hpp>
 #include <edsp/filter/biquad.hpp>
 #include <array>
+#include <iterator>
 #include <edsp/meta/iterator.hpp>
 
 namespace edsp { namespace filter {
@@ -94,6 +96,13 @@ namespace edsp { namespace filter {
          */
         constexpr void reset();
 
+        /**
+         * @brief Sets every Biquad to the state reached after filtering a constant input for an infinite time.
+         * @param value Value of the constant input of the cascade.
+         * @see biquad::prime
+         */
+        constexpr void prime(T value) noexcept;
+
         /**
          * @brief Returns a constant reference to the Biquad at specified location pos. No bounds checking is performed.
          * @param index Position of the element to return.
@@ -154,7 +163,7 @@ namespace edsp { namespace filter {
          * @return
          */
         template <typename InputIt, typename OutputIt>
-        constexpr void filter(InputIt first, InputIt last, OutputIt d_first);
+        void filter(InputIt first, InputIt last, OutputIt d_first);
 
         /**
          * @brief Computes the output of filtering one digital time-step.
@@ -178,7 +187,8 @@ namespace edsp { namespace filter {
 
     private:
         std::size_t num_stage_{0};
-        std::array<biquad<T>, N> cascade_{};
+        // A built-in array, as the non-const accessors of std::array cannot be used in constant expressions in C++14
+        biquad<T> cascade_[N]{};
     };
 
     template <typename T, size_t N>
@@ -216,9 +226,11 @@ namespace edsp { namespace filter {
 
     template <typename T, size_t N>
     template <typename InputIt, typename OutputIt>
-    constexpr void biquad_cascade<T, N>::filter(InputIt first, InputIt last, OutputIt d_first) {
+    void biquad_cascade<T, N>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<T>(guard);
         for (; first != last; ++first, ++d_first) {
-            *d_first = tick(*first);
+            *d_first = tick(*first + offset);
         }
     }
 
@@ -271,6 +283,14 @@ namespace edsp { namespace filter {
         }
     }
 
+    template <typename T, size_t N>
+    constexpr void biquad_cascade<T, N>::prime(T value) noexcept {
+        for (auto i = 0ul; i < num_stage_; ++i) {
+            cascade_[i].prime(value);
+            value *= cascade_[i].dc_gain();
+        }
+    }
+
     template <typename T, size_t N>
     constexpr void biquad_cascade<T, N>::clear() {
         num_stage_ = 0;
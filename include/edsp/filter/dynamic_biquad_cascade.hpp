@@ -0,0 +1,314 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: dynamic_biquad_cascade.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_DYNAMIC_BIQUAD_CASCADE_HPP
+#define EDSP_FILTER_DYNAMIC_BIQUAD_CASCADE_HPP
+
+#include <edsp/core/denormal_guard.hpp>
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class dynamic_biquad_cascade
+     * @brief This class implements a cascade of Biquad filters whose number of stages is set at runtime.
+     *
+     * The biquad_cascade stores the maximum number of stages allowed by its designer, whatever the order of the
+     * design: a fourth order filter designed with a maximum order of 100 holds 50 biquads. This class only stores the
+     * stages in use, contiguously, so large collections of filters take the memory and cache they need. It is created
+     * from a biquad_cascade, and filters the signals in the same way.
+     *
+     * @tparam T Value type
+     * @tparam Allocator  Allocator type, defaults to std::allocator<biquad<T>>.
+     */
+    template <typename T, typename Allocator = std::allocator<biquad<T>>>
+    class dynamic_biquad_cascade {
+    public:
+        using container_type  = std::vector<biquad<T>, Allocator>;
+        using value_type      = biquad<T>;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using iterator        = typename container_type::iterator;
+        using const_iterator  = typename container_type::const_iterator;
+        using size_type       = std::size_t;
+
+        /**
+         * @brief Creates an empty %dynamic_biquad_cascade
+         */
+        dynamic_biquad_cascade() = default;
+
+        /**
+         * @brief Creates a %dynamic_biquad_cascade holding the stages in use of a biquad_cascade.
+         * @param cascade Cascade to copy, with its state.
+         */
+        template <std::size_t N>
+        dynamic_biquad_cascade(const biquad_cascade<T, N>& cascade);
+
+        /**
+         * @brief Creates a %dynamic_biquad_cascade holding the biquads in the range [first, last).
+         * @param first Input iterator defining the beginning of the range of biquads.
+         * @param last Input iterator defining the ending of the range of biquads.
+         */
+        template <typename InputIt>
+        dynamic_biquad_cascade(InputIt first, InputIt last);
+
+        /**
+         * @brief Returns the number of Biquads
+         * @return Number of biquads
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the number of Biquads the cascade can hold without allocating memory.
+         */
+        size_type capacity() const noexcept;
+
+        /**
+         * @brief Allocates the memory of the given number of Biquads.
+         * @param size Number of biquads.
+         */
+        void reserve(size_type size);
+
+        /**
+         * @brief Clear the contents of the cascade.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Reset all the internal Biquads to the original state.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Sets every Biquad to the state reached after filtering a constant input for an infinite time.
+         * @param value Value of the constant input of the cascade.
+         * @see biquad::prime
+         */
+        void prime(T value) noexcept;
+
+        /**
+         * @brief Returns a constant reference to the Biquad at specified location pos. No bounds checking is performed.
+         * @param index Position of the element to return.
+         * @return Constant reference to the requested Biquad.
+         */
+        const_reference operator[](size_type index) const noexcept;
+
+        /**
+         * @brief Returns a reference to the Biquad at specified location pos. No bounds checking is performed.
+         * @param index Position of the element to return.
+         * @return Reference to the requested Biquad.
+         */
+        reference operator[](size_type index) noexcept;
+
+        /**
+         * @brief Returns an iterator to the first element of the container.
+         */
+        iterator begin() noexcept;
+
+        /**
+         * @brief Returns an iterator to the last element of the container.
+         */
+        iterator end() noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the first element of the container.
+         */
+        const_iterator begin() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the last element of the container.
+         */
+        const_iterator end() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the first element of the container.
+         */
+        const_iterator cbegin() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the last element of the container.
+         */
+        const_iterator cend() const noexcept;
+
+        /**
+         * @brief Filters the signal in the range [first, last) and stores the result in another range, beginning at
+         * d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the output of filtering one digital time-step.
+         * @param value Input value to be filtered.
+         * @return Filtered value.
+         */
+        T tick(T value) noexcept;
+
+        /**
+         * @brief Appends the given Biquad at the end.
+         * @param biquad Biquad to append.
+         */
+        void push_back(const biquad<T>& biquad);
+
+        /**
+         * @brief Construct a Biquad in-place at the end.
+         * @param arg Arguments to forward to the constructor of the element
+         */
+        template <typename... Arg>
+        void emplace_back(Arg... arg);
+
+    private:
+        container_type cascade_;
+    };
+
+    template <typename T, typename Allocator>
+    template <std::size_t N>
+    dynamic_biquad_cascade<T, Allocator>::dynamic_biquad_cascade(const biquad_cascade<T, N>& cascade) :
+        cascade_(std::cbegin(cascade), std::cend(cascade)) {}
+
+    template <typename T, typename Allocator>
+    template <typename InputIt>
+    dynamic_biquad_cascade<T, Allocator>::dynamic_biquad_cascade(InputIt first, InputIt last) :
+        cascade_(first, last) {}
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::size_type dynamic_biquad_cascade<T, Allocator>::size() const
+        noexcept {
+        return cascade_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::size_type dynamic_biquad_cascade<T, Allocator>::capacity() const
+        noexcept {
+        return cascade_.capacity();
+    }
+
+    template <typename T, typename Allocator>
+    void dynamic_biquad_cascade<T, Allocator>::reserve(size_type size) {
+        cascade_.reserve(size);
+    }
+
+    template <typename T, typename Allocator>
+    void dynamic_biquad_cascade<T, Allocator>::clear() noexcept {
+        cascade_.clear();
+    }
+
+    template <typename T, typename Allocator>
+    void dynamic_biquad_cascade<T, Allocator>::reset() noexcept {
+        for (auto& stage : cascade_) {
+            stage.reset();
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void dynamic_biquad_cascade<T, Allocator>::prime(T value) noexcept {
+        for (auto& stage : cascade_) {
+            stage.prime(value);
+            value *= stage.dc_gain();
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::const_reference dynamic_biquad_cascade<T, Allocator>::
+        operator[](size_type index) const noexcept {
+        return cascade_[index];
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::reference dynamic_biquad_cascade<T, Allocator>::
+        operator[](size_type index) noexcept {
+        return cascade_[index];
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::iterator dynamic_biquad_cascade<T, Allocator>::begin() noexcept {
+        return std::begin(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::iterator dynamic_biquad_cascade<T, Allocator>::end() noexcept {
+        return std::end(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::const_iterator dynamic_biquad_cascade<T, Allocator>::begin() const
+        noexcept {
+        return std::cbegin(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::const_iterator dynamic_biquad_cascade<T, Allocator>::end() const
+        noexcept {
+        return std::cend(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::const_iterator dynamic_biquad_cascade<T, Allocator>::cbegin() const
+        noexcept {
+        return std::cbegin(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    typename dynamic_biquad_cascade<T, Allocator>::const_iterator dynamic_biquad_cascade<T, Allocator>::cend() const
+        noexcept {
+        return std::cend(cascade_);
+    }
+
+    template <typename T, typename Allocator>
+    T dynamic_biquad_cascade<T, Allocator>::tick(T value) noexcept {
+        for (auto& stage : cascade_) {
+            value = stage.tick(value);
+        }
+        return value;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    void dynamic_biquad_cascade<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<T>(guard);
+        for (; first != last; ++first, ++d_first) {
+            *d_first = tick(*first + offset);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void dynamic_biquad_cascade<T, Allocator>::push_back(const biquad<T>& biquad) {
+        cascade_.push_back(biquad);
+    }
+
+    template <typename T, typename Allocator>
+    template <typename... Arg>
+    void dynamic_biquad_cascade<T, Allocator>::emplace_back(Arg... arg) {
+        cascade_.emplace_back(arg...);
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_DYNAMIC_BIQUAD_CASCADE_HPP
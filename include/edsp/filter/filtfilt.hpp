@@ -0,0 +1,211 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: filtfilt.hpp
+ * Date: 31/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FILTFILT_HPP
+#define EDSP_FILTER_FILTFILT_HPP
+
+#include <edsp/core/parallel_for.hpp>
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/dynamic_biquad_cascade.hpp>
+#include <edsp/filter/fir.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @brief Number of samples filtered at once, small enough to keep the buffers of the filters in cache.
+         */
+        constexpr std::size_t filtfilt_block_size = 8192;
+
+        template <typename T>
+        constexpr std::size_t filtfilt_order(const biquad<T>&) noexcept {
+            return 2;
+        }
+
+        template <typename T, std::size_t N>
+        constexpr std::size_t filtfilt_order(const biquad_cascade<T, N>& cascade) noexcept {
+            return 2 * cascade.size();
+        }
+
+        template <typename T, typename Allocator>
+        std::size_t filtfilt_order(const dynamic_biquad_cascade<T, Allocator>& cascade) noexcept {
+            return 2 * cascade.size();
+        }
+
+        template <typename T, typename Allocator>
+        std::size_t filtfilt_order(const fir<T, Allocator>& filter) noexcept {
+            return filter.size() - 1;
+        }
+
+        /**
+         * @brief Filters the range [first, last) in blocks of filtfilt_block_size samples.
+         */
+        template <typename Filter, typename InputIt, typename OutputIt>
+        void filtfilt_blocks(Filter& filter, InputIt first, InputIt last, OutputIt d_first) {
+            auto remaining = std::distance(first, last);
+            while (remaining > 0) {
+                const auto size = std::min(remaining, static_cast<decltype(remaining)>(filtfilt_block_size));
+                const auto next = std::next(first, size);
+                filter.filter(first, next, d_first);
+                std::advance(d_first, size);
+                first = next;
+                remaining -= size;
+            }
+        }
+
+        /**
+         * @brief Filters the range [first, last) forward and backward with the given filter, which is reset before
+         * each pass.
+         */
+        template <typename Filter, typename RandomIt, typename OutputIt>
+        void filtfilt_passes(Filter& filter, RandomIt first, RandomIt last, OutputIt d_first, std::size_t padding) {
+            using value_type = meta::value_type_t<RandomIt>;
+            const auto size  = static_cast<std::size_t>(std::distance(first, last));
+            meta::expects(size > 0, "Expected a non empty signal");
+            meta::expects(padding < size, "Expected a signal longer than the padding");
+
+            // Odd extensions of both edges: 2 x[0] - x[padding], ..., 2 x[0] - x[1] and the symmetric ones at the end
+            std::vector<value_type> front(padding), back(padding);
+            const auto head = first[0];
+            const auto tail = first[size - 1];
+            for (std::size_t i = 0; i < padding; ++i) {
+                front[i] = 2 * head - first[padding - i];
+                back[i]  = 2 * tail - first[size - 2 - i];
+            }
+
+            // Forward pass: the filtered extensions are not part of the output, but the end one starts the backward
+            // pass
+            filter.reset();
+            filter.prime(padding > 0 ? front.front() : head);
+            internal::filtfilt_blocks(filter, std::begin(front), std::end(front), std::begin(front));
+            internal::filtfilt_blocks(filter, first, last, d_first);
+            internal::filtfilt_blocks(filter, std::begin(back), std::end(back), std::begin(back));
+
+            // Backward pass over the reversed end extension, then over the reversed output
+            const auto d_last  = d_first + static_cast<meta::diff_type_t<OutputIt>>(size);
+            const auto reverse = std::reverse_iterator<OutputIt>(d_last);
+            filter.reset();
+            filter.prime(padding > 0 ? back.back() : *reverse);
+            internal::filtfilt_blocks(filter, std::rbegin(back), std::rend(back), std::rbegin(back));
+            internal::filtfilt_blocks(filter, reverse, std::reverse_iterator<OutputIt>(d_first), reverse);
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Returns the number of samples used by default to extend every edge of the signal in filtfilt.
+     *
+     * As in most implementations, it is three times the order of the filter plus one.
+     */
+    template <typename Filter>
+    std::size_t filtfilt_padding(const Filter& filter) {
+        return 3 * (internal::filtfilt_order(filter) + 1);
+    }
+
+    /**
+     * @brief Filters the signal in the range [first, last) forward and backward, and stores the result in another range,
+     * beginning at d_first.
+     *
+     * The result has zero phase and a magnitude response equal to the square of the magnitude of the filter.
+     *
+     * To reduce the transients, the signal is extended at both edges with its odd reflection around the edge sample,
+     * and the filter starts every pass in the state it would reach after an infinite constant input equal to the first
+     * extended sample.
+     *
+     * Both passes filter the signal in blocks of a few thousand samples. The backward pass reads the output of the
+     * forward pass with reverse iterators and overwrites it in place, so no reversed copy of the signal is stored.
+     *
+     * The given filter is not modified: both passes run on a single copy of it, which is reset before each pass.
+     *
+     * @param filter Filter to apply. It must be copyable and provide reset, prime and filter, as biquad,
+     * biquad_cascade and fir do.
+     * @param first Random access iterator defining the beginning of the input range.
+     * @param last Random access iterator defining the ending of the input range.
+     * @param d_first Random access iterator defining the beginning of the destination range.
+     * @param padding Number of samples used to extend every edge. It must be lower than the size of the signal.
+     * @see filtfilt_padding
+     */
+    template <typename Filter, typename RandomIt, typename OutputIt>
+    void filtfilt(const Filter& filter, RandomIt first, RandomIt last, OutputIt d_first, std::size_t padding) {
+        auto state = filter;
+        internal::filtfilt_passes(state, first, last, d_first, padding);
+    }
+
+    /**
+     * @brief Filters the signal in the range [first, last) forward and backward with the default padding.
+     * @see filtfilt_padding
+     */
+    template <typename Filter, typename RandomIt, typename OutputIt>
+    void filtfilt(const Filter& filter, RandomIt first, RandomIt last, OutputIt d_first) {
+        const auto size = static_cast<std::size_t>(std::distance(first, last));
+        filtfilt(filter, first, last, d_first, std::min(filtfilt_padding(filter), size > 0 ? size - 1 : 0));
+    }
+
+    /**
+     * @brief Filters every channel of the interleaved signal in the range [first, last) forward and backward, and stores
+     * the result in another range, beginning at d_first.
+     *
+     * The channels are distributed among several threads. Every thread makes a single copy of the filter, reset
+     * before each pass, and a buffer holding one channel at a time.
+     *
+     * @param filter Filter to apply to every channel.
+     * @param first Random access iterator defining the beginning of the input range.
+     * @param last Random access iterator defining the ending of the input range.
+     * @param d_first Random access iterator defining the beginning of the destination range.
+     * @param channels Number of interleaved channels.
+     * @param threads Maximum number of threads. Zero uses one thread per hardware thread.
+     * @see filtfilt
+     */
+    template <typename Filter, typename RandomIt, typename OutputIt>
+    void filtfilt(const Filter& filter, RandomIt first, RandomIt last, OutputIt d_first, std::size_t channels,
+                  std::size_t threads) {
+        using value_type   = meta::value_type_t<RandomIt>;
+        const auto samples = static_cast<std::size_t>(std::distance(first, last));
+        meta::expects(channels > 0, "Expected at least one channel");
+        meta::expects(samples % channels == 0, "Expected an integer number of frames");
+        const auto frames = samples / channels;
+
+        // Every worker filters the channels it takes in its own buffer
+        parallel_for(channels, threads, [&]() {
+            return [&, state = filter, buffer = std::vector<value_type>(frames)](std::size_t channel) mutable {
+                for (std::size_t i = 0; i < frames; ++i) {
+                    buffer[i] = first[i * channels + channel];
+                }
+                const auto padding = std::min(filtfilt_padding(state), frames > 0 ? frames - 1 : 0);
+                internal::filtfilt_passes(state, std::begin(buffer), std::end(buffer), std::begin(buffer), padding);
+                for (std::size_t i = 0; i < frames; ++i) {
+                    d_first[i * channels + channel] = buffer[i];
+                }
+            };
+        });
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FILTFILT_HPP
@@ -0,0 +1,303 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fir.hpp
+ * Date: 29/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FIR_HPP
+#define EDSP_FILTER_FIR_HPP
+
+#include <edsp/algorithm/dot.hpp>
+#include <edsp/filter/internal/fir_kernel.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#if defined(USE_LIBFFTW) || defined(USE_LIBPFFFT)
+#    define EDSP_FIR_FFT_CONVOLUTION
+#    include <edsp/filter/internal/fft_convolver.hpp>
+#endif
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class fir
+     * @brief This class implements a Finite Impulse Response filter in direct form.
+     *
+     * The output is the convolution of the input with the coefficients of the filter:
+     *
+     * \f[
+     *  y(n) = \sum_{k=0}^{N-1} h(k) x(n-k)
+     * \f]
+     *
+     * Every channel keeps its last N inputs in a mirrored delay line, so each output is a single dot product over
+     * contiguous memory. Blocks are filtered over a contiguous copy of the delay line followed by the block.
+     *
+     * When a FFT library is available, blocks filtered with many coefficients are convolved with the overlap-save
+     * method instead. All the methods share the same delay line, so they can be mixed freely.
+     *
+     * @tparam T  Type of element.
+     * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class fir {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Number of coefficients from which the blocks are filtered in the frequency domain by default.
+         *
+         * The crossover depends on the FFT library. It has been measured with the edsp-filter-benchmark in single
+         * precision: with pffft, the frequency domain is faster from 32 to 64 coefficients. It has not been measured
+         * with FFTW, which uses the same default; run the FirDirectForm and FirOverlapSave benchmarks and adjust it
+         * with set_fft_threshold when using that library.
+         */
+        static constexpr size_type default_fft_threshold = 64;
+
+        /**
+         * @brief Creates a filter with the coefficients in the range [first, last).
+         * @param first Input iterator defining the beginning of the coefficients.
+         * @param last Input iterator defining the ending of the coefficients.
+         * @param channels Number of interleaved channels.
+         */
+        template <typename InputIt>
+        fir(InputIt first, InputIt last, size_type channels = 1);
+
+        /**
+         * @brief Creates a copy of another filter, including its delay lines.
+         *
+         * The frequency domain convolver is not shared: the copy builds its own from the copied coefficients on its
+         * first block filtered in the frequency domain.
+         * @param other Filter to copy.
+         */
+        fir(const fir& other);
+
+        /**
+         * @brief Replaces the contents of the filter with a copy of another filter, including its delay lines.
+         * @param other Filter to copy.
+         * @return Reference to this filter.
+         */
+        fir& operator=(const fir& other);
+
+        fir(fir&&) noexcept = default;
+        fir& operator=(fir&&) noexcept = default;
+        ~fir() = default;
+
+        /**
+         * @brief Returns the number of coefficients of the filter.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the number of interleaved channels.
+         */
+        size_type channels() const noexcept;
+
+        /**
+         * @brief Returns the number of coefficients from which the blocks are filtered in the frequency domain.
+         */
+        size_type fft_threshold() const noexcept;
+
+        /**
+         * @brief Updates the number of coefficients from which the blocks are filtered in the frequency domain.
+         *
+         * It has no effect if the library has been built without a FFT library.
+         */
+        void set_fft_threshold(size_type threshold) noexcept;
+
+        /**
+         * @brief Resets the delay lines of all the channels.
+         */
+        void reset();
+
+        /**
+         * @brief Fills the delay lines of all the channels with the given value, as if the filter had been fed with a
+         * constant input.
+         * @param value Value of the constant input.
+         */
+        void prime(value_type value);
+
+        /**
+         * @brief Filters the interleaved elements in the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Filters a single element of a filter with one channel.
+         * @return The output of the filter.
+         */
+        value_type operator()(value_type tick);
+
+    private:
+        std::vector<T, Allocator> coefficients_;
+        std::vector<T, Allocator> reversed_;
+        std::vector<internal::mirrored_history<T, Allocator>> histories_;
+        size_type threshold_{default_fft_threshold};
+
+        /* Buffers used to filter blocks */
+        std::vector<T, Allocator> planar_input_{};
+        std::vector<T, Allocator> planar_output_{};
+        std::vector<T, Allocator> window_{};
+
+#if defined(EDSP_FIR_FFT_CONVOLUTION)
+        std::unique_ptr<internal::fft_convolver<T>> convolver_{};
+#endif
+    };
+
+    template <typename T, typename Allocator>
+    constexpr typename fir<T, Allocator>::size_type fir<T, Allocator>::default_fft_threshold;
+
+    template <typename T, typename Allocator>
+    template <typename InputIt>
+    fir<T, Allocator>::fir(InputIt first, InputIt last, size_type channels) :
+        coefficients_(first, last),
+        reversed_(coefficients_.rbegin(), coefficients_.rend()),
+        histories_(channels, internal::mirrored_history<T, Allocator>(coefficients_.size())) {
+        meta::expects(!coefficients_.empty(), "Expected at least one coefficient");
+        meta::expects(channels > 0, "Expected at least one channel");
+    }
+
+    template <typename T, typename Allocator>
+    fir<T, Allocator>::fir(const fir& other) :
+        coefficients_(other.coefficients_),
+        reversed_(other.reversed_),
+        histories_(other.histories_),
+        threshold_(other.threshold_) {}
+
+    template <typename T, typename Allocator>
+    fir<T, Allocator>& fir<T, Allocator>::operator=(const fir& other) {
+        if (this != &other) {
+            coefficients_ = other.coefficients_;
+            reversed_     = other.reversed_;
+            histories_    = other.histories_;
+            threshold_    = other.threshold_;
+#if defined(EDSP_FIR_FFT_CONVOLUTION)
+            convolver_.reset();
+#endif
+        }
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    typename fir<T, Allocator>::size_type fir<T, Allocator>::size() const noexcept {
+        return coefficients_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename fir<T, Allocator>::size_type fir<T, Allocator>::channels() const noexcept {
+        return histories_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename fir<T, Allocator>::size_type fir<T, Allocator>::fft_threshold() const noexcept {
+        return threshold_;
+    }
+
+    template <typename T, typename Allocator>
+    void fir<T, Allocator>::set_fft_threshold(size_type threshold) noexcept {
+        threshold_ = threshold;
+    }
+
+    template <typename T, typename Allocator>
+    void fir<T, Allocator>::reset() {
+        for (auto& history : histories_) {
+            history.reset();
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void fir<T, Allocator>::prime(value_type value) {
+        for (auto& history : histories_) {
+            history.fill(value);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename fir<T, Allocator>::value_type fir<T, Allocator>::operator()(value_type tick) {
+        meta::expects(histories_.size() == 1, "Expected a filter with one channel");
+        auto& history = histories_.front();
+        history.push(tick);
+        return algorithm::dot(history.data(), history.data() + coefficients_.size(), coefficients_.data());
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    void fir<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const auto channels = histories_.size();
+        const auto taps     = coefficients_.size();
+        const auto samples  = static_cast<size_type>(std::distance(first, last));
+        const auto frames   = samples / channels;
+        meta::expects(samples % channels == 0, "Expected an integer number of frames");
+
+        planar_input_.resize(samples);
+        planar_output_.resize(samples);
+        window_.resize(taps - 1 + frames);
+        for (size_type i = 0; i < frames; ++i) {
+            for (size_type channel = 0; channel < channels; ++channel, ++first) {
+                planar_input_[channel * frames + i] = *first;
+            }
+        }
+
+        for (size_type channel = 0; channel < channels; ++channel) {
+            const auto input  = planar_input_.data() + channel * frames;
+            const auto output = planar_output_.data() + channel * frames;
+            auto& history     = histories_[channel];
+            history.recent(window_.data(), taps - 1);
+
+#if defined(EDSP_FIR_FFT_CONVOLUTION)
+            if (taps >= threshold_ && frames >= taps) {
+                if (!convolver_) {
+                    convolver_.reset(new internal::fft_convolver<T>(coefficients_.data(), taps));
+                }
+                convolver_->process(input, output, frames, window_.data());
+            } else
+#endif
+            {
+                // The window holds the inputs from the oldest to the newest, so it is read with the reversed
+                // coefficients. Unlike the delay line, it is not written right before being read.
+                std::copy(input, input + frames, window_.data() + taps - 1);
+                for (size_type i = 0; i < frames; ++i) {
+                    output[i] = algorithm::dot(window_.data() + i, window_.data() + i + taps, reversed_.data());
+                }
+            }
+
+            for (auto it = input + frames - std::min(frames, taps); it != input + frames; ++it) {
+                history.push(*it);
+            }
+        }
+
+        for (size_type i = 0; i < frames; ++i) {
+            for (size_type channel = 0; channel < channels; ++channel, ++d_first) {
+                *d_first = planar_output_[channel * frames + i];
+            }
+        }
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FIR_HPP
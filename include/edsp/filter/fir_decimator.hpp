@@ -0,0 +1,145 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fir_decimator.hpp
+ * Date: 29/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FIR_DECIMATOR_HPP
+#define EDSP_FILTER_FIR_DECIMATOR_HPP
+
+#include <edsp/algorithm/dot.hpp>
+#include <edsp/filter/internal/fir_kernel.hpp>
+#include <edsp/meta/expects.hpp>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class fir_decimator
+     * @brief This class implements a FIR filter followed by a downsampler by an integer factor M.
+     *
+     * Only one of every M outputs of the filter is kept, so the filter is only evaluated for those outputs:
+     *
+     * \f[
+     *  y(m) = \sum_{k=0}^{N-1} h(k) x(mM-k)
+     * \f]
+     *
+     * The discarded inputs are still stored in the delay line, which costs a copy per input instead of a dot product.
+     *
+     * The decimator processes a single channel. Interleaved signals have to be deinterleaved first, with one
+     * decimator per channel.
+     *
+     * @tparam T  Type of element.
+     * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class fir_decimator {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a decimator with the coefficients in the range [first, last).
+         * @param first Input iterator defining the beginning of the coefficients.
+         * @param last Input iterator defining the ending of the coefficients.
+         * @param factor Decimation factor.
+         */
+        template <typename InputIt>
+        fir_decimator(InputIt first, InputIt last, size_type factor);
+
+        /**
+         * @brief Returns the number of coefficients of the filter.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the decimation factor.
+         */
+        size_type factor() const noexcept;
+
+        /**
+         * @brief Resets the delay line and the decimation phase.
+         */
+        void reset();
+
+        /**
+         * @brief Decimates the elements in the range [first, last) and stores the result in another range, beginning
+         * at d_first.
+         *
+         * The phase is kept between calls, so the number of outputs depends on the number of inputs filtered before.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt filter(InputIt first, InputIt last, OutputIt d_first);
+
+    private:
+        std::vector<T, Allocator> coefficients_;
+        internal::mirrored_history<T, Allocator> history_;
+        size_type factor_;
+        size_type phase_{0};
+    };
+
+    template <typename T, typename Allocator>
+    template <typename InputIt>
+    fir_decimator<T, Allocator>::fir_decimator(InputIt first, InputIt last, size_type factor) :
+        coefficients_(first, last),
+        history_(coefficients_.size()),
+        factor_(factor) {
+        meta::expects(!coefficients_.empty(), "Expected at least one coefficient");
+        meta::expects(factor > 0, "Expected a positive decimation factor");
+    }
+
+    template <typename T, typename Allocator>
+    typename fir_decimator<T, Allocator>::size_type fir_decimator<T, Allocator>::size() const noexcept {
+        return coefficients_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename fir_decimator<T, Allocator>::size_type fir_decimator<T, Allocator>::factor() const noexcept {
+        return factor_;
+    }
+
+    template <typename T, typename Allocator>
+    void fir_decimator<T, Allocator>::reset() {
+        history_.reset();
+        phase_ = 0;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    OutputIt fir_decimator<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        for (; first != last; ++first) {
+            history_.push(*first);
+            if (phase_ == 0) {
+                *d_first = algorithm::dot(history_.data(), history_.data() + coefficients_.size(), coefficients_.data());
+                ++d_first;
+            }
+            phase_ = (phase_ + 1 == factor_) ? 0 : phase_ + 1;
+        }
+        return d_first;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FIR_DECIMATOR_HPP
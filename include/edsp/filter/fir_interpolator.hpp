@@ -0,0 +1,153 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fir_interpolator.hpp
+ * Date: 29/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FIR_INTERPOLATOR_HPP
+#define EDSP_FILTER_FIR_INTERPOLATOR_HPP
+
+#include <edsp/algorithm/dot.hpp>
+#include <edsp/filter/internal/fir_kernel.hpp>
+#include <edsp/meta/expects.hpp>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class fir_interpolator
+     * @brief This class implements an upsampler by an integer factor L followed by a FIR filter.
+     *
+     * The upsampler inserts L - 1 zeros after every input, so most of the products of the filter are null. The
+     * coefficients are split in L polyphase branches, where the branch p holds the coefficients h(kL + p), and every
+     * input produces L outputs, one per branch:
+     *
+     * \f[
+     *  y(nL + p) = \sum_{k} h(kL + p) x(n-k)
+     * \f]
+     *
+     * @note The filter is not scaled: the coefficients should have a gain of L in the passband to keep the amplitude
+     * of the input.
+     *
+     * The interpolator processes a single channel. Interleaved signals have to be deinterleaved first, with one
+     * interpolator per channel.
+     *
+     * @tparam T  Type of element.
+     * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class fir_interpolator {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates an interpolator with the coefficients in the range [first, last).
+         * @param first Input iterator defining the beginning of the coefficients.
+         * @param last Input iterator defining the ending of the coefficients.
+         * @param factor Interpolation factor.
+         */
+        template <typename InputIt>
+        fir_interpolator(InputIt first, InputIt last, size_type factor);
+
+        /**
+         * @brief Returns the number of coefficients of the filter.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the interpolation factor.
+         */
+        size_type factor() const noexcept;
+
+        /**
+         * @brief Resets the delay line.
+         */
+        void reset();
+
+        /**
+         * @brief Interpolates the elements in the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range, with space for L outputs per
+         * input.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt filter(InputIt first, InputIt last, OutputIt d_first);
+
+    private:
+        std::vector<T, Allocator> branches_;
+        internal::mirrored_history<T, Allocator> history_;
+        size_type size_;
+        size_type factor_;
+    };
+
+    template <typename T, typename Allocator>
+    template <typename InputIt>
+    fir_interpolator<T, Allocator>::fir_interpolator(InputIt first, InputIt last, size_type factor) :
+        history_(factor > 0 ? (static_cast<size_type>(std::distance(first, last)) + factor - 1) / factor : 0),
+        size_(static_cast<size_type>(std::distance(first, last))),
+        factor_(factor) {
+        meta::expects(size_ > 0, "Expected at least one coefficient");
+        meta::expects(factor > 0, "Expected a positive interpolation factor");
+
+        // Every branch is padded with zeros to the same length
+        const auto length = history_.size();
+        branches_.resize(length * factor_, T());
+        for (size_type i = 0; first != last; ++first, ++i) {
+            branches_[(i % factor_) * length + i / factor_] = *first;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename fir_interpolator<T, Allocator>::size_type fir_interpolator<T, Allocator>::size() const noexcept {
+        return size_;
+    }
+
+    template <typename T, typename Allocator>
+    typename fir_interpolator<T, Allocator>::size_type fir_interpolator<T, Allocator>::factor() const noexcept {
+        return factor_;
+    }
+
+    template <typename T, typename Allocator>
+    void fir_interpolator<T, Allocator>::reset() {
+        history_.reset();
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    OutputIt fir_interpolator<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const auto length = history_.size();
+        for (; first != last; ++first) {
+            history_.push(*first);
+            for (size_type p = 0; p < factor_; ++p, ++d_first) {
+                *d_first = algorithm::dot(history_.data(), history_.data() + length, branches_.data() + p * length);
+            }
+        }
+        return d_first;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FIR_INTERPOLATOR_HPP
@@ -0,0 +1,315 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: freqz.hpp
+ * Date: 01/11/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FREQZ_HPP
+#define EDSP_FILTER_FREQZ_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/dynamic_biquad_cascade.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @brief Frequency response of a digital filter evaluated at K points of the upper half of the unit circle.
+     *
+     * The point k corresponds to the normalized angular frequency \f$ \omega_k = \pi k / K \f$, in radians per sample.
+     */
+    template <typename T>
+    struct frequency_response {
+        std::vector<T> magnitude;   /*!< Magnitude \f$ |H(e^{j\omega_k})| \f$ */
+        std::vector<T> phase;       /*!< Phase in radians, wrapped to \f$ [-\pi, \pi] \f$ */
+        std::vector<T> group_delay; /*!< Group delay \f$ -d\phi / d\omega \f$ in samples */
+    };
+
+    inline namespace internal {
+
+        /**
+         * @brief Computes \f$ e^{-j \pi k / K} \f$ for k in [0, K).
+         *
+         * Consecutive points are obtained by a complex rotation, and the rotation restarts from an exact value every few
+         * points to bound the rounding errors, so only a small fraction of the points needs a sine and a cosine.
+         */
+        template <typename T>
+        std::vector<std::complex<T>> unit_circle(std::size_t K) {
+            constexpr std::size_t anchor_interval = 64;
+            const auto step = std::polar(T(1), -math::constants<T>::pi / static_cast<T>(K));
+
+            std::vector<std::complex<T>> points(K);
+            for (std::size_t k = 0; k < K; ++k) {
+                points[k] = (k % anchor_interval == 0)
+                                ? std::polar(T(1), -math::constants<T>::pi * static_cast<T>(k) / static_cast<T>(K))
+                                : points[k - 1] * step;
+            }
+            return points;
+        }
+
+        /**
+         * @brief Evaluates the polynomial \f$ P(z) = \sum_n p_n z^n \f$ and \f$ z P'(z) \f$ with the Horner scheme.
+         *
+         * With \f$ z = e^{-j\omega} \f$, the group delay of P is the real part of \f$ z P'(z) / P(z) \f$.
+         *
+         * The complex arithmetic is written on the real and imaginary parts: the operators of std::complex handle
+         * infinities and NaNs, which prevents the compiler from inlining them.
+         */
+        template <typename T>
+        void horner(const T* coefficients, std::size_t size, const std::complex<T>& z, T (&value)[2],
+                    T (&derivative)[2]) noexcept {
+            const auto zr = z.real(), zi = z.imag();
+            T vr = 0, vi = 0, dr = 0, di = 0;
+            for (auto n = size; n > 0; --n) {
+                const auto next_dr = dr * zr - di * zi + vr;
+                const auto next_di = dr * zi + di * zr + vi;
+                const auto next_vr = vr * zr - vi * zi + coefficients[n - 1];
+                const auto next_vi = vr * zi + vi * zr;
+                dr = next_dr, di = next_di, vr = next_vr, vi = next_vi;
+            }
+            value[0]      = vr;
+            value[1]      = vi;
+            derivative[0] = dr * zr - di * zi;
+            derivative[1] = dr * zi + di * zr;
+        }
+
+        /**
+         * @brief Evaluates a polynomial of any degree.
+         */
+        template <typename T>
+        struct polynomial {
+            const T* coefficients;
+            std::size_t size;
+
+            void operator()(const std::complex<T>& z, T (&value)[2], T (&derivative)[2]) const noexcept {
+                horner(coefficients, size, z, value, derivative);
+            }
+
+            /**
+             * @brief Returns the sum of the magnitudes of the coefficients, the largest value on the unit circle.
+             */
+            T scale() const noexcept {
+                auto sum = T(0);
+                for (std::size_t i = 0; i < size; ++i) {
+                    sum += std::abs(coefficients[i]);
+                }
+                return sum;
+            }
+        };
+
+        /**
+         * @brief Evaluates a polynomial of degree two in closed form, which avoids the dependent steps of the Horner
+         * scheme in the biquads.
+         */
+        template <typename T>
+        struct quadratic {
+            T c0, c1, c2;
+
+            void operator()(const std::complex<T>& z, T (&value)[2], T (&derivative)[2]) const noexcept {
+                const auto zr = z.real(), zi = z.imag();
+                const auto z2r = zr * zr - zi * zi, z2i = 2 * zr * zi;
+                derivative[0]  = c1 * zr + 2 * c2 * z2r;
+                derivative[1]  = c1 * zi + 2 * c2 * z2i;
+                value[0]       = c0 + c1 * zr + c2 * z2r;
+                value[1]       = c1 * zi + c2 * z2i;
+            }
+
+            T scale() const noexcept {
+                return std::abs(c0) + std::abs(c1) + std::abs(c2);
+            }
+        };
+
+        /**
+         * @brief Returns the group delay of a polynomial, \f$ Re(z P'(z) \overline{P(z)}) / |P(z)|^2 \f$.
+         */
+        template <typename T>
+        T polynomial_delay(const T (&value)[2], const T (&derivative)[2]) noexcept {
+            return (derivative[0] * value[0] + derivative[1] * value[1]) / (value[0] * value[0] + value[1] * value[1]);
+        }
+
+        /**
+         * @brief Returns the group delay of a polynomial at one of its zeros on the unit circle.
+         *
+         * Every zero on the unit circle adds a delay of 1/2 sample at both of its sides, so the delay is continuous
+         * through the zero: its limit is approximated by the mean of the delays at two close points on both sides.
+         */
+        template <typename T, typename Polynomial>
+        T zero_delay(const Polynomial& p, const std::complex<T>& z) {
+            const auto rotation = std::polar(T(1), std::sqrt(std::sqrt(std::numeric_limits<T>::epsilon())));
+            T value[2], derivative[2];
+            p(z * rotation, value, derivative);
+            const auto before = polynomial_delay(value, derivative);
+            p(z * std::conj(rotation), value, derivative);
+            return (before + polynomial_delay(value, derivative)) / 2;
+        }
+
+        /**
+         * @brief Multiplies the response by B(z) / A(z) and adds the group delay of the quotient.
+         */
+        template <typename T, typename Numerator, typename Denominator>
+        void freqz_accumulate(const Numerator& b, const Denominator& a, const std::vector<std::complex<T>>& points,
+                              std::vector<std::complex<T>>& response, std::vector<T>& group_delay) {
+            // Below this norm the value of B is dominated by the rounding errors of its coefficients, as in the
+            // high-pass filters whose coefficients sum to a tiny value instead of zero at DC
+            const auto scale     = b.scale();
+            const auto tolerance = std::numeric_limits<T>::epsilon() * scale * scale;
+
+            T numerator[2], numerator_derivative[2], denominator[2], denominator_derivative[2];
+            for (std::size_t k = 0; k < points.size(); ++k) {
+                b(points[k], numerator, numerator_derivative);
+                a(points[k], denominator, denominator_derivative);
+
+                const auto numerator_norm      = numerator[0] * numerator[0] + numerator[1] * numerator[1];
+                const auto denominator_norm    = denominator[0] * denominator[0] + denominator[1] * denominator[1];
+                const auto inverse_denominator = T(1) / denominator_norm;
+
+                // B / A = B conj(A) / |A|^2
+                const auto qr = (numerator[0] * denominator[0] + numerator[1] * denominator[1]) * inverse_denominator;
+                const auto qi = (numerator[1] * denominator[0] - numerator[0] * denominator[1]) * inverse_denominator;
+                const auto hr = response[k].real(), hi = response[k].imag();
+                response[k]   = std::complex<T>(hr * qr - hi * qi, hr * qi + hi * qr);
+
+                // Re(z P' / P) = Re(z P' conj(P)) / |P|^2, the zeros of B on the unit circle, as in the high-pass
+                // filters at DC, need the limit. The ones within sqrt(epsilon) of a zero are treated as the zero.
+                const auto numerator_delay = (numerator_norm <= tolerance)
+                                                 ? zero_delay(b, points[k])
+                                                 : polynomial_delay(numerator, numerator_derivative);
+                const auto denominator_delay =
+                    (denominator_derivative[0] * denominator[0] + denominator_derivative[1] * denominator[1]) *
+                    inverse_denominator;
+                group_delay[k] += numerator_delay - denominator_delay;
+            }
+        }
+
+        template <typename T>
+        void freqz_accumulate(const biquad<T>& stage, const std::vector<std::complex<T>>& points,
+                              std::vector<std::complex<T>>& response, std::vector<T>& group_delay) {
+            freqz_accumulate(quadratic<T>{stage.b0(), stage.b1(), stage.b2()},
+                             quadratic<T>{stage.a0(), stage.a1(), stage.a2()}, points, response, group_delay);
+        }
+
+        template <typename T>
+        frequency_response<T> freqz_finish(const std::vector<std::complex<T>>& response, std::vector<T> group_delay) {
+            frequency_response<T> result{std::vector<T>(response.size()), std::vector<T>(response.size()),
+                                         std::move(group_delay)};
+            for (std::size_t k = 0; k < response.size(); ++k) {
+                const auto re       = response[k].real(), im = response[k].imag();
+                result.magnitude[k] = std::sqrt(re * re + im * im);
+                result.phase[k]     = std::atan2(im, re);
+            }
+            return result;
+        }
+
+        template <typename T, typename Cascade>
+        frequency_response<T> freqz_cascade(const Cascade& cascade, std::size_t K) {
+            const auto points = unit_circle<T>(K);
+            std::vector<std::complex<T>> response(K, std::complex<T>(1, 0));
+            std::vector<T> group_delay(K, 0);
+            for (const auto& stage : cascade) {
+                freqz_accumulate(stage, points, response, group_delay);
+            }
+            return freqz_finish(response, std::move(group_delay));
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Computes the frequency response of the digital filter with transfer function
+     *
+     * \f[
+     *  H(z) = \frac{b_0 + b_1 z^{-1} + \cdots + b_{M-1} z^{-(M-1)}}{a_0 + a_1 z^{-1} + \cdots + a_{N-1} z^{-(N-1)}}
+     * \f]
+     *
+     * The points of the unit circle are computed once, and the polynomials and their derivatives are evaluated with
+     * the Horner scheme, so the cost is proportional to K (M + N) multiplications without trigonometric functions. The
+     * group delay is computed analytically from the derivatives.
+     *
+     * @param b_first Beginning of the range elements representing the FIR/MA filter coefficients.
+     * @param b_last End of the range elements representing the FIR/MA filter coefficients.
+     * @param a_first Beginning of the range elements representing the IIR/AR filter coefficients.
+     * @param a_last End of the range elements representing the IIR/AR filter coefficients.
+     * @param K Number of evaluation points.
+     * @return Magnitude, phase and group delay of the filter.
+     */
+    template <typename InputIt>
+    frequency_response<meta::value_type_t<InputIt>> freqz(InputIt b_first, InputIt b_last, InputIt a_first,
+                                                          InputIt a_last, std::size_t K) {
+        using value_type = meta::value_type_t<InputIt>;
+        const std::vector<value_type> b(b_first, b_last), a(a_first, a_last);
+        const auto points = internal::unit_circle<value_type>(K);
+
+        std::vector<std::complex<value_type>> response(K, std::complex<value_type>(1, 0));
+        std::vector<value_type> group_delay(K, 0);
+        internal::freqz_accumulate(internal::polynomial<value_type>{b.data(), b.size()},
+                                   internal::polynomial<value_type>{a.data(), a.size()}, points, response, group_delay);
+        return internal::freqz_finish(response, std::move(group_delay));
+    }
+
+    /**
+     * @brief Computes the frequency response of a biquad.
+     * @param filter Biquad filter.
+     * @param K Number of evaluation points.
+     * @return Magnitude, phase and group delay of the filter.
+     */
+    template <typename T>
+    frequency_response<T> freqz(const biquad<T>& filter, std::size_t K) {
+        const auto points = internal::unit_circle<T>(K);
+        std::vector<std::complex<T>> response(K, std::complex<T>(1, 0));
+        std::vector<T> group_delay(K, 0);
+        internal::freqz_accumulate(filter, points, response, group_delay);
+        return internal::freqz_finish(response, std::move(group_delay));
+    }
+
+    /**
+     * @brief Computes the frequency response of a cascade of biquads.
+     *
+     * The responses of the stages are multiplied and their group delays added, all of them evaluated over the same
+     * points of the unit circle.
+     *
+     * @param cascade Cascade of biquads.
+     * @param K Number of evaluation points.
+     * @return Magnitude, phase and group delay of the cascade.
+     */
+    template <typename T, std::size_t N>
+    frequency_response<T> freqz(const biquad_cascade<T, N>& cascade, std::size_t K) {
+        return internal::freqz_cascade<T>(cascade, K);
+    }
+
+    /**
+     * @brief Computes the frequency response of a cascade of biquads sized at runtime.
+     * @param cascade Cascade of biquads.
+     * @param K Number of evaluation points.
+     * @return Magnitude, phase and group delay of the cascade.
+     */
+    template <typename T, typename Allocator>
+    frequency_response<T> freqz(const dynamic_biquad_cascade<T, Allocator>& cascade, std::size_t K) {
+        return internal::freqz_cascade<T>(cascade, K);
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FREQZ_HPP
@@ -0,0 +1,354 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: gammatone_bank.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_GAMMATONE_BANK_HPP
+#define EDSP_FILTER_GAMMATONE_BANK_HPP
+
+#include <edsp/auditory/erbspace.hpp>
+#include <edsp/core/denormal_guard.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class gammatone_bank
+     * @brief This class implements a bank of gammatone filters, the usual model of the auditory filters of the
+     * basilar membrane.
+     *
+     * Every band is approximated by a cascade of Order identical complex one-pole resonators, as proposed by Hohmann:
+     *
+     * \f[
+     *  z_n = x_n + \tilde{a} z_{n-1}, \qquad \tilde{a} = \lambda e^{j 2 \pi f_c / f_s}, \qquad
+     *  \lambda = e^{-2 \pi b / f_s}
+     * \f]
+     *
+     * The bandwidth parameter b is chosen so the equivalent rectangular bandwidth of the cascade equals the ERB of
+     * the auditory filter at the centre frequency, \f$ 24.7 + f_c / 9.26449 \f$ Hz (about 1.019 ERB for the usual
+     * fourth order). The input is scaled by \f$ 2 (1 - \lambda)^{Order} \f$, so a sinusoid at the centre frequency has
+     * unit gain.
+     *
+     * The output of every band is complex: its real part is the filtered signal, its magnitude the Hilbert envelope
+     * and the cosine of its phase the temporal fine structure. The states of all the bands are stored contiguously
+     * for every stage, and the bands are updated in the innermost loop, so the compiler processes several bands at
+     * once in the SIMD lanes.
+     *
+     * The outputs are interleaved: every frame stores one value per band, in ascending frequency. With a decimation
+     * factor D only one every D frames is stored, which is useful for the envelopes; the recursions still run at the
+     * full sampling rate.
+     *
+     * @tparam T  Type of element.
+     * @tparam Order  Number of resonators of every band.
+     */
+    template <typename T, std::size_t Order = 4>
+    class gammatone_bank {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a filter bank from its centre frequencies.
+         * @param first Input iterator defining the beginning of the range of centre frequencies in Hz.
+         * @param last Input iterator defining the ending of the range of centre frequencies in Hz.
+         * @param sample_rate The sampling frequency in Hz.
+         * @param decimation Number of input frames per output frame.
+         */
+        template <typename InputIt>
+        gammatone_bank(InputIt first, InputIt last, T sample_rate, size_type decimation = 1);
+
+        /**
+         * @brief Creates a filter bank with centre frequencies uniformly spaced on the ERB scale.
+         * @param sample_rate The sampling frequency in Hz.
+         * @param min_frequency Centre frequency of the lowest band in Hz.
+         * @param max_frequency Centre frequency of the highest band in Hz.
+         * @param bands Number of bands.
+         * @param decimation Number of input frames per output frame.
+         */
+        gammatone_bank(T sample_rate, T min_frequency, T max_frequency, size_type bands, size_type decimation = 1);
+
+        /**
+         * @brief Returns the number of bands.
+         */
+        size_type bands() const noexcept;
+
+        /**
+         * @brief Returns the number of input frames per output frame.
+         */
+        size_type decimation() const noexcept;
+
+        /**
+         * @brief Returns the centre frequency of a band in Hz.
+         */
+        value_type frequency(size_type band) const;
+
+        /**
+         * @brief Resets the state of the filters.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Filters the elements in the range [first, last) and stores the filtered signal of every band in the
+         * range beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Filters the elements in the range [first, last) and stores the envelope of every band in the range
+         * beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt envelope(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Filters the elements in the range [first, last) and stores the fine structure of every band, the
+         * filtered signal divided by its envelope, in the range beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt fine_structure(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Filters the elements in the range [first, last) and stores both the envelope and the fine structure
+         * of every band, in the ranges beginning at e_first and f_first respectively.
+         *
+         * It is equivalent to calling envelope and fine_structure over the same input, with a single pass of the
+         * filters.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param e_first Output iterator defining the beginning of the destination range of the envelopes.
+         * @param f_first Output iterator defining the beginning of the destination range of the fine structures.
+         * @return Output iterators to the elements past the last elements written in both ranges.
+         */
+        template <typename InputIt, typename EnvelopeIt, typename FineIt>
+        std::pair<EnvelopeIt, FineIt> envelope_and_fine_structure(InputIt first, InputIt last, EnvelopeIt e_first,
+                                                                  FineIt f_first);
+
+    private:
+        template <typename InputIt, typename Emit>
+        void run(InputIt first, InputIt last, Emit emit);
+
+        template <typename InputIt, typename OutputIt, typename Mapping>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first, Mapping map);
+
+        void initialise(T sample_rate);
+
+        std::vector<T> frequencies_;
+        std::vector<T> pole_re_;
+        std::vector<T> pole_im_;
+        std::vector<T> gain_;
+        std::vector<T> state_;
+        std::vector<T> output_;
+        size_type decimation_;
+        size_type phase_{0};
+    };
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt>
+    gammatone_bank<T, Order>::gammatone_bank(InputIt first, InputIt last, T sample_rate, size_type decimation) :
+        frequencies_(first, last),
+        decimation_(decimation) {
+        initialise(sample_rate);
+    }
+
+    template <typename T, std::size_t Order>
+    gammatone_bank<T, Order>::gammatone_bank(T sample_rate, T min_frequency, T max_frequency, size_type bands,
+                                             size_type decimation) :
+        frequencies_(bands),
+        decimation_(decimation) {
+        meta::expects(min_frequency > 0 && min_frequency <= max_frequency, "Expected a valid frequency range");
+        auditory::erbspace(std::begin(frequencies_), min_frequency, max_frequency, bands);
+        initialise(sample_rate);
+    }
+
+    template <typename T, std::size_t Order>
+    void gammatone_bank<T, Order>::initialise(T sample_rate) {
+        static_assert(Order > 0, "Expected at least one resonator per band");
+        meta::expects(!frequencies_.empty(), "Expected at least one band");
+        meta::expects(decimation_ > 0, "Expected a positive decimation factor");
+
+        // ERB of the cascade relative to its bandwidth parameter: pi (2n - 2)! / (2^(2n - 2) ((n - 1)!)^2)
+        auto ratio = constants<T>::pi;
+        for (size_type k = 1; k < Order; ++k) {
+            ratio *= static_cast<T>(2 * k - 1) / static_cast<T>(2 * k);
+        }
+
+        const auto bands = frequencies_.size();
+        pole_re_.resize(bands);
+        pole_im_.resize(bands);
+        gain_.resize(bands);
+        output_.resize(2 * bands);
+        state_.assign(2 * Order * bands, T(0));
+        for (size_type k = 0; k < bands; ++k) {
+            const auto fc = frequencies_[k];
+            meta::expects(fc > 0 && fc < sample_rate / 2, "Expected the centre frequencies below the Nyquist frequency");
+            const auto erb    = T(24.7) + fc / T(9.26449);
+            const auto lambda = std::exp(-constants<T>::two_pi * erb / (ratio * sample_rate));
+            const auto beta   = constants<T>::two_pi * fc / sample_rate;
+            pole_re_[k]       = lambda * std::cos(beta);
+            pole_im_[k]       = lambda * std::sin(beta);
+            gain_[k]          = 2 * std::pow(1 - lambda, static_cast<T>(Order));
+        }
+    }
+
+    template <typename T, std::size_t Order>
+    typename gammatone_bank<T, Order>::size_type gammatone_bank<T, Order>::bands() const noexcept {
+        return frequencies_.size();
+    }
+
+    template <typename T, std::size_t Order>
+    typename gammatone_bank<T, Order>::size_type gammatone_bank<T, Order>::decimation() const noexcept {
+        return decimation_;
+    }
+
+    template <typename T, std::size_t Order>
+    typename gammatone_bank<T, Order>::value_type gammatone_bank<T, Order>::frequency(size_type band) const {
+        meta::expects(band < bands(), "Index out of bounds");
+        return frequencies_[band];
+    }
+
+    template <typename T, std::size_t Order>
+    void gammatone_bank<T, Order>::reset() noexcept {
+        std::fill(std::begin(state_), std::end(state_), T(0));
+        phase_ = 0;
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename Emit>
+    void gammatone_bank<T, Order>::run(InputIt first, InputIt last, Emit emit) {
+        const auto bands = frequencies_.size();
+        const auto* ar   = pole_re_.data();
+        const auto* ai   = pole_im_.data();
+        const auto* gain = gain_.data();
+
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<T>(guard);
+        for (; first != last; ++first) {
+            const auto x = static_cast<T>(*first) + offset;
+
+            // The states of a stage are stored as the real parts of all the bands followed by their imaginary parts
+            auto* re = state_.data();
+            auto* im = re + bands;
+            for (size_type k = 0; k < bands; ++k) {
+                const auto next_re = ar[k] * re[k] - ai[k] * im[k] + gain[k] * x;
+                const auto next_im = ar[k] * im[k] + ai[k] * re[k];
+                re[k]              = next_re;
+                im[k]              = next_im;
+            }
+            for (size_type stage = 1; stage < Order; ++stage) {
+                const auto* previous_re = re;
+                const auto* previous_im = im;
+                re += 2 * bands;
+                im += 2 * bands;
+                for (size_type k = 0; k < bands; ++k) {
+                    const auto next_re = ar[k] * re[k] - ai[k] * im[k] + previous_re[k];
+                    const auto next_im = ar[k] * im[k] + ai[k] * re[k] + previous_im[k];
+                    re[k]              = next_re;
+                    im[k]              = next_im;
+                }
+            }
+
+            if (phase_ == 0) {
+                emit(re, im);
+            }
+            phase_ = (phase_ + 1 == decimation_) ? 0 : phase_ + 1;
+        }
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename OutputIt, typename Mapping>
+    OutputIt gammatone_bank<T, Order>::process(InputIt first, InputIt last, OutputIt d_first, Mapping map) {
+        const auto bands = frequencies_.size();
+        auto* output     = output_.data();
+        run(first, last, [&](const T* re, const T* im) {
+            for (size_type k = 0; k < bands; ++k) {
+                output[k] = map(re[k], im[k]);
+            }
+            d_first = std::copy(output, output + bands, d_first);
+        });
+        return d_first;
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename OutputIt>
+    OutputIt gammatone_bank<T, Order>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        return process(first, last, d_first, [](T re, T) { return re; });
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename OutputIt>
+    OutputIt gammatone_bank<T, Order>::envelope(InputIt first, InputIt last, OutputIt d_first) {
+        return process(first, last, d_first, [](T re, T im) { return std::sqrt(re * re + im * im); });
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename OutputIt>
+    OutputIt gammatone_bank<T, Order>::fine_structure(InputIt first, InputIt last, OutputIt d_first) {
+        return process(first, last, d_first, [](T re, T im) {
+            const auto magnitude = std::sqrt(re * re + im * im);
+            return magnitude > 0 ? re / magnitude : T(0);
+        });
+    }
+
+    template <typename T, std::size_t Order>
+    template <typename InputIt, typename EnvelopeIt, typename FineIt>
+    std::pair<EnvelopeIt, FineIt>
+        gammatone_bank<T, Order>::envelope_and_fine_structure(InputIt first, InputIt last, EnvelopeIt e_first,
+                                                              FineIt f_first) {
+        const auto bands = frequencies_.size();
+        auto* envelope   = output_.data();
+        auto* fine       = envelope + bands;
+        run(first, last, [&](const T* re, const T* im) {
+            for (size_type k = 0; k < bands; ++k) {
+                const auto magnitude = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+                envelope[k]          = magnitude;
+                fine[k]              = magnitude > 0 ? re[k] / magnitude : T(0);
+            }
+            e_first = std::copy(envelope, envelope + bands, e_first);
+            f_first = std::copy(fine, fine + bands, f_first);
+        });
+        return {e_first, f_first};
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_GAMMATONE_BANK_HPP
@@ -0,0 +1,159 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: bessel_designer.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_BESSEL_DESIGNER_HPP
+#define EDSP_BESSEL_DESIGNER_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/filter/internal/bilinear/bandpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/bandstop_transformer.hpp>
+#include <edsp/filter/internal/bilinear/lowpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/highpass_transformer.hpp>
+#include <edsp/filter/internal/abstract_designer.hpp>
+#include <edsp/filter/internal/polynomial_roots.hpp>
+
+namespace edsp { namespace filter {
+
+    namespace bessel {
+
+        /**
+         * @brief Designs the analog Bessel prototype, whose poles are the roots of the reverse Bessel polynomial
+         *
+         * \f[
+         *  \theta_n(s) = \sum_{k=0}^{n} \frac{(2n-k)!}{2^{n-k} k! (n-k)!} s^k
+         * \f]
+         *
+         * The poles are scaled so the attenuation at the unit frequency is 3 dB, as in the other prototypes.
+         */
+        struct LowPassAnalogDesigner {
+            template <typename T, std::size_t MaxSize>
+            void design(LayoutBase<T, MaxSize>& analog, std::size_t num_poles) const {
+                meta::expects(num_poles > 0 && num_poles <= MaxSize, "Index out of bounds");
+
+                analog.setNormalW(0);
+                analog.setNormalGain(1);
+                analog.reset();
+
+                real_polynomial coefficients(num_poles + 1);
+                const auto n        = static_cast<long double>(num_poles);
+                coefficients.back() = 1;
+                for (auto k = num_poles; k > 0; --k) {
+                    const auto j        = static_cast<long double>(k - 1);
+                    coefficients[k - 1] = coefficients[k] * (2 * n - j) * (j + 1) / (2 * (n - j));
+                }
+                auto roots = polynomial_roots(coefficients);
+                insert_stable_poles(analog, roots, num_poles);
+
+                // The roots give a unit group delay at DC, rescale them to place the -3 dB point at the unit frequency
+                const auto cutoff = static_cast<long double>(analog_crossing(analog, constants<T>::one_div_root_two));
+                for (auto& root : roots) {
+                    root /= cutoff;
+                }
+                analog.reset();
+                insert_stable_poles(analog, roots, num_poles);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class LowPass : public AbstractDesigner<T, LowPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, LowPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                LowPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class HighPass : public AbstractDesigner<T, HighPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, HighPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                HighPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandPass : public AbstractDesigner<T, BandPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                BandPassTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandStopPass : public AbstractDesigner<T, BandStopPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandStopPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                BandStopTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+    } // namespace bessel
+
+    template <typename T, filter_type Type, std::size_t MaxOrder>
+    struct bessel_designer {};
+
+    template <typename T, std::size_t MaxOrder>
+    struct bessel_designer<T, filter_type::LowPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(bessel::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return bessel::LowPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct bessel_designer<T, filter_type::HighPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(bessel::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return bessel::HighPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct bessel_designer<T, filter_type::BandPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(bessel::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return bessel::BandPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct bessel_designer<T, filter_type::BandStop, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(bessel::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return bessel::BandStopPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+}} // namespace edsp::filter
+
+#endif // EDSP_BESSEL_DESIGNER_HPP
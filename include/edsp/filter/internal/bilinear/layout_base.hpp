@@ -22,6 +22,7 @@
 #ifndef EDSP_LAYOUT_BASE_HPP
 #define EDSP_LAYOUT_BASE_HPP
 
+#include <edsp/math/complex.hpp>
 #include <edsp/math/numeric.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/ensure.hpp>
@@ -43,8 +44,8 @@ namespace edsp { namespace filter {
     struct complex_pair : public std::pair<std::complex<T>, std::complex<T>> {
         using base = std::pair<std::complex<T>, std::complex<T>>;
         explicit constexpr complex_pair(const std::complex<T>& c1) : base(c1, std::complex<T>(0, 0)) {
-            meta::expects(c1.imag() == 0, "Expected a real number");
-            meta::ensure(this->isReal(), "Expected a real initialization");
+            // A zero at infinity is stored as math::infinity, whose imaginary part is not zero
+            meta::expects(c1.imag() == 0 || math::is_inf(c1), "Expected a real number");
         }
 
         constexpr complex_pair() : base(std::complex<T>(0, 0), std::complex<T>(0, 0)) {}
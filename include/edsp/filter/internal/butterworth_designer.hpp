@@ -26,6 +26,8 @@
 #include <edsp/meta/expects.hpp>
 #include <edsp/math/complex.hpp>
 #include <edsp/math/constant.hpp>
+#include <edsp/math/compile_time.hpp>
+#include <edsp/math/numeric.hpp>
 #include <edsp/filter/internal/bilinear/bandpass_transformer.hpp>
 #include <edsp/filter/internal/bilinear/bandstop_transformer.hpp>
 #include <edsp/filter/internal/bilinear/lowpass_transformer.hpp>
@@ -161,6 +163,42 @@ namespace edsp { namespace filter {
             }
         };
 
+        /**
+         * @brief Designs a low pass or high pass filter directly as a cascade of second order sections.
+         *
+         * Every pair of conjugated analog poles at \f$ \theta_k = \pi (2k + 1) / (2N) \f$ from the imaginary axis is
+         * a section with quality factor \f$ Q_k = 1 / (2 \sin(\theta_k)) \f$, discretized with the bilinear transform
+         * prewarped at the cutoff frequency. Odd orders add a first order section. Every section has unity gain in the
+         * passband, so no final scaling is needed and the design can be evaluated in constant expressions.
+         */
+        template <typename T, std::size_t MaxOrder>
+        constexpr biquad_cascade<T, (MaxOrder + 1) / 2> design_sections(std::size_t order, T sample_rate,
+                                                                         T cutoff_frequency, bool high_pass) {
+            meta::expects(order > 0 && order <= MaxOrder, "Index out of bounds");
+            biquad_cascade<T, (MaxOrder + 1) / 2> cascade;
+            const auto K  = compile_time::tan(constants<T>::pi * cutoff_frequency / sample_rate);
+            const auto K2 = K * K;
+            for (auto k = 0ul; k < order / 2; ++k) {
+                const auto Q    = 1 / (2 * compile_time::sin(constants<T>::pi * static_cast<T>(2 * k + 1) /
+                                                             static_cast<T>(2 * order)));
+                const auto norm = 1 / (1 + K / Q + K2);
+                const auto a1   = 2 * (K2 - 1) * norm;
+                const auto a2   = (1 - K / Q + K2) * norm;
+                const auto b0   = high_pass ? norm : K2 * norm;
+                const auto b1   = high_pass ? -2 * b0 : 2 * b0;
+                cascade.push_back(biquad<T>(1, a1, a2, b0, b1, b0));
+            }
+
+            if (math::is_odd(order)) {
+                const auto norm = 1 / (1 + K);
+                const auto a1   = (K - 1) * norm;
+                const auto b0   = high_pass ? norm : K * norm;
+                const auto b1   = high_pass ? -b0 : b0;
+                cascade.push_back(biquad<T>(1, a1, 0, b0, b1, 0));
+            }
+            return cascade;
+        }
+
     } // namespace butterworth
 
     template <typename T, filter_type Type, std::size_t MaxOrder>
@@ -168,19 +206,17 @@ namespace edsp { namespace filter {
 
     template <typename T, std::size_t MaxOrder>
     struct butterworth_designer<T, filter_type::LowPass, MaxOrder> {
-        template <typename... Arg>
-        constexpr auto operator()(Arg... arg)
-            -> decltype(butterworth::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
-            return butterworth::LowPass<T, MaxOrder>{}.design(arg...);
+        constexpr biquad_cascade<T, (MaxOrder + 1) / 2> operator()(std::size_t order, T sample_rate,
+                                                                   T cutoff_frequency) const {
+            return butterworth::design_sections<T, MaxOrder>(order, sample_rate, cutoff_frequency, false);
         }
     };
 
     template <typename T, std::size_t MaxOrder>
     struct butterworth_designer<T, filter_type::HighPass, MaxOrder> {
-        template <typename... Arg>
-        constexpr auto operator()(Arg... arg)
-            -> decltype(butterworth::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
-            return butterworth::HighPass<T, MaxOrder>{}.design(arg...);
+        constexpr biquad_cascade<T, (MaxOrder + 1) / 2> operator()(std::size_t order, T sample_rate,
+                                                                   T cutoff_frequency) const {
+            return butterworth::design_sections<T, MaxOrder>(order, sample_rate, cutoff_frequency, true);
         }
     };
 
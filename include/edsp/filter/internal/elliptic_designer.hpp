@@ -0,0 +1,266 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: elliptic_designer.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_ELLIPTIC_DESIGNER_HPP
+#define EDSP_ELLIPTIC_DESIGNER_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/filter/internal/bilinear/bandpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/bandstop_transformer.hpp>
+#include <edsp/filter/internal/bilinear/lowpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/highpass_transformer.hpp>
+#include <edsp/filter/internal/abstract_designer.hpp>
+#include <edsp/math/complex.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/math/numeric.hpp>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+namespace edsp { namespace filter {
+
+    namespace elliptic {
+
+        inline namespace internal {
+
+            /**
+             * @brief Descending Landen sequence of the elliptic modulus k, which converges to zero in a few steps.
+             */
+            template <typename T>
+            struct landen_sequence {
+                explicit landen_sequence(T k) {
+                    while (size < moduli.size() && k > std::numeric_limits<T>::epsilon()) {
+                        k              = math::square(k / (1 + std::sqrt(1 - k * k)));
+                        moduli[size++] = k;
+                    }
+                }
+
+                std::array<T, 16> moduli{};
+                std::size_t size{0};
+            };
+
+            template <typename T>
+            std::complex<T> ascending_landen(const landen_sequence<T>& landen, std::complex<T> w) {
+                for (auto n = landen.size; n > 0; --n) {
+                    const auto v = landen.moduli[n - 1];
+                    w            = (1 + v) * w / (T(1) + v * w * w);
+                }
+                return w;
+            }
+
+            template <typename T>
+            std::complex<T> descending_landen(const landen_sequence<T>& landen, T k, std::complex<T> w) {
+                for (std::size_t n = 0; n < landen.size; ++n) {
+                    const auto previous = (n == 0) ? k : landen.moduli[n - 1];
+                    w = w / (T(1) + std::sqrt(T(1) - w * w * previous * previous)) * T(2) / (1 + landen.moduli[n]);
+                }
+                return w;
+            }
+
+            /**
+             * @brief Jacobi elliptic function \f$ cd(uK, k) \f$, with u normalized to the quarter period K.
+             */
+            template <typename T>
+            std::complex<T> cde(const std::complex<T>& u, T k) {
+                // A copy, the complex operators take their arguments by reference
+                const T half_pi = constants<T>::half_pi;
+                return ascending_landen(landen_sequence<T>(k), std::cos(u * half_pi));
+            }
+
+            /**
+             * @brief Jacobi elliptic function \f$ sn(uK, k) \f$, with u normalized to the quarter period K.
+             */
+            template <typename T>
+            std::complex<T> sne(const std::complex<T>& u, T k) {
+                const T half_pi = constants<T>::half_pi;
+                return ascending_landen(landen_sequence<T>(k), std::sin(u * half_pi));
+            }
+
+            /**
+             * @brief Inverse of sne: returns u such that \f$ sn(uK, k) = w \f$.
+             */
+            template <typename T>
+            std::complex<T> asne(const std::complex<T>& w, T k) {
+                const T half_pi = constants<T>::half_pi;
+                return std::asin(descending_landen(landen_sequence<T>(k), k, w)) / half_pi;
+            }
+
+            /**
+             * @brief Complete elliptic integral of the first kind K(k), computed with the arithmetic-geometric mean.
+             */
+            template <typename T>
+            T complete_integral(T k) {
+                auto a = T(1), b = std::sqrt(1 - k * k);
+                while (std::fabs(a - b) > std::numeric_limits<T>::epsilon() * a) {
+                    const auto next = (a + b) / 2;
+                    b               = std::sqrt(a * b);
+                    a               = next;
+                }
+                return constants<T>::half_pi / a;
+            }
+
+            /**
+             * @brief Solves the degree equation: returns the selectivity modulus k of the elliptic filter of the given
+             * order whose discrimination modulus is k1.
+             */
+            template <typename T>
+            T selectivity_modulus(std::size_t order, T k1) {
+                const auto k1p = std::sqrt(1 - k1 * k1);
+                auto kp        = std::pow(k1p, static_cast<T>(order));
+                for (std::size_t i = 1, pairs = order / 2; i <= pairs; ++i) {
+                    const auto u = static_cast<T>(2 * i - 1) / static_cast<T>(order);
+                    kp *= math::square(math::square(sne(std::complex<T>(u, 0), k1p).real()));
+                }
+                return std::sqrt(1 - kp * kp);
+            }
+
+        } // namespace internal
+
+        /**
+         * @brief Designs the analog elliptic (Cauer) prototype, with equiripple passband up to the unit frequency and
+         * equiripple stopband.
+         *
+         * The transition band is the narrowest achievable for the given order, ripple and attenuation. The poles and
+         * zeros are computed with the Jacobi elliptic functions, evaluated with Landen transformations.
+         *
+         * @see Orfanidis, Lecture Notes on Elliptic Filter Design
+         */
+        struct LowPassAnalogDesigner {
+            template <typename T, std::size_t MaxSize>
+            void design(LayoutBase<T, MaxSize>& analog, std::size_t num_poles, T ripple_db, T stopband_db) const {
+                meta::expects(num_poles > 0 && num_poles <= MaxSize, "Index out of bounds");
+                meta::expects(ripple_db > 0 && stopband_db > ripple_db,
+                              "Expected a stopband attenuation larger than the ripple");
+                analog.reset();
+
+                const auto ep = std::sqrt(std::pow(T(10), ripple_db / 10) - 1);
+                const auto es = std::sqrt(std::pow(T(10), stopband_db / 10) - 1);
+                const auto k  = selectivity_modulus(num_poles, ep / es);
+                const auto N  = static_cast<T>(num_poles);
+                const auto j  = std::complex<T>(0, 1);
+                const auto v0 = (-j * asne(j / ep, ep / es)).real() / N;
+
+                for (std::size_t i = 1, pairs = num_poles / 2; i <= pairs; ++i) {
+                    const auto u    = static_cast<T>(2 * i - 1) / N;
+                    const auto zeta = cde(std::complex<T>(u, 0), k).real();
+                    const auto pole = j * cde(std::complex<T>(u, -v0), k);
+                    analog.insert_conjugate(pole, std::complex<T>(0, 1 / (k * zeta)));
+                }
+
+                analog.setNormalW(0);
+                if (math::is_odd(num_poles)) {
+                    const auto pole = (j * sne(j * v0, k)).real();
+                    analog.insert(std::complex<T>(pole, 0), math::infinity<T>());
+                    analog.setNormalGain(1);
+                } else {
+                    analog.setNormalGain(1 / std::sqrt(1 + ep * ep));
+                }
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class LowPass : public AbstractDesigner<T, LowPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, LowPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency, T ripple_db, T stopband_db) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order, ripple_db, stopband_db);
+                LowPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class HighPass : public AbstractDesigner<T, HighPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, HighPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency, T ripple_db, T stopband_db) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order, ripple_db, stopband_db);
+                HighPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandPass : public AbstractDesigner<T, BandPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency, T ripple_db,
+                            T stopband_db) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order, ripple_db, stopband_db);
+                BandPassTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandStopPass : public AbstractDesigner<T, BandStopPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandStopPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency, T ripple_db,
+                            T stopband_db) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order, ripple_db, stopband_db);
+                BandStopTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+    } // namespace elliptic
+
+    template <typename T, filter_type Type, std::size_t MaxOrder>
+    struct elliptic_designer {};
+
+    template <typename T, std::size_t MaxOrder>
+    struct elliptic_designer<T, filter_type::LowPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(elliptic::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return elliptic::LowPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct elliptic_designer<T, filter_type::HighPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(elliptic::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return elliptic::HighPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct elliptic_designer<T, filter_type::BandPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(elliptic::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return elliptic::BandPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct elliptic_designer<T, filter_type::BandStop, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(elliptic::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return elliptic::BandStopPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+}} // namespace edsp::filter
+
+#endif // EDSP_ELLIPTIC_DESIGNER_HPP
@@ -0,0 +1,127 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fft_convolver.hpp
+ * Date: 29/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FFT_CONVOLVER_HPP
+#define EDSP_FILTER_FFT_CONVOLVER_HPP
+
+#include <edsp/spectral/internal/fft_impl.hpp>
+#include <edsp/math/numeric.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @class fft_convolver
+         * @brief Overlap-save convolution of a real signal with a real kernel.
+         *
+         * Every complex transform filters two consecutive segments at once: the first one is stored in the real part
+         * and the second one in the imaginary part. As the kernel is real, the real and imaginary parts of the result
+         * are the convolutions of each segment.
+         *
+         * Only complex transforms are used, because every backend stores them in the same layout.
+         */
+        template <typename T>
+        class fft_convolver {
+        public:
+            using size_type    = std::size_t;
+            using value_type   = T;
+            using complex_type = std::complex<T>;
+
+            /**
+             * @brief Creates a convolver for the given kernel.
+             * @param kernel Pointer to the coefficients of the kernel.
+             * @param size Number of coefficients.
+             */
+            fft_convolver(const T* kernel, size_type size) :
+                taps_(size),
+                nfft_(std::max(size_type{64}, math::next_power_two(4 * size))),
+                segment_(nfft_ - size + 1),
+                fft_(static_cast<int>(nfft_)),
+                ifft_(static_cast<int>(nfft_)),
+                kernel_(nfft_),
+                spectrum_(nfft_),
+                time_(nfft_),
+                stream_(2 * segment_ + taps_ - 1) {
+                std::fill(std::begin(time_), std::end(time_), complex_type());
+                std::copy(kernel, kernel + size, std::begin(time_));
+                fft_.dft(time_.data(), kernel_.data());
+            }
+
+            /**
+             * @brief Filters the input samples.
+             * @param input Pointer to the input samples.
+             * @param output Pointer to the output samples.
+             * @param size Number of samples.
+             * @param history Pointer to the previous taps - 1 inputs, from the oldest to the newest. It is updated with
+             * the last inputs.
+             */
+            void process(const T* input, T* output, size_type size, T* history) {
+                const auto overlap = taps_ - 1;
+                for (size_type offset = 0; offset < size; offset += 2 * segment_) {
+                    const auto count = std::min(2 * segment_, size - offset);
+                    std::copy(history, history + overlap, std::begin(stream_));
+                    std::copy(input + offset, input + offset + count, std::begin(stream_) + overlap);
+                    std::fill(std::begin(stream_) + overlap + count, std::end(stream_), T());
+
+                    for (size_type i = 0; i < nfft_; ++i) {
+                        time_[i] = complex_type(stream_[i], stream_[segment_ + i]);
+                    }
+                    fft_.dft(time_.data(), spectrum_.data());
+                    for (size_type i = 0; i < nfft_; ++i) {
+                        spectrum_[i] *= kernel_[i];
+                    }
+                    ifft_.idft(spectrum_.data(), time_.data());
+                    ifft_.idft_scale(time_.data());
+
+                    const auto first = std::min(count, segment_);
+                    for (size_type i = 0; i < first; ++i) {
+                        output[offset + i] = time_[overlap + i].real();
+                    }
+                    for (size_type i = first; i < count; ++i) {
+                        output[offset + i] = time_[overlap + i - segment_].imag();
+                    }
+                    std::copy(std::begin(stream_) + count, std::begin(stream_) + count + overlap, history);
+                }
+            }
+
+        private:
+            size_type taps_;
+            size_type nfft_;
+            size_type segment_;
+            fft_impl<T> fft_;
+            fft_impl<T> ifft_;
+            std::vector<complex_type> kernel_;
+            std::vector<complex_type> spectrum_;
+            std::vector<complex_type> time_;
+            std::vector<T> stream_;
+        };
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FFT_CONVOLVER_HPP
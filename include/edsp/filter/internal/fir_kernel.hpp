@@ -0,0 +1,93 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fir_kernel.hpp
+ * Date: 29/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_FIR_KERNEL_HPP
+#define EDSP_FILTER_FIR_KERNEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @class mirrored_history
+         * @brief Delay line where the last N inputs are always stored contiguously, from the newest to the oldest.
+         *
+         * Every input is written twice, at the current position and N elements after it, so the window starting at
+         * the current position never wraps around the end of the buffer.
+         */
+        template <typename T, typename Allocator = std::allocator<T>>
+        class mirrored_history {
+        public:
+            using size_type  = std::size_t;
+            using value_type = T;
+
+            explicit mirrored_history(size_type N = 0) : buffer_(2 * N, T()), size_(N) {}
+
+            size_type size() const noexcept {
+                return size_;
+            }
+
+            void reset() {
+                std::fill(std::begin(buffer_), std::end(buffer_), T());
+                position_ = 0;
+            }
+
+            void fill(value_type value) {
+                std::fill(std::begin(buffer_), std::end(buffer_), value);
+            }
+
+            void push(value_type tick) noexcept {
+                position_                  = (position_ == 0) ? size_ - 1 : position_ - 1;
+                buffer_[position_]         = tick;
+                buffer_[position_ + size_] = tick;
+            }
+
+            /**
+             * @brief Copies the newest count inputs, from the oldest to the newest, to the range beginning at d_first.
+             */
+            void recent(value_type* d_first, size_type count) const noexcept {
+                std::reverse_copy(data(), data() + count, d_first);
+            }
+
+            /**
+             * @brief Returns a pointer to the newest input, followed by the previous N - 1 inputs.
+             */
+            const value_type* data() const noexcept {
+                return buffer_.data() + position_;
+            }
+
+        private:
+            std::vector<T, Allocator> buffer_;
+            size_type size_{0};
+            size_type position_{0};
+        };
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FIR_KERNEL_HPP
@@ -0,0 +1,175 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: halfband_decimator.hpp
+ * Date: 01/11/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_HALFBAND_DECIMATOR_HPP
+#define EDSP_FILTER_HALFBAND_DECIMATOR_HPP
+
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @class halfband_decimator
+         * @brief Low pass filter with cutoff at a quarter of the sampling rate followed by a downsampler by 2.
+         *
+         * The filter is a windowed sinc of length 4k + 3 with a Blackman window. Apart from the central coefficient,
+         * which is 1/2, one of every two coefficients of a halfband filter is zero, so every output only needs the
+         * nonzero coefficients applied to the inputs with the same parity as the output, plus the central one: about a
+         * quarter of the multiplications of a direct implementation per input.
+         *
+         * Every block is appended to the last inputs of the previous one, so the outputs are computed from a linear
+         * buffer, without a delay line updated per input.
+         *
+         * @tparam T  Type of element.
+         * @tparam Allocator  Allocator type.
+         */
+        template <typename T, typename Allocator = std::allocator<T>>
+        class halfband_decimator {
+        public:
+            using size_type  = std::size_t;
+            using value_type = T;
+
+            /**
+             * @brief Returns the shortest length of a filter whose transition band, centered at a quarter of the
+             * sampling rate, has the given width in cycles per sample.
+             */
+            static size_type length_for(T transition);
+
+            explicit halfband_decimator(size_type length);
+
+            size_type size() const noexcept;
+            void reset();
+
+            /**
+             * @brief Decimates the elements in the range [first, last) and stores the result in another range,
+             * beginning at d_first.
+             *
+             * The phase is kept between calls, so odd blocks produce a different number of outputs every other call.
+             *
+             * @return Output iterator to the element past the last element written.
+             */
+            template <typename InputIt, typename OutputIt>
+            OutputIt filter(InputIt first, InputIt last, OutputIt d_first);
+
+        private:
+            std::vector<T, Allocator> coefficients_;
+            std::vector<T, Allocator> buffer_;
+            size_type size_;
+            size_type phase_{0};
+        };
+
+        template <typename T, typename Allocator>
+        typename halfband_decimator<T, Allocator>::size_type
+            halfband_decimator<T, Allocator>::length_for(T transition) {
+            meta::expects(transition > 0 && transition < 0.5, "Expected a transition width below 0.5");
+            // The main lobe of the Blackman window spans 6 / N cycles per sample
+            const auto minimum = static_cast<size_type>(std::ceil(6 / transition));
+            return minimum + (4 - (minimum + 1) % 4) % 4;
+        }
+
+        template <typename T, typename Allocator>
+        halfband_decimator<T, Allocator>::halfband_decimator(size_type length) :
+            coefficients_((length + 1) / 2),
+            buffer_(length - 1, T()),
+            size_(length) {
+            meta::expects(length % 4 == 3, "Expected a length of the form 4k + 3");
+
+            // Nonzero coefficients h(2i), at odd distances of the center c = (length - 1) / 2, stored from the last one
+            // so they are applied to the inputs from the oldest one
+            const auto center = static_cast<T>(length - 1) / 2;
+            const auto factor = constants<T>::two_pi / static_cast<T>(length + 1);
+            for (size_type i = 0; i < coefficients_.size(); ++i) {
+                const auto n      = static_cast<T>(2 * i);
+                const auto t      = n - center;
+                const auto window =
+                    T(0.42) - T(0.5) * std::cos(factor * (n + 1)) + T(0.08) * std::cos(2 * factor * (n + 1));
+                coefficients_[coefficients_.size() - 1 - i] =
+                    std::sin(constants<T>::half_pi * t) / (constants<T>::pi * t) * window;
+            }
+
+            // Unit gain at DC, together with the central coefficient
+            const auto sum = std::accumulate(std::begin(coefficients_), std::end(coefficients_), T(0));
+            for (auto& coefficient : coefficients_) {
+                coefficient *= T(0.5) / sum;
+            }
+        }
+
+        template <typename T, typename Allocator>
+        typename halfband_decimator<T, Allocator>::size_type halfband_decimator<T, Allocator>::size() const noexcept {
+            return size_;
+        }
+
+        template <typename T, typename Allocator>
+        void halfband_decimator<T, Allocator>::reset() {
+            buffer_.assign(size_ - 1, T());
+            phase_ = 0;
+        }
+
+        template <typename T, typename Allocator>
+        template <typename InputIt, typename OutputIt>
+        OutputIt halfband_decimator<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+            const auto history = size_ - 1;
+            buffer_.insert(std::end(buffer_), first, last);
+
+            // The output at the position n of the buffer is computed from the inputs in [n - history, n]
+            const auto count  = coefficients_.size();
+            const auto center = history / 2;
+            const auto total  = buffer_.size();
+            const auto x      = buffer_.data();
+            const auto h      = coefficients_.data();
+            auto n            = history + phase_;
+            for (; n < total; n += 2) {
+                const auto oldest = x + n - history;
+                T accumulator[4]  = {T(0.5) * oldest[center], T(0), T(0), T(0)};
+                size_type i       = 0;
+                for (; i + 4 <= count; i += 4) {
+                    accumulator[0] += h[i] * oldest[2 * i];
+                    accumulator[1] += h[i + 1] * oldest[2 * i + 2];
+                    accumulator[2] += h[i + 2] * oldest[2 * i + 4];
+                    accumulator[3] += h[i + 3] * oldest[2 * i + 6];
+                }
+                for (; i < count; ++i) {
+                    accumulator[0] += h[i] * oldest[2 * i];
+                }
+                *d_first = (accumulator[0] + accumulator[1]) + (accumulator[2] + accumulator[3]);
+                ++d_first;
+            }
+
+            phase_ = n - total;
+            buffer_.erase(std::begin(buffer_), std::begin(buffer_) + static_cast<std::ptrdiff_t>(total - history));
+            return d_first;
+        }
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_HALFBAND_DECIMATOR_HPP
@@ -0,0 +1,231 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: legendre_designer.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_LEGENDRE_DESIGNER_HPP
+#define EDSP_LEGENDRE_DESIGNER_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/filter/internal/bilinear/bandpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/bandstop_transformer.hpp>
+#include <edsp/filter/internal/bilinear/lowpass_transformer.hpp>
+#include <edsp/filter/internal/bilinear/highpass_transformer.hpp>
+#include <edsp/filter/internal/abstract_designer.hpp>
+#include <edsp/filter/internal/polynomial_roots.hpp>
+#include <edsp/math/numeric.hpp>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    namespace legendre {
+
+        inline namespace internal {
+
+            inline real_polynomial multiply(const real_polynomial& left, const real_polynomial& right) {
+                real_polynomial result(left.size() + right.size() - 1, 0);
+                for (std::size_t i = 0; i < left.size(); ++i) {
+                    for (std::size_t j = 0; j < right.size(); ++j) {
+                        result[i + j] += left[i] * right[j];
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Computes the polynomial \f$ L_n(u) \f$, with \f$ u = \omega^2 \f$, whose magnitude response
+             * \f$ |H(j\omega)|^2 = 1 / (1 + L_n(\omega^2)) \f$ has the steepest roll-off at the cutoff among the
+             * monotonic responses.
+             *
+             * \f$ L_n \f$ is the integral from -1 to \f$ 2u - 1 \f$ of the square of a weighted sum of Legendre
+             * polynomials (multiplied by \f$ x + 1 \f$ for even orders), with the weights chosen so that
+             * \f$ L_n(1) = 1 \f$.
+             */
+            inline real_polynomial optimum_l_polynomial(std::size_t order) {
+                const auto even = math::is_even(order);
+                const auto k    = even ? (order - 2) / 2 : (order - 1) / 2;
+
+                // Legendre polynomials P_0 ... P_k
+                std::vector<real_polynomial> legendre{real_polynomial{1}, real_polynomial{0, 1}};
+                for (std::size_t m = 1; m < k; ++m) {
+                    const auto& previous = legendre[m - 1];
+                    const auto& current  = legendre[m];
+                    real_polynomial next(m + 2, 0);
+                    for (std::size_t i = 0; i < current.size(); ++i) {
+                        next[i + 1] += (2 * m + 1) * current[i] / static_cast<long double>(m + 1);
+                    }
+                    for (std::size_t i = 0; i < previous.size(); ++i) {
+                        next[i] -= m * previous[i] / static_cast<long double>(m + 1);
+                    }
+                    legendre.push_back(next);
+                }
+
+                real_polynomial sum(k + 1, 0);
+                for (std::size_t i = 0; i <= k; ++i) {
+                    if (even && math::is_odd(i + k)) {
+                        continue;
+                    }
+                    const auto weight = even ? (2 * i + 1) / std::sqrt(static_cast<long double>((k + 1) * (k + 2)))
+                                             : (2 * i + 1) / (constants<long double>::root_two * (k + 1));
+                    for (std::size_t j = 0; j < legendre[i].size(); ++j) {
+                        sum[j] += weight * legendre[i][j];
+                    }
+                }
+
+                auto integrand = multiply(sum, sum);
+                if (even) {
+                    integrand = multiply(integrand, real_polynomial{1, 1});
+                }
+
+                // Antiderivative vanishing at -1
+                real_polynomial integral(integrand.size() + 1, 0);
+                for (std::size_t i = 0; i < integrand.size(); ++i) {
+                    integral[i + 1] = integrand[i] / static_cast<long double>(i + 1);
+                }
+                for (std::size_t i = 1; i < integral.size(); ++i) {
+                    integral[0] -= integral[i] * (math::is_odd(i) ? -1 : 1);
+                }
+
+                // Substitution x = 2u - 1 with the Horner scheme
+                real_polynomial result{integral.back()};
+                for (auto i = integral.size() - 1; i > 0; --i) {
+                    result    = multiply(result, real_polynomial{-1, 2});
+                    result[0] += integral[i - 1];
+                }
+                return result;
+            }
+
+        } // namespace internal
+
+        /**
+         * @brief Designs the analog Legendre (Optimum L) prototype, whose poles are the roots in the left half plane of
+         * \f$ 1 + L_n(-s^2) \f$.
+         *
+         * The response is monotonic as in the Butterworth filters, but with a steeper roll-off. The attenuation at the
+         * unit frequency is 3 dB.
+         */
+        struct LowPassAnalogDesigner {
+            template <typename T, std::size_t MaxSize>
+            void design(LayoutBase<T, MaxSize>& analog, std::size_t num_poles) const {
+                meta::expects(num_poles > 0 && num_poles <= MaxSize, "Index out of bounds");
+
+                analog.setNormalW(0);
+                analog.setNormalGain(1);
+                analog.reset();
+
+                if (num_poles == 1) {
+                    analog.insert(std::complex<T>(-1, 0), math::infinity<T>());
+                    return;
+                }
+
+                const auto l = optimum_l_polynomial(num_poles);
+                real_polynomial denominator(2 * l.size() - 1, 0);
+                for (std::size_t i = 0; i < l.size(); ++i) {
+                    denominator[2 * i] = math::is_odd(i) ? -l[i] : l[i];
+                }
+                denominator[0] += 1;
+                insert_stable_poles(analog, polynomial_roots(denominator), num_poles);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class LowPass : public AbstractDesigner<T, LowPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, LowPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                LowPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class HighPass : public AbstractDesigner<T, HighPass<T, MaxSize>, MaxSize> {
+            friend struct AbstractDesigner<T, HighPass, MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T cuttoff_frequency) {
+                const auto normalized_frequency = cuttoff_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                HighPassTransformer<T>{normalized_frequency}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandPass : public AbstractDesigner<T, BandPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                BandPassTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+
+        template <typename T, std::size_t MaxSize>
+        class BandStopPass : public AbstractDesigner<T, BandStopPass<T, MaxSize>, MaxSize, 2 * MaxSize> {
+            friend struct AbstractDesigner<T, BandStopPass, MaxSize, 2 * MaxSize>;
+            void operator()(std::size_t order, T sample_rate, T center_frequency, T bandwidth_frequency) {
+                const auto normalized_center    = center_frequency / sample_rate;
+                const auto normalized_bandwidth = bandwidth_frequency / sample_rate;
+                LowPassAnalogDesigner{}.design(this->analog_, order);
+                BandStopTransformer<T>{normalized_center, normalized_bandwidth}(this->analog_, this->digital_);
+            }
+        };
+    } // namespace legendre
+
+    template <typename T, filter_type Type, std::size_t MaxOrder>
+    struct legendre_designer {};
+
+    template <typename T, std::size_t MaxOrder>
+    struct legendre_designer<T, filter_type::LowPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(legendre::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return legendre::LowPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct legendre_designer<T, filter_type::HighPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(legendre::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return legendre::HighPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct legendre_designer<T, filter_type::BandPass, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(legendre::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return legendre::BandPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    struct legendre_designer<T, filter_type::BandStop, MaxOrder> {
+        template <typename... Arg>
+        constexpr auto operator()(Arg... arg)
+            -> decltype(legendre::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
+            return legendre::BandStopPass<T, MaxOrder>{}.design(arg...);
+        }
+    };
+
+}} // namespace edsp::filter
+
+#endif // EDSP_LEGENDRE_DESIGNER_HPP
@@ -0,0 +1,195 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: moving_sum.hpp
+ * Date: 01/11/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_MOVING_SUM_HPP
+#define EDSP_FILTER_MOVING_SUM_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @class moving_sum
+         * @brief Running sums of the last N frames of several interleaved channels.
+         *
+         * The window of every channel is stored in a circular buffer of frames, so the values leaving the window are
+         * contiguous and in the same order as the incoming ones until the buffer wraps around. Blocks are processed in
+         * runs that do not wrap: first the differences between the incoming and the leaving values are computed in a
+         * single loop, and then they are accumulated frame by frame. The inner loops run over the channels, so the
+         * compiler can process several channels per instruction.
+         *
+         * Updating a floating point sum with differences accumulates rounding errors, so the sums are recomputed from
+         * the window at least every refresh_interval frames.
+         *
+         * @tparam T  Type of element.
+         * @tparam Allocator  Allocator type.
+         */
+        template <typename T, typename Allocator>
+        class moving_sum {
+        public:
+            using size_type  = std::size_t;
+            using value_type = T;
+
+            /**
+             * @brief Minimum number of frames between two exact computations of the sums.
+             */
+            static constexpr size_type refresh_interval = 16384;
+
+            moving_sum(size_type N, size_type channels);
+
+            size_type size() const noexcept;
+            size_type channels() const noexcept;
+            void resize(size_type N);
+            void reset();
+
+            /**
+             * @brief Pushes the interleaved elements in the range [first, last) and stores unmap(sum / count) in
+             * another range, beginning at d_first, where count is the number of frames in the window.
+             *
+             * @param map Function applied to every element before being added to the window.
+             * @param unmap Function applied to the mean of every window.
+             */
+            template <typename InputIt, typename OutputIt, typename Map, typename Unmap>
+            void process(InputIt first, InputIt last, OutputIt d_first, Map map, Unmap unmap);
+
+        private:
+            void refresh() noexcept;
+
+            std::vector<T, Allocator> window_;
+            std::vector<T, Allocator> sums_;
+            std::vector<T, Allocator> run_{};
+            size_type size_;
+            size_type position_{0};
+            size_type filled_{0};
+            size_type since_refresh_{0};
+        };
+
+        template <typename T, typename Allocator>
+        constexpr typename moving_sum<T, Allocator>::size_type moving_sum<T, Allocator>::refresh_interval;
+
+        template <typename T, typename Allocator>
+        moving_sum<T, Allocator>::moving_sum(size_type N, size_type channels) :
+            window_(N * channels, T()),
+            sums_(channels, T()),
+            size_(N) {
+            meta::expects(N > 0, "Expected a non empty window");
+            meta::expects(channels > 0, "Expected at least one channel");
+        }
+
+        template <typename T, typename Allocator>
+        typename moving_sum<T, Allocator>::size_type moving_sum<T, Allocator>::size() const noexcept {
+            return size_;
+        }
+
+        template <typename T, typename Allocator>
+        typename moving_sum<T, Allocator>::size_type moving_sum<T, Allocator>::channels() const noexcept {
+            return sums_.size();
+        }
+
+        template <typename T, typename Allocator>
+        void moving_sum<T, Allocator>::resize(size_type N) {
+            meta::expects(N > 0, "Expected a non empty window");
+            size_ = N;
+            window_.assign(N * channels(), T());
+            reset();
+        }
+
+        template <typename T, typename Allocator>
+        void moving_sum<T, Allocator>::reset() {
+            std::fill(std::begin(window_), std::end(window_), T());
+            std::fill(std::begin(sums_), std::end(sums_), T());
+            position_      = 0;
+            filled_        = 0;
+            since_refresh_ = 0;
+        }
+
+        template <typename T, typename Allocator>
+        void moving_sum<T, Allocator>::refresh() noexcept {
+            const auto channels = sums_.size();
+            const auto sums     = sums_.data();
+            std::fill(sums, sums + channels, T());
+            for (size_type i = 0; i < size_; ++i) {
+                const auto frame = window_.data() + i * channels;
+                for (size_type channel = 0; channel < channels; ++channel) {
+                    sums[channel] += frame[channel];
+                }
+            }
+            since_refresh_ = 0;
+        }
+
+        template <typename T, typename Allocator>
+        template <typename InputIt, typename OutputIt, typename Map, typename Unmap>
+        void moving_sum<T, Allocator>::process(InputIt first, InputIt last, OutputIt d_first, Map map, Unmap unmap) {
+            const auto channels = sums_.size();
+            const auto samples  = static_cast<size_type>(std::distance(first, last));
+            meta::expects(samples % channels == 0, "Expected an integer number of frames");
+
+            const auto sums = sums_.data();
+            for (auto frames = samples / channels; frames > 0;) {
+                const auto length = std::min(frames, size_ - position_);
+                const auto count  = length * channels;
+                run_.resize(count);
+
+                // Differences between the incoming values and the ones they replace in the window
+                const auto run     = run_.data();
+                const auto leaving = window_.data() + position_ * channels;
+                for (size_type i = 0; i < count; ++i, ++first) {
+                    const auto value = static_cast<T>(map(*first));
+                    run[i]           = value - leaving[i];
+                    leaving[i]       = value;
+                }
+
+                for (size_type i = 0; i < length; ++i) {
+                    filled_          = std::min(filled_ + 1, size_);
+                    const auto scale = T(1) / static_cast<T>(filled_);
+                    const auto frame = run + i * channels;
+                    for (size_type channel = 0; channel < channels; ++channel) {
+                        sums[channel] += frame[channel];
+                        frame[channel] = unmap(sums[channel] * scale);
+                    }
+                }
+                d_first = std::copy(run, run + count, d_first);
+
+                frames -= length;
+                position_ += length;
+                since_refresh_ += length;
+                if (position_ == size_) {
+                    position_ = 0;
+                    if (since_refresh_ >= refresh_interval) {
+                        refresh();
+                    }
+                }
+            }
+        }
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MOVING_SUM_HPP
@@ -0,0 +1,151 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: order_estimator.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_ORDER_ESTIMATOR_HPP
+#define EDSP_FILTER_ORDER_ESTIMATOR_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/internal/elliptic_designer.hpp>
+#include <edsp/filter/internal/polynomial_roots.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @brief Largest order considered by the numerical order estimation.
+         */
+        constexpr std::size_t max_estimated_order = 20;
+
+        /**
+         * @brief Discrimination of a specification, the ratio between the stopband and passband deviations.
+         */
+        template <typename T>
+        struct order_specification {
+            T selectivity; /*!< Ratio between the stopband and the passband edges of the analog low pass prototype */
+            T ep;          /*!< Passband deviation, \f$ \sqrt{10^{A_p/10} - 1} \f$ */
+            T es;          /*!< Stopband deviation, \f$ \sqrt{10^{A_s/10} - 1} \f$ */
+        };
+
+        template <typename T>
+        T prewarp(T frequency, T sample_rate) {
+            return std::tan(constants<T>::pi * frequency / sample_rate);
+        }
+
+        template <typename T>
+        order_specification<T> make_specification(T selectivity, T ripple_db, T stopband_db) {
+            meta::expects(selectivity > 1, "Expected a stopband edge beyond the passband edge");
+            meta::expects(ripple_db > 0 && stopband_db > ripple_db,
+                          "Expected a stopband attenuation larger than the ripple");
+            return {selectivity, std::sqrt(std::pow(T(10), ripple_db / 10) - 1),
+                    std::sqrt(std::pow(T(10), stopband_db / 10) - 1)};
+        }
+
+        /**
+         * @brief Maps the edges of a low pass or high pass digital filter to the analog low pass prototype.
+         */
+        template <typename T>
+        order_specification<T> make_specification(filter_type type, T sample_rate, T passband_edge, T stopband_edge,
+                                                  T ripple_db, T stopband_db) {
+            meta::expects(type == filter_type::LowPass || type == filter_type::HighPass,
+                          "Expected a low pass or high pass specification");
+            const auto wp = prewarp(passband_edge, sample_rate);
+            const auto ws = prewarp(stopband_edge, sample_rate);
+            return make_specification(type == filter_type::LowPass ? ws / wp : wp / ws, ripple_db, stopband_db);
+        }
+
+        /**
+         * @brief Maps the edges of a band pass or band stop digital filter to the analog low pass prototype, keeping
+         * the most restrictive of both stopband edges.
+         */
+        template <typename T>
+        order_specification<T> make_specification(filter_type type, T sample_rate, T passband_low, T passband_high,
+                                                  T stopband_low, T stopband_high, T ripple_db, T stopband_db) {
+            meta::expects(type == filter_type::BandPass || type == filter_type::BandStop,
+                          "Expected a band pass or band stop specification");
+            const auto wp1 = prewarp(passband_low, sample_rate);
+            const auto wp2 = prewarp(passband_high, sample_rate);
+            const auto ws1 = prewarp(stopband_low, sample_rate);
+            const auto ws2 = prewarp(stopband_high, sample_rate);
+            const auto w0  = wp1 * wp2;
+            const auto bw  = wp2 - wp1;
+
+            const auto selectivity = [&](T ws) {
+                const auto ratio = std::fabs(ws * ws - w0) / (bw * ws);
+                return type == filter_type::BandPass ? ratio : 1 / ratio;
+            };
+            return make_specification(std::min(selectivity(ws1), selectivity(ws2)), ripple_db, stopband_db);
+        }
+
+        template <typename T>
+        std::size_t round_order(T order) {
+            // Tolerates the rounding errors of a specification met exactly by an integer order
+            return static_cast<std::size_t>(std::max(T(1), std::ceil(order - 1e-9)));
+        }
+
+        template <typename T>
+        std::size_t butterworth_order(const order_specification<T>& spec) {
+            return round_order(std::log(spec.es / spec.ep) / std::log(spec.selectivity));
+        }
+
+        template <typename T>
+        std::size_t chebyshev_order(const order_specification<T>& spec) {
+            return round_order(std::acosh(spec.es / spec.ep) / std::acosh(spec.selectivity));
+        }
+
+        template <typename T>
+        std::size_t elliptic_order(const order_specification<T>& spec) {
+            const auto k  = 1 / spec.selectivity;
+            const auto k1 = spec.ep / spec.es;
+            const auto kp = std::sqrt(1 - k * k), k1p = std::sqrt(1 - k1 * k1);
+            return round_order(elliptic::complete_integral(k) * elliptic::complete_integral(k1p) /
+                               (elliptic::complete_integral(kp) * elliptic::complete_integral(k1)));
+        }
+
+        /**
+         * @brief Finds the minimum order of a prototype with a monotonic response by designing it for increasing
+         * orders, and measuring the ratio between the frequencies at which it reaches both attenuations.
+         */
+        template <typename AnalogDesigner, typename T>
+        std::size_t monotonic_order(const order_specification<T>& spec) {
+            LayoutBase<T, max_estimated_order> analog;
+            for (std::size_t order = 1; order <= max_estimated_order; ++order) {
+                AnalogDesigner{}.design(analog, order);
+                const auto wp = analog_crossing(analog, 1 / std::sqrt(1 + spec.ep * spec.ep));
+                const auto ws = analog_crossing(analog, 1 / std::sqrt(1 + spec.es * spec.es));
+                if (ws <= wp * spec.selectivity) {
+                    return order;
+                }
+            }
+            meta::expects(false, "The specification can not be met by a supported order");
+            return max_estimated_order;
+        }
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_ORDER_ESTIMATOR_HPP
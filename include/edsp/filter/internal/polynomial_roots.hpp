@@ -0,0 +1,198 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: polynomial_roots.hpp
+ * Date: 01/11/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_POLYNOMIAL_ROOTS_HPP
+#define EDSP_FILTER_POLYNOMIAL_ROOTS_HPP
+
+#include <edsp/filter/internal/bilinear/layout_base.hpp>
+#include <edsp/math/complex.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/math/numeric.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        using real_polynomial = std::vector<long double>;
+
+        /**
+         * @brief Evaluates the polynomial \f$ \sum_k c_k z^k \f$ and its derivative.
+         */
+        inline void evaluate_polynomial(const real_polynomial& coefficients, const std::complex<long double>& z,
+                                        std::complex<long double>& value, std::complex<long double>& derivative) {
+            value      = 0;
+            derivative = 0;
+            for (auto k = coefficients.size(); k > 0; --k) {
+                derivative = derivative * z + value;
+                value      = value * z + coefficients[k - 1];
+            }
+        }
+
+        /**
+         * @brief Computes the roots of the polynomial \f$ \sum_k c_k z^k \f$ with the Aberth-Ehrlich method.
+         *
+         * All the roots are refined simultaneously, every one of them repelled by the others, which converges cubically
+         * to simple roots from any initial guess on a circle. The degree of the polynomials used by the analog
+         * prototypes is low enough for the computation in long double to be accurate.
+         */
+        inline std::vector<std::complex<long double>> polynomial_roots(real_polynomial coefficients) {
+            while (!coefficients.empty() && coefficients.back() == 0) {
+                coefficients.pop_back();
+            }
+            meta::expects(coefficients.size() > 1, "Expected a non constant polynomial");
+
+            const auto degree = coefficients.size() - 1;
+            const auto lead   = coefficients.back();
+            for (auto& coefficient : coefficients) {
+                coefficient /= lead;
+            }
+
+            // Initial guesses on a circle whose radius bounds the roots, rotated to avoid symmetric configurations
+            const auto n = static_cast<long double>(degree);
+            auto radius  = 0.0L;
+            for (std::size_t k = 0; k < degree; ++k) {
+                radius = std::max(radius, std::pow(std::fabs(coefficients[k]), 1 / (n - k)));
+            }
+            std::vector<std::complex<long double>> roots(degree);
+            for (std::size_t k = 0; k < degree; ++k) {
+                roots[k] = std::polar(radius, (2 * constants<long double>::pi * k + 0.4L) / n);
+            }
+
+            for (auto iteration = 0; iteration < 500; ++iteration) {
+                auto largest_step = 0.0L;
+                for (std::size_t i = 0; i < degree; ++i) {
+                    std::complex<long double> value, derivative;
+                    evaluate_polynomial(coefficients, roots[i], value, derivative);
+                    if (value == std::complex<long double>(0, 0)) {
+                        continue;
+                    }
+
+                    const auto ratio = value / derivative;
+                    auto repulsion   = std::complex<long double>(0, 0);
+                    for (std::size_t j = 0; j < degree; ++j) {
+                        if (j != i) {
+                            repulsion += 1.0L / (roots[i] - roots[j]);
+                        }
+                    }
+                    const auto step = ratio / (1.0L - ratio * repulsion);
+                    roots[i] -= step;
+                    largest_step = std::max(largest_step, std::abs(step) / std::max(std::abs(roots[i]), 1.0L));
+                }
+                if (largest_step < 1e-18L) {
+                    break;
+                }
+            }
+            return roots;
+        }
+
+        /**
+         * @brief Inserts in the layout the poles in the left half plane, with their zeros at infinity.
+         *
+         * The conjugated poles are inserted in pairs and the real pole, if any, at the end.
+         */
+        template <typename T, std::size_t MaxSize>
+        void insert_stable_poles(LayoutBase<T, MaxSize>& analog, const std::vector<std::complex<long double>>& roots,
+                                 std::size_t num_poles) {
+            std::vector<std::complex<long double>> upper;
+            auto real     = 0.0L;
+            auto has_real = false;
+            for (const auto& root : roots) {
+                if (root.real() >= 0) {
+                    continue;
+                }
+                if (std::fabs(root.imag()) <= 1e-12L * std::abs(root)) {
+                    real     = root.real();
+                    has_real = true;
+                } else if (root.imag() > 0) {
+                    upper.push_back(root);
+                }
+            }
+            meta::ensure(2 * upper.size() + (has_real ? 1 : 0) == num_poles, "Unexpected number of stable poles");
+
+            // Ordered by the distance to the imaginary axis, as in the other prototypes
+            std::sort(std::begin(upper), std::end(upper),
+                      [](const std::complex<long double>& left, const std::complex<long double>& right) {
+                          return left.real() / std::abs(left) > right.real() / std::abs(right);
+                      });
+            for (const auto& pole : upper) {
+                analog.insert_conjugate(std::complex<T>(static_cast<T>(pole.real()), static_cast<T>(pole.imag())),
+                                        math::infinity<T>());
+            }
+            if (has_real) {
+                analog.insert(std::complex<T>(static_cast<T>(real), 0), math::infinity<T>());
+            }
+        }
+
+        /**
+         * @brief Computes the magnitude response of an analog layout at the angular frequency w.
+         */
+        template <typename T, std::size_t MaxSize>
+        T analog_magnitude(const LayoutBase<T, MaxSize>& analog, T w) {
+            const auto s      = std::complex<T>(0, w);
+            auto response     = std::complex<T>(1, 0);
+            const auto factor = [&s](const std::complex<T>& pole, const std::complex<T>& zero) {
+                const auto numerator = math::is_inf(zero) ? std::complex<T>(1, 0) : (s - zero) / (-zero);
+                return numerator * (-pole) / (s - pole);
+            };
+
+            const auto num_poles = analog.numberPoles();
+            for (std::size_t i = 0; i < num_poles / 2; ++i) {
+                const auto& pair = analog[i];
+                response *= factor(pair.poles().first, pair.zeros().first);
+                response *= factor(pair.poles().second, pair.zeros().second);
+            }
+            if (math::is_odd(num_poles)) {
+                const auto& pair = analog[num_poles / 2];
+                response *= factor(pair.poles().first, pair.zeros().first);
+            }
+            return std::abs(response);
+        }
+
+        /**
+         * @brief Finds the angular frequency at which a monotonically decreasing analog response reaches the given
+         * magnitude.
+         */
+        template <typename T, std::size_t MaxSize>
+        T analog_crossing(const LayoutBase<T, MaxSize>& analog, T magnitude) {
+            auto low = T(0), high = T(1);
+            while (analog_magnitude(analog, high) > magnitude) {
+                low = high;
+                high *= 2;
+            }
+            for (auto i = 0; i < 100; ++i) {
+                const auto middle = (low + high) / 2;
+                (analog_magnitude(analog, middle) > magnitude ? low : high) = middle;
+            }
+            return (low + high) / 2;
+        }
+
+    } // namespace internal
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_POLYNOMIAL_ROOTS_HPP
@@ -26,7 +26,7 @@
 #include <edsp/meta/unused.hpp>
 #include <edsp/filter/biquad.hpp>
 #include <edsp/math/constant.hpp>
-#include <cmath>
+#include <edsp/math/compile_time.hpp>
 
 namespace edsp { namespace filter {
     template <typename T, filter_type Type>
@@ -37,18 +37,17 @@ namespace edsp { namespace filter {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
             const auto alpha   = omega_s / (2 * Q);
 
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>(1 + alpha);
-            a[1] = static_cast<T>(-2 * omega_c);
-            a[2] = static_cast<T>(1 - alpha);
-            b[0] = static_cast<T>((1 - omega_c) / 2);
-            b[1] = static_cast<T>(1 - omega_c);
-            b[2] = b[0];
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const T a0 = static_cast<T>(1 + alpha);
+            const T a1 = static_cast<T>(-2 * omega_c);
+            const T a2 = static_cast<T>(1 - alpha);
+            const T b0 = static_cast<T>((1 - omega_c) / 2);
+            const T b1 = static_cast<T>(1 - omega_c);
+            const T b2 = b0;
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
@@ -57,18 +56,17 @@ namespace edsp { namespace filter {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
             const auto alpha   = omega_s / (2 * Q);
 
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>(1 + alpha);
-            a[1] = static_cast<T>(-2 * omega_c);
-            a[2] = static_cast<T>(1 - alpha);
-            b[0] = static_cast<T>((1 + omega_c) / 2);
-            b[1] = static_cast<T>(-(1 + omega_c));
-            b[2] = b[0];
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const T a0 = static_cast<T>(1 + alpha);
+            const T a1 = static_cast<T>(-2 * omega_c);
+            const T a2 = static_cast<T>(1 - alpha);
+            const T b0 = static_cast<T>((1 + omega_c) / 2);
+            const T b1 = static_cast<T>(-(1 + omega_c));
+            const T b2 = b0;
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
@@ -77,18 +75,17 @@ namespace edsp { namespace filter {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
             const auto alpha   = omega_s / (2 * Q);
 
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>(1 + alpha);
-            a[1] = static_cast<T>(-2 * omega_c);
-            a[2] = static_cast<T>(1 - alpha);
-            b[0] = static_cast<T>(Q * alpha);
-            b[1] = 0;
-            b[2] = static_cast<T>(-Q * alpha);
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const T a0 = static_cast<T>(1 + alpha);
+            const T a1 = static_cast<T>(-2 * omega_c);
+            const T a2 = static_cast<T>(1 - alpha);
+            const T b0 = static_cast<T>(Q * alpha);
+            const T b1 = 0;
+            const T b2 = static_cast<T>(-Q * alpha);
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
@@ -98,58 +95,55 @@ namespace edsp { namespace filter {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
             const auto alpha   = omega_s / (2 * Q);
 
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>(1 + alpha);
-            a[1] = static_cast<T>(-2 * omega_c);
-            a[2] = static_cast<T>(1 - alpha);
-            b[0] = a[2];
-            b[1] = a[1];
-            b[2] = a[0];
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const T a0 = static_cast<T>(1 + alpha);
+            const T a1 = static_cast<T>(-2 * omega_c);
+            const T a2 = static_cast<T>(1 - alpha);
+            const T b0 = a2;
+            const T b1 = a1;
+            const T b2 = a0;
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
     template <typename T>
     struct RBJFilterDesigner<T, filter_type::LowShelf> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
-            const T A          = std::sqrt(std::pow(10., gain_db / 20));
+            const T A          = compile_time::sqrt(compile_time::pow(static_cast<T>(10), gain_db / 20));
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
-            const auto beta    = std::sqrt(A) / Q;
-
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>((A + 1) + (A - 1) * omega_c + beta * omega_s);
-            a[1] = static_cast<T>(-2 * ((A - 1) + (A + 1) * omega_c));
-            a[2] = static_cast<T>((A + 1) + (A - 1) * omega_c - beta * omega_s);
-            b[0] = static_cast<T>(A * ((A + 1) - (A - 1) * omega_c + beta * omega_s));
-            b[1] = static_cast<T>(2 * A * ((A - 1) - (A + 1) * omega_c));
-            b[2] = static_cast<T>(A * ((A + 1) - (A - 1) * omega_c - beta * omega_s));
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
+            const auto beta    = compile_time::sqrt(A) / Q;
+
+            const T a0 = static_cast<T>((A + 1) + (A - 1) * omega_c + beta * omega_s);
+            const T a1 = static_cast<T>(-2 * ((A - 1) + (A + 1) * omega_c));
+            const T a2 = static_cast<T>((A + 1) + (A - 1) * omega_c - beta * omega_s);
+            const T b0 = static_cast<T>(A * ((A + 1) - (A - 1) * omega_c + beta * omega_s));
+            const T b1 = static_cast<T>(2 * A * ((A - 1) - (A + 1) * omega_c));
+            const T b2 = static_cast<T>(A * ((A + 1) - (A - 1) * omega_c - beta * omega_s));
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
     template <typename T>
     struct RBJFilterDesigner<T, filter_type::HighShelf> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
-            const T A          = std::sqrt(std::pow(10, gain_db / 20));
+            const T A          = compile_time::sqrt(compile_time::pow(static_cast<T>(10), gain_db / 20));
             const auto omega   = 2 * constants<T>::pi * fc / sample_rate;
-            const auto omega_s = std::sin(omega);
-            const auto omega_c = std::cos(omega);
-            const auto beta    = std::sqrt(A) / Q;
-
-            std::array<T, 3> a{}, b{};
-            a[0] = static_cast<T>((A + 1) - (A - 1) * omega_c + beta * omega_s);
-            a[1] = static_cast<T>(2 * ((A - 1) - (A + 1) * omega_c));
-            a[2] = static_cast<T>((A + 1) - (A - 1) * omega_c - beta * omega_s);
-            b[0] = static_cast<T>(A * ((A + 1) + (A - 1) * omega_c + beta * omega_s));
-            b[1] = static_cast<T>(-2 * A * ((A - 1) + (A + 1) * omega_c));
-            b[2] = static_cast<T>(A * ((A + 1) + (A - 1) * omega_c - beta * omega_s));
-            return biquad<T>(a[0], a[1], a[2], b[0], b[1], b[2]);
+            const auto omega_s = compile_time::sin(omega);
+            const auto omega_c = compile_time::cos(omega);
+            const auto beta    = compile_time::sqrt(A) / Q;
+
+            const T a0 = static_cast<T>((A + 1) - (A - 1) * omega_c + beta * omega_s);
+            const T a1 = static_cast<T>(2 * ((A - 1) - (A + 1) * omega_c));
+            const T a2 = static_cast<T>((A + 1) - (A - 1) * omega_c - beta * omega_s);
+            const T b0 = static_cast<T>(A * ((A + 1) + (A - 1) * omega_c + beta * omega_s));
+            const T b1 = static_cast<T>(-2 * A * ((A - 1) + (A + 1) * omega_c));
+            const T b2 = static_cast<T>(A * ((A + 1) + (A - 1) * omega_c - beta * omega_s));
+            return biquad<T>(a0, a1, a2, b0, b1, b2);
         }
     };
 
@@ -24,10 +24,9 @@
 
 #include <edsp/filter/biquad.hpp>
 #include <edsp/math/constant.hpp>
-#include <edsp/converter/db2mag.hpp>
 #include <edsp/math/numeric.hpp>
 #include <edsp/meta/unused.hpp>
-#include <cmath>
+#include <edsp/math/compile_time.hpp>
 
 namespace edsp { namespace filter {
     template <typename T, filter_type Type>
@@ -37,7 +36,7 @@ namespace edsp { namespace filter {
     struct ZoelzerFilterDesigner<T, filter_type::LowPass> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
-            const auto K    = std::tan(constants<T>::pi * fc / sample_rate);
+            const auto K    = compile_time::tan(constants<T>::pi * fc / sample_rate);
             const auto norm = 1 / (1 + K / Q + K * K);
             const auto b0   = K * K * norm;
             const auto b1   = 2 * b0;
@@ -52,7 +51,7 @@ namespace edsp { namespace filter {
     struct ZoelzerFilterDesigner<T, filter_type::HighPass> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
-            const auto K    = std::tan(constants<T>::pi * fc / sample_rate);
+            const auto K    = compile_time::tan(constants<T>::pi * fc / sample_rate);
             const auto norm = 1 / (1 + K / Q + K * K);
             const auto b0   = 1 * norm;
             const auto b1   = -2 * b0;
@@ -67,10 +66,10 @@ namespace edsp { namespace filter {
     struct ZoelzerFilterDesigner<T, filter_type::BandPass> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(gain_db);
-            const auto K    = std::tan(constants<T>::pi * fc / sample_rate);
+            const auto K    = compile_time::tan(constants<T>::pi * fc / sample_rate);
             const auto norm = 1 / (1 + K / Q + K * K);
             const auto b0   = K / Q * norm;
-            const auto b1   = 0;
+            const auto b1   = T(0);
             const auto b2   = -b0;
             const auto a1   = 2 * (K * K - 1) * norm;
             const auto a2   = (1 - K / Q + K * K) * norm;
@@ -83,23 +82,23 @@ namespace edsp { namespace filter {
     struct ZoelzerFilterDesigner<T, filter_type::LowShelf> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(Q);
-            const auto V = db2mag(gain_db);
-            const auto K = std::tan(constants<T>::pi * fc / sample_rate);
+            const auto V = compile_time::pow(static_cast<T>(10), compile_time::abs(gain_db) / 20);
+            const auto K = compile_time::tan(constants<T>::pi * fc / sample_rate);
             if (gain_db >= 0) { // boost
                 const auto norm = 1 / (1 + constants<T>::root_two * K + K * K);
-                const auto b0   = (1 + std::sqrt(2 * V) * K + V * K * K) * norm;
+                const auto b0   = (1 + compile_time::sqrt(2 * V) * K + V * K * K) * norm;
                 const auto b1   = 2 * (V * K * K - 1) * norm;
-                const auto b2   = (1 - std::sqrt(2 * V) * K + V * K * K) * norm;
+                const auto b2   = (1 - compile_time::sqrt(2 * V) * K + V * K * K) * norm;
                 const auto a1   = 2 * (K * K - 1) * norm;
                 const auto a2   = (1 - constants<T>::root_two * K + K * K) * norm;
                 return biquad<T>(1, a1, a2, b0, b1, b2);
             } else { // cut
-                const auto norm = 1 / (1 + std::sqrt(2 * V) * K + V * K * K);
+                const auto norm = 1 / (1 + compile_time::sqrt(2 * V) * K + V * K * K);
                 const auto b0   = (1 + constants<T>::root_two * K + K * K) * norm;
                 const auto b1   = 2 * (K * K - 1) * norm;
                 const auto b2   = (1 - constants<T>::root_two * K + K * K) * norm;
                 const auto a1   = 2 * (V * K * K - 1) * norm;
-                const auto a2   = (1 - std::sqrt(2 * V) * K + V * K * K) * norm;
+                const auto a2   = (1 - compile_time::sqrt(2 * V) * K + V * K * K) * norm;
                 return biquad<T>(1, a1, a2, b0, b1, b2);
             }
         }
@@ -109,24 +108,24 @@ namespace edsp { namespace filter {
     struct ZoelzerFilterDesigner<T, filter_type::HighShelf> {
         constexpr biquad<T> operator()(T fc, T sample_rate, T Q, T gain_db = 1) const {
             meta::unused(Q);
-            const auto V = db2mag(gain_db);
-            const auto K = std::tan(constants<T>::pi * fc / sample_rate);
+            const auto V = compile_time::pow(static_cast<T>(10), compile_time::abs(gain_db) / 20);
+            const auto K = compile_time::tan(constants<T>::pi * fc / sample_rate);
             if (gain_db >= 0) { // boost
                 const auto norm = 1 / (1 + constants<T>::root_two * K + K * K);
-                const auto b0   = (V + std::sqrt(2 * V) * K + K * K) * norm;
+                const auto b0   = (V + compile_time::sqrt(2 * V) * K + K * K) * norm;
                 const auto b1   = 2 * (K * K - V) * norm;
-                const auto b2   = (V - std::sqrt(2 * V) * K + K * K) * norm;
+                const auto b2   = (V - compile_time::sqrt(2 * V) * K + K * K) * norm;
                 const auto a1   = 2 * (K * K - 1) * norm;
                 const auto a2   = (1 - constants<T>::root_two * K + K * K) * norm;
                 return biquad<T>(1, a1, a2, b0, b1, b2);
             } else { // cut
-                const auto norm = 1 / (V + std::sqrt(2 * V) * K + K * K);
+                const auto norm = 1 / (V + compile_time::sqrt(2 * V) * K + K * K);
                 const auto b0   = (1 + constants<T>::root_two * K + K * K) * norm;
                 const auto b1   = 2 * (K * K - 1) * norm;
                 const auto b2   = (1 - constants<T>::root_two * K + K * K) * norm;
                 const auto a1   = 2 * (K * K - V) * norm;
-                const auto a2   = (V - std::sqrt(2 * V) * K + K * K) * norm;
-                return biquad<T>(b0, b1, b2, a1, a1, a2);
+                const auto a2   = (V - compile_time::sqrt(2 * V) * K + K * K) * norm;
+                return biquad<T>(1, a1, a2, b0, b1, b2);
             }
         }
     };
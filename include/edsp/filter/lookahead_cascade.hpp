@@ -0,0 +1,285 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: lookahead_cascade.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_LOOKAHEAD_CASCADE_HPP
+#define EDSP_FILTER_LOOKAHEAD_CASCADE_HPP
+
+#include <edsp/core/denormal_guard.hpp>
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/dynamic_biquad_cascade.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class lookahead_cascade
+     * @brief This class implements a cascade of biquads that computes K outputs at once, with the block state-space
+     * (look-ahead) formulation of the recursion.
+     *
+     * The recursion of a biquad limits the speed of a single channel to one sample per latency of its feedback chain,
+     * whatever the width of the SIMD registers. Written in state space with the two states of the transposed direct
+     * form II, \f$ s_{n+1} = A s_n + B x_n \f$ and \f$ y_n = C s_n + D x_n \f$, a block of K samples is
+     *
+     * \f[
+     *  \begin{bmatrix} y \\ s_{n+K} \end{bmatrix} =
+     *  \begin{bmatrix} T & O \\ R & A^K \end{bmatrix} \begin{bmatrix} x \\ s_n \end{bmatrix}
+     * \f]
+     *
+     * where T is the lower triangular Toeplitz matrix of the impulse response, O the observability matrix and R the
+     * reachability matrix of the block. The matrix of every stage is precomputed in long double, and the K + 2 rows of
+     * the product are independent, so the compiler computes several of them at once in the SIMD lanes. The work per
+     * sample grows with K, but no longer depends on the latency of the recursion: values of K for which K + 2 is a
+     * multiple of the SIMD width work best, and the gain relies on the optimisations of the release builds.
+     *
+     * The remaining samples of a range shorter than a block are filtered one by one with the same states, so the
+     * output does not depend on how the signal is split into ranges. The output matches the one of the recursive
+     * biquads up to rounding errors.
+     *
+     * @tparam T  Type of element.
+     * @tparam K  Number of samples per block.
+     */
+    template <typename T, std::size_t K = 14>
+    class lookahead_cascade {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a filter from a biquad, at rest.
+         * @param stage Biquad to run in blocks.
+         */
+        explicit lookahead_cascade(const biquad<T>& stage);
+
+        /**
+         * @brief Creates a filter from a cascade of biquads, at rest.
+         * @param cascade Cascade of biquads to run in blocks.
+         */
+        template <std::size_t N>
+        explicit lookahead_cascade(const biquad_cascade<T, N>& cascade);
+
+        /**
+         * @brief Creates a filter from a cascade of biquads sized at runtime, at rest.
+         * @param cascade Cascade of biquads to run in blocks.
+         */
+        template <typename Allocator>
+        explicit lookahead_cascade(const dynamic_biquad_cascade<T, Allocator>& cascade);
+
+        /**
+         * @brief Returns the number of biquads.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the number of samples computed per block.
+         */
+        static constexpr size_type block_size() noexcept;
+
+        /**
+         * @brief Resets the state of the biquads.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Filters the signal in the range [first, last) and stores the result in another range, beginning at
+         * d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+    private:
+        // Rows of the matrices, padded so every column is a whole number of SIMD registers
+        static constexpr size_type columns = K + 2;
+        static constexpr size_type rows    = (columns + 7) / 8 * 8;
+
+        struct coefficients {
+            T b0, b1, b2, a1, a2;
+        };
+
+        void append(const biquad<T>& stage);
+
+        T tick(T value) noexcept;
+
+        std::vector<coefficients> stages_;
+        std::vector<T> matrices_;
+        std::vector<T> states_;
+    };
+
+    template <typename T, std::size_t K>
+    lookahead_cascade<T, K>::lookahead_cascade(const biquad<T>& stage) {
+        append(stage);
+    }
+
+    template <typename T, std::size_t K>
+    template <std::size_t N>
+    lookahead_cascade<T, K>::lookahead_cascade(const biquad_cascade<T, N>& cascade) {
+        for (const auto& stage : cascade) {
+            append(stage);
+        }
+    }
+
+    template <typename T, std::size_t K>
+    template <typename Allocator>
+    lookahead_cascade<T, K>::lookahead_cascade(const dynamic_biquad_cascade<T, Allocator>& cascade) {
+        for (const auto& stage : cascade) {
+            append(stage);
+        }
+    }
+
+    template <typename T, std::size_t K>
+    void lookahead_cascade<T, K>::append(const biquad<T>& stage) {
+        static_assert(K > 0, "Expected at least one sample per block");
+        meta::expects(stage.a0() != 0, "Expected a non zero coefficient a0");
+
+        const auto a0 = static_cast<long double>(stage.a0());
+        const auto b0 = stage.b0() / a0, b1 = stage.b1() / a0, b2 = stage.b2() / a0;
+        const auto a1 = stage.a1() / a0, a2 = stage.a2() / a0;
+        stages_.push_back({static_cast<T>(b0), static_cast<T>(b1), static_cast<T>(b2), static_cast<T>(a1),
+                           static_cast<T>(a2)});
+
+        // Transposed direct form II: A = [-a1 1; -a2 0], B = [b1 - a1 b0; b2 - a2 b0], C = [1 0], D = b0
+        const auto offset = matrices_.size();
+        matrices_.resize(offset + rows * columns, T(0));
+        const auto at = [this, offset](size_type row, size_type column) -> T& {
+            return matrices_[offset + column * rows + row];
+        };
+
+        // Column j of the input: h[k - j] in the outputs and A^(K - 1 - j) B in the next state, where the impulse
+        // response is h[0] = D and h[m] = C A^(m - 1) B
+        std::vector<long double> response(K), reach0(K), reach1(K);
+        long double v0 = b1 - a1 * b0, v1 = b2 - a2 * b0;
+        response[0] = b0;
+        for (size_type m = 0; m < K; ++m) {
+            if (m + 1 < K) {
+                response[m + 1] = v0;
+            }
+            reach0[K - 1 - m] = v0;
+            reach1[K - 1 - m] = v1;
+            const auto next0  = -a1 * v0 + v1;
+            const auto next1  = -a2 * v0;
+            v0 = next0, v1 = next1;
+        }
+        for (size_type j = 0; j < K; ++j) {
+            for (auto k = j; k < K; ++k) {
+                at(k, j) = static_cast<T>(response[k - j]);
+            }
+            at(K, j)     = static_cast<T>(reach0[j]);
+            at(K + 1, j) = static_cast<T>(reach1[j]);
+        }
+
+        // Columns of the state: C A^k in the outputs and A^K in the next state
+        long double p00 = 1, p01 = 0, p10 = 0, p11 = 1;
+        for (size_type k = 0; k < K; ++k) {
+            at(k, K)     = static_cast<T>(p00);
+            at(k, K + 1) = static_cast<T>(p01);
+            const auto n00 = -a1 * p00 + p10, n01 = -a1 * p01 + p11;
+            const auto n10 = -a2 * p00, n11 = -a2 * p01;
+            p00 = n00, p01 = n01, p10 = n10, p11 = n11;
+        }
+        at(K, K)         = static_cast<T>(p00);
+        at(K, K + 1)     = static_cast<T>(p01);
+        at(K + 1, K)     = static_cast<T>(p10);
+        at(K + 1, K + 1) = static_cast<T>(p11);
+
+        states_.resize(states_.size() + 2, T(0));
+    }
+
+    template <typename T, std::size_t K>
+    typename lookahead_cascade<T, K>::size_type lookahead_cascade<T, K>::size() const noexcept {
+        return stages_.size();
+    }
+
+    template <typename T, std::size_t K>
+    constexpr typename lookahead_cascade<T, K>::size_type lookahead_cascade<T, K>::block_size() noexcept {
+        return K;
+    }
+
+    template <typename T, std::size_t K>
+    void lookahead_cascade<T, K>::reset() noexcept {
+        std::fill(std::begin(states_), std::end(states_), T(0));
+    }
+
+    template <typename T, std::size_t K>
+    T lookahead_cascade<T, K>::tick(T value) noexcept {
+        auto* state = states_.data();
+        for (const auto& stage : stages_) {
+            const auto out = stage.b0 * value + state[0];
+            state[0]       = stage.b1 * value - stage.a1 * out + state[1];
+            state[1]       = stage.b2 * value - stage.a2 * out;
+            value          = out;
+            state += 2;
+        }
+        return value;
+    }
+
+    template <typename T, std::size_t K>
+    template <typename InputIt, typename OutputIt>
+    void lookahead_cascade<T, K>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<T>(guard);
+
+        T block[columns];
+        T output[rows];
+        while (first != last) {
+            size_type count = 0;
+            for (; count < K && first != last; ++count, ++first) {
+                block[count] = *first + offset;
+            }
+            if (count < K) {
+                d_first = std::transform(block, block + count, d_first, [this](T value) { return tick(value); });
+                break;
+            }
+
+            const auto* matrix = matrices_.data();
+            auto* state        = states_.data();
+            for (size_type stage = 0; stage < stages_.size(); ++stage) {
+                block[K]     = state[0];
+                block[K + 1] = state[1];
+                // The matrix is stored by columns: accumulating one column at a time walks it with unit stride
+                std::fill(output, output + rows, T(0));
+                for (size_type column = 0; column < columns; ++column) {
+                    const auto value = block[column];
+                    const auto* a    = matrix + column * rows;
+                    for (size_type row = 0; row < rows; ++row) {
+                        output[row] += a[row] * value;
+                    }
+                }
+                std::copy(output, output + K, block);
+                state[0] = output[K];
+                state[1] = output[K + 1];
+                matrix += rows * columns;
+                state += 2;
+            }
+            d_first = std::copy(block, block + K, d_first);
+        }
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_LOOKAHEAD_CASCADE_HPP
@@ -22,7 +22,9 @@
 #ifndef EDSP_FILTER_MOVING_AVERAGE_FILTER_H
 #define EDSP_FILTER_MOVING_AVERAGE_FILTER_H
 
-#include <edsp/types/ring_buffer.hpp>
+#include <edsp/filter/internal/moving_sum.hpp>
+#include <edsp/meta/expects.hpp>
+#include <memory>
 
 namespace edsp { namespace filter {
 
@@ -41,6 +43,9 @@ namespace edsp { namespace filter {
      *  \lambda_i = \frac{x_{n} + x_{n-1}+ \cdots + x_{i-(N-2)} + x_{i-(N-1)}}{N}
      * \f]
      *
+     * The window is updated with a running sum, so the cost per element does not depend on its length. Blocks of
+     * interleaved channels are processed several channels at a time.
+     *
      * @tparam T  Type of element.
      * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
      */
@@ -53,8 +58,9 @@ namespace edsp { namespace filter {
         /**
          *  @brief Creates a %moving_average with a window of length N.
          *  @param N Length of the moving average window.
+         *  @param channels Number of interleaved channels.
          */
-        explicit moving_average(size_type N);
+        explicit moving_average(size_type N, size_type channels = 1);
 
         /**
          *  @brief Returns the size of the moving window.
@@ -62,8 +68,15 @@ namespace edsp { namespace filter {
          */
         size_type size() const;
 
+        /**
+         *  @brief Returns the number of interleaved channels.
+         */
+        size_type channels() const;
+
         /**
          *  @brief Resizes the moving window to the specified number of elements.
+         *
+         *  The window is emptied, as after a reset.
          *  @param N Number of elements the moving window should contain.
          */
         void resize(size_type N);
@@ -74,8 +87,8 @@ namespace edsp { namespace filter {
         void reset();
 
         /**
-         * @brief Applies a moving average filter to the elements in the range [first, last) and stores the result
-         * in another range, beginning at d_first.
+         * @brief Applies a moving average filter to the interleaved elements in the range [first, last) and stores the
+         * result in another range, beginning at d_first.
          *
          * @param first Input iterator defining the beginning of the input range.
          * @param last Input iterator defining the ending of the input range.
@@ -85,48 +98,51 @@ namespace edsp { namespace filter {
         void filter(InputIt first, InputIt last, OutputIt d_first);
 
         /**
-         * @brief Applies a moving average filter to the single element
+         * @brief Applies the filter to a single element of a filter with one channel.
          * @return The output of the filter.
          */
         value_type operator()(value_type tick);
 
     private:
-        edsp::ring_buffer<T, Allocator> window_;
-        T accumulated_{0};
+        internal::moving_sum<T, Allocator> sums_;
     };
 
     template <typename T, typename Allocator>
-    moving_average<T, Allocator>::moving_average(size_type N) : window_(N, T()) {}
+    moving_average<T, Allocator>::moving_average(size_type N, size_type channels) : sums_(N, channels) {}
 
     template <typename T, typename Allocator>
     typename moving_average<T, Allocator>::size_type moving_average<T, Allocator>::size() const {
-        return window_.capacity();
+        return sums_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_average<T, Allocator>::size_type moving_average<T, Allocator>::channels() const {
+        return sums_.channels();
     }
 
     template <typename T, typename Allocator>
     void moving_average<T, Allocator>::reset() {
-        window_.clear();
+        sums_.reset();
     }
 
     template <typename T, typename Allocator>
     template <typename InputIt, typename OutputIt>
     void moving_average<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
-        std::transform(first, last, d_first, std::ref(*this));
+        const auto identity = [](const value_type value) { return value; };
+        sums_.process(first, last, d_first, identity, identity);
     }
 
     template <typename T, typename Allocator>
     void moving_average<T, Allocator>::resize(size_type N) {
-        window_.resize(N);
+        sums_.resize(N);
     }
 
     template <typename T, typename Allocator>
     typename moving_average<T, Allocator>::value_type moving_average<T, Allocator>::operator()(value_type tick) {
-        if (window_.full()) {
-            accumulated_ -= window_.front();
-        }
-        accumulated_ += tick;
-        window_.push_back(tick);
-        return accumulated_ / static_cast<T>(window_.size());
+        meta::expects(sums_.channels() == 1, "Expected a filter with one channel");
+        value_type output{};
+        filter(&tick, &tick + 1, &output);
+        return output;
     }
 
 }} // namespace edsp::filter
@@ -0,0 +1,239 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: moving_extremum_filter.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_MOVING_EXTREMUM_FILTER_HPP
+#define EDSP_FILTER_MOVING_EXTREMUM_FILTER_HPP
+
+#include <edsp/meta/expects.hpp>
+#include <edsp/types/fixed_ring_buffer.hpp>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        struct extremum_value {
+            template <typename T>
+            constexpr T operator()(T value) const noexcept {
+                return value;
+            }
+        };
+
+        struct extremum_magnitude {
+            template <typename T>
+            T operator()(T value) const noexcept {
+                return std::abs(value);
+            }
+        };
+
+    } // namespace internal
+
+    /**
+     * @class moving_extremum
+     * @brief This class implements a moving extremum (rolling maximum or minimum) filter.
+     *
+     * Every output is the extremum of the last N elements. Each channel keeps a monotonic deque of the elements that
+     * may still become the extremum of a future window: a new element removes from the back all the elements it
+     * dominates, and the front leaves the deque once it falls out of the window. Every element is inserted and removed
+     * at most once, so the cost per element is constant in average and does not depend on N.
+     *
+     * The deques are stored in fixed_ring_buffer, so the filter does not allocate memory while filtering.
+     *
+     * @tparam T  Type of element.
+     * @tparam MaxSize  Maximum length of the moving window.
+     * @tparam Compare  Strict order in which the extremum is the first element.
+     * @tparam Map  Function applied to every element before being compared.
+     * @see moving_max, moving_min, moving_peak
+     */
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map = internal::extremum_value>
+    class moving_extremum {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         *  @brief Creates a %moving_extremum with a window of length N.
+         *  @param N Length of the moving window, at most MaxSize.
+         *  @param channels Number of interleaved channels.
+         */
+        explicit moving_extremum(size_type N, size_type channels = 1);
+
+        /**
+         *  @brief Returns the size of the moving window.
+         *  @returns Number of elements in the moving window.
+         */
+        size_type size() const;
+
+        /**
+         *  @brief Returns the number of interleaved channels.
+         */
+        size_type channels() const;
+
+        /**
+         *  @brief Resizes the moving window to the specified number of elements.
+         *
+         *  The window is emptied, as after a reset.
+         *  @param N Number of elements the moving window should contain, at most MaxSize.
+         */
+        void resize(size_type N);
+
+        /**
+         * @brief Reset the moving window to the original state.
+         */
+        void reset();
+
+        /**
+         * @brief Computes the moving extremum of the interleaved elements in the range [first, last) and stores the
+         * result in another range, beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Applies the filter to a single element of a filter with one channel.
+         * @return The output of the filter.
+         */
+        value_type operator()(value_type tick);
+
+    private:
+        struct candidate {
+            value_type value;
+            size_type index;
+        };
+
+        using deque_type = fixed_ring_buffer<candidate, MaxSize>;
+
+        value_type push(deque_type& deque, value_type value);
+
+        std::vector<deque_type> deques_;
+        size_type size_;
+        size_type index_{0};
+    };
+
+    /**
+     * @brief Moving maximum of the last N elements.
+     * @see moving_extremum
+     */
+    template <typename T, std::size_t MaxSize>
+    using moving_max = moving_extremum<T, MaxSize, std::greater<T>>;
+
+    /**
+     * @brief Moving minimum of the last N elements.
+     * @see moving_extremum
+     */
+    template <typename T, std::size_t MaxSize>
+    using moving_min = moving_extremum<T, MaxSize, std::less<T>>;
+
+    /**
+     * @brief Moving maximum of the absolute value of the last N elements, as used in peak meters.
+     * @see moving_extremum
+     */
+    template <typename T, std::size_t MaxSize>
+    using moving_peak = moving_extremum<T, MaxSize, std::greater<T>, internal::extremum_magnitude>;
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    moving_extremum<T, MaxSize, Compare, Map>::moving_extremum(size_type N, size_type channels) :
+        deques_(channels),
+        size_(N) {
+        meta::expects(N > 0 && N <= MaxSize, "Expected a window length between 1 and MaxSize");
+        meta::expects(channels > 0, "Expected at least one channel");
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    typename moving_extremum<T, MaxSize, Compare, Map>::size_type moving_extremum<T, MaxSize, Compare, Map>::size()
+        const {
+        return size_;
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    typename moving_extremum<T, MaxSize, Compare, Map>::size_type moving_extremum<T, MaxSize, Compare, Map>::channels()
+        const {
+        return deques_.size();
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    void moving_extremum<T, MaxSize, Compare, Map>::resize(size_type N) {
+        meta::expects(N > 0 && N <= MaxSize, "Expected a window length between 1 and MaxSize");
+        size_ = N;
+        reset();
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    void moving_extremum<T, MaxSize, Compare, Map>::reset() {
+        for (auto& deque : deques_) {
+            deque.clear();
+        }
+        index_ = 0;
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    typename moving_extremum<T, MaxSize, Compare, Map>::value_type
+        moving_extremum<T, MaxSize, Compare, Map>::push(deque_type& deque, value_type value) {
+        // The indices are increasing, so at most the front leaves the window, which keeps the deque below N elements
+        if (!deque.empty() && deque.front().index + size_ <= index_) {
+            deque.pop_front();
+        }
+
+        // The elements dominated by the new one can not be the extremum of any window that includes it
+        while (!deque.empty() && !Compare{}(deque.back().value, value)) {
+            deque.pop_back();
+        }
+        deque.push_back(candidate{value, index_});
+        return deque.front().value;
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    template <typename InputIt, typename OutputIt>
+    void moving_extremum<T, MaxSize, Compare, Map>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const auto channels = deques_.size();
+        const auto samples  = static_cast<size_type>(std::distance(first, last));
+        meta::expects(samples % channels == 0, "Expected an integer number of frames");
+
+        const auto map = Map{};
+        for (auto frames = samples / channels; frames > 0; --frames, ++index_) {
+            for (auto& deque : deques_) {
+                *d_first = push(deque, map(static_cast<value_type>(*first)));
+                ++first;
+                ++d_first;
+            }
+        }
+    }
+
+    template <typename T, std::size_t MaxSize, typename Compare, typename Map>
+    typename moving_extremum<T, MaxSize, Compare, Map>::value_type
+        moving_extremum<T, MaxSize, Compare, Map>::operator()(value_type tick) {
+        meta::expects(deques_.size() == 1, "Expected a filter with one channel");
+        const auto output = push(deques_.front(), Map{}(tick));
+        ++index_;
+        return output;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MOVING_EXTREMUM_FILTER_HPP
@@ -22,8 +22,11 @@
 #ifndef EDSP_MOVING_RMS_FILTER_HPP
 #define EDSP_MOVING_RMS_FILTER_HPP
 
-#include <edsp/types/ring_buffer.hpp>
+#include <edsp/filter/internal/moving_sum.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
 #include <cmath>
+#include <memory>
 
 namespace edsp { namespace filter {
 
@@ -42,6 +45,9 @@ namespace edsp { namespace filter {
      *  \lambda_i = \sqrt{ \frac{x_{n}^2 + x_{n-1}^2 + \cdots + x_{i-(N-2)}^2 + x_{i-(N-1)}^2}{N}}
      * \f]
      *
+     * The window is updated with a running sum, so the cost per element does not depend on its length. Blocks of
+     * interleaved channels are processed several channels at a time.
+     *
      * @tparam T  Type of element.
      * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
      */
@@ -54,8 +60,9 @@ namespace edsp { namespace filter {
         /**
         *  @brief Creates a %moving_rms with a window of length N.
         *  @param N Length of the moving average window.
+        *  @param channels Number of interleaved channels.
         */
-        explicit moving_rms(size_type N);
+        explicit moving_rms(size_type N, size_type channels = 1);
 
         /**
         *  @brief Returns the size of the moving window.
@@ -63,8 +70,15 @@ namespace edsp { namespace filter {
         */
         size_type size() const;
 
+        /**
+        *  @brief Returns the number of interleaved channels.
+        */
+        size_type channels() const;
+
         /**
         *  @brief Resizes the moving window to the specified number of elements.
+        *
+        *  The window is emptied, as after a reset.
         *  @param N Number of elements the moving window should contain.
         */
         void resize(size_type N);
@@ -75,8 +89,8 @@ namespace edsp { namespace filter {
         void reset();
 
         /**
-        * @brief Applies a moving average filter to the elements in the range [first, last) and stores the result
-        * in another range, beginning at d_first.
+        * @brief Applies a moving rms filter to the interleaved elements in the range [first, last) and stores the
+        * result in another range, beginning at d_first.
         *
         * @param first Input iterator defining the beginning of the input range.
         * @param last Input iterator defining the ending of the input range.
@@ -86,62 +100,52 @@ namespace edsp { namespace filter {
         void filter(InputIt first, InputIt last, OutputIt d_first);
 
         /**
-         * @brief Applies a moving average filter to the single element
+         * @brief Applies the filter to a single element of a filter with one channel.
          * @return The output of the filter.
          */
         value_type operator()(value_type tick);
 
     private:
-        edsp::ring_buffer<T, Allocator> window_;
-        T accumulated_{0};
+        internal::moving_sum<T, Allocator> sums_;
     };
 
     template <typename T, typename Allocator>
-    moving_rms<T, Allocator>::moving_rms(size_type N) : window_(N, T()) {}
+    moving_rms<T, Allocator>::moving_rms(size_type N, size_type channels) : sums_(N, channels) {}
 
     template <typename T, typename Allocator>
     typename moving_rms<T, Allocator>::size_type moving_rms<T, Allocator>::size() const {
-        return window_.capacity();
+        return sums_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_rms<T, Allocator>::size_type moving_rms<T, Allocator>::channels() const {
+        return sums_.channels();
     }
 
     template <typename T, typename Allocator>
     void moving_rms<T, Allocator>::reset() {
-        window_.clear();
+        sums_.reset();
     }
 
     template <typename T, typename Allocator>
     template <typename InputIt, typename OutputIt>
     void moving_rms<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
-        if (window_.full()) {
-            for (; first != last; ++d_first, ++first) {
-                const auto sqr = (*first) * (*first);
-                accumulated_ -= window_.front();
-                accumulated_ += sqr;
-                window_.push_back(sqr)* d_first = std::sqrt(accumulated_ / static_cast<T>(window_.size()));
-            }
-        } else {
-            for (; first != last; ++d_first, ++first) {
-                const auto sqr = (*first) * (*first);
-                accumulated_ += sqr;
-                window_.push_back(sqr)* d_first = std::sqrt(accumulated_ / static_cast<T>(window_.size()));
-            }
-        };
+        // The running sum can drift slightly below zero when the window holds only silence
+        sums_.process(first, last, d_first, [](const value_type value) { return value * value; },
+                      [](const value_type mean) { return std::sqrt(std::max(mean, value_type(0))); });
     }
 
     template <typename T, typename Allocator>
     void moving_rms<T, Allocator>::resize(size_type N) {
-        window_.resize(N);
+        sums_.resize(N);
     }
 
     template <typename T, typename Allocator>
     typename moving_rms<T, Allocator>::value_type moving_rms<T, Allocator>::operator()(value_type tick) {
-        if (window_.full()) {
-            accumulated_ -= window_.front();
-        }
-        const auto sqr = tick * tick;
-        accumulated_ += sqr;
-        window_.push_back(sqr);
-        return std::sqrt(accumulated_ / static_cast<T>(window_.size()));
+        meta::expects(sums_.channels() == 1, "Expected a filter with one channel");
+        value_type output{};
+        filter(&tick, &tick + 1, &output);
+        return output;
     }
 
 }} // namespace edsp::filter
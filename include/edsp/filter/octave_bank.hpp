@@ -0,0 +1,239 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: octave_bank.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 01/11/2018
+ */
+#ifndef EDSP_FILTER_OCTAVE_BANK_HPP
+#define EDSP_FILTER_OCTAVE_BANK_HPP
+
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/moving_rms_filter.hpp>
+#include <edsp/filter/internal/butterworth_designer.hpp>
+#include <edsp/filter/internal/halfband_decimator.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class octave_bank
+     * @brief This class implements a bank of octave or fractional octave band filters, as the ones defined in IEC
+     * 61260, that measures the RMS level of every band.
+     *
+     * The bands of an octave are half the frequency of the bands of the octave above. Instead of designing narrower
+     * filters at the full sampling rate, only the bands of the highest octave are designed, as Butterworth band pass
+     * filters. Every octave is then filtered with the same designs at half the sampling rate of the octave above,
+     * obtained with a halfband decimator. The cost of every octave is half the cost of the previous one, so the whole
+     * bank costs about twice its highest octave, and the low bands do not suffer from the poor numerical conditioning
+     * of very narrow filters at high sampling rates.
+     *
+     * The midband frequencies follow the base-two series \f$ f_m = f_r 2^{-k/b} \f$, with b bands per octave and the
+     * highest midband frequency \f$ f_r \f$, and the band edges are at \f$ f_m 2^{\pm 1/(2b)} \f$.
+     *
+     * The level of every band is the RMS value of its output over the integration time, computed with a moving_rms
+     * running at the rate of the octave.
+     *
+     * @tparam T  Type of element.
+     * @tparam MaxOrder  Maximum order of the band pass filters.
+     */
+    template <typename T, std::size_t MaxOrder = 4>
+    class octave_bank {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a filter bank.
+         * @param sample_rate The sampling frequency in Hz.
+         * @param highest_frequency Midband frequency of the highest band in Hz.
+         * @param octaves Number of octaves.
+         * @param bands_per_octave Number of bands per octave: 1 for octave bands, 3 for third-octave bands.
+         * @param integration_time Length in seconds of the window used to measure the levels.
+         * @param order Order of the band pass filters, at most MaxOrder.
+         */
+        octave_bank(T sample_rate, T highest_frequency, size_type octaves, size_type bands_per_octave = 3,
+                    T integration_time = T(0.125), size_type order = 3);
+
+        /**
+         * @brief Returns the number of bands.
+         */
+        size_type bands() const noexcept;
+
+        /**
+         * @brief Returns the number of octaves.
+         */
+        size_type octaves() const noexcept;
+
+        /**
+         * @brief Returns the midband frequency of a band in Hz, the bands being sorted in ascending frequency.
+         */
+        value_type frequency(size_type band) const;
+
+        /**
+         * @brief Resets the state of the filters and the measured levels.
+         */
+        void reset();
+
+        /**
+         * @brief Filters the elements in the range [first, last) and updates the levels of the bands.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         */
+        template <typename InputIt>
+        void filter(InputIt first, InputIt last);
+
+        /**
+         * @brief Stores the RMS level of every band, in ascending frequency, in the range beginning at d_first.
+         *
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Output iterator to the element past the last element written.
+         */
+        template <typename OutputIt>
+        OutputIt levels(OutputIt d_first) const;
+
+    private:
+        using cascade_type = biquad_cascade<T, MaxOrder>;
+
+        struct octave {
+            std::vector<cascade_type> filters;
+            std::vector<moving_rms<T>> meters;
+            std::vector<T> input;
+        };
+
+        std::vector<octave> octaves_;
+        std::vector<halfband_decimator<T>> decimators_;
+        std::vector<T> levels_;
+        std::vector<T> output_;
+        T highest_frequency_;
+        size_type bands_per_octave_;
+    };
+
+    template <typename T, std::size_t MaxOrder>
+    octave_bank<T, MaxOrder>::octave_bank(T sample_rate, T highest_frequency, size_type octaves,
+                                          size_type bands_per_octave, T integration_time, size_type order) :
+        octaves_(octaves),
+        levels_(octaves * bands_per_octave, T(0)),
+        highest_frequency_(highest_frequency),
+        bands_per_octave_(bands_per_octave) {
+        meta::expects(octaves > 0 && bands_per_octave > 0, "Expected at least one band");
+        meta::expects(order > 0 && order <= MaxOrder, "Expected an order between 1 and MaxOrder");
+
+        const auto half_band  = std::pow(T(2), T(1) / static_cast<T>(2 * bands_per_octave));
+        const auto upper_edge = highest_frequency * half_band;
+        meta::expects(upper_edge < T(0.45) * sample_rate, "Expected the highest band below the Nyquist frequency");
+
+        // Designs of the highest octave, in ascending frequency, shared by all the octaves
+        std::vector<cascade_type> designs;
+        for (size_type i = 0; i < bands_per_octave; ++i) {
+            const auto center = frequency(bands() - bands_per_octave + i);
+            const auto lower  = center / half_band;
+            const auto upper  = center * half_band;
+            designs.push_back(butterworth_designer<T, filter_type::BandPass, MaxOrder>{}(
+                order, sample_rate, (lower + upper) / 2, upper - lower));
+        }
+
+        // Content above the highest edge only has to be rejected where it folds onto the bands of the next octave
+        decimators_.assign(octaves - 1, halfband_decimator<T>(
+                                            halfband_decimator<T>::length_for(T(0.5) - upper_edge / sample_rate)));
+
+        auto rate = sample_rate;
+        for (auto& current : octaves_) {
+            const auto window = std::max<size_type>(1, static_cast<size_type>(std::lround(integration_time * rate)));
+            current.filters   = designs;
+            current.meters.assign(bands_per_octave, moving_rms<T>(window));
+            rate /= 2;
+        }
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    typename octave_bank<T, MaxOrder>::size_type octave_bank<T, MaxOrder>::bands() const noexcept {
+        return levels_.size();
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    typename octave_bank<T, MaxOrder>::size_type octave_bank<T, MaxOrder>::octaves() const noexcept {
+        return octaves_.size();
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    typename octave_bank<T, MaxOrder>::value_type octave_bank<T, MaxOrder>::frequency(size_type band) const {
+        meta::expects(band < bands(), "Index out of bounds");
+        const auto distance = static_cast<T>(bands() - 1 - band) / static_cast<T>(bands_per_octave_);
+        return highest_frequency_ * std::pow(T(2), -distance);
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    void octave_bank<T, MaxOrder>::reset() {
+        for (auto& current : octaves_) {
+            for (auto& filter : current.filters) {
+                filter.reset();
+            }
+            for (auto& meter : current.meters) {
+                meter.reset();
+            }
+        }
+        for (auto& decimator : decimators_) {
+            decimator.reset();
+        }
+        std::fill(std::begin(levels_), std::end(levels_), T(0));
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    template <typename InputIt>
+    void octave_bank<T, MaxOrder>::filter(InputIt first, InputIt last) {
+        octaves_.front().input.assign(first, last);
+        for (size_type i = 0; i < octaves_.size(); ++i) {
+            auto& current = octaves_[i];
+            const auto& input = current.input;
+            if (input.empty()) {
+                continue;
+            }
+
+            // The octaves are stored from the highest one, and the levels in ascending frequency
+            const auto offset = (octaves_.size() - 1 - i) * bands_per_octave_;
+            output_.resize(input.size());
+            for (size_type band = 0; band < bands_per_octave_; ++band) {
+                current.filters[band].filter(std::cbegin(input), std::cend(input), std::begin(output_));
+                current.meters[band].filter(std::cbegin(output_), std::cend(output_), std::begin(output_));
+                levels_[offset + band] = output_.back();
+            }
+
+            if (i + 1 < octaves_.size()) {
+                auto& next = octaves_[i + 1].input;
+                next.resize(input.size() / 2 + 1);
+                const auto end = decimators_[i].filter(std::cbegin(input), std::cend(input), std::begin(next));
+                next.erase(end, std::end(next));
+            }
+        }
+    }
+
+    template <typename T, std::size_t MaxOrder>
+    template <typename OutputIt>
+    OutputIt octave_bank<T, MaxOrder>::levels(OutputIt d_first) const {
+        return std::copy(std::cbegin(levels_), std::cend(levels_), d_first);
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_OCTAVE_BANK_HPP
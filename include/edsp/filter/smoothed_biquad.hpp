@@ -0,0 +1,252 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: smoothed_biquad.hpp
+ * Date: 30/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_FILTER_SMOOTHED_BIQUAD_HPP
+#define EDSP_FILTER_SMOOTHED_BIQUAD_HPP
+
+#include <edsp/core/denormal_guard.hpp>
+#include <edsp/filter/biquad.hpp>
+#include <array>
+#include <cstddef>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class smoothed_biquad
+     * @brief This class implements a Biquad filter whose coefficients can be modulated without discontinuities.
+     *
+     * Updating the coefficients does not reset the state of the filter. Instead, the normalized coefficients move
+     * linearly from their current value to the new target over a fixed number of samples. The filtering is performed
+     * with the same transposed structure used by biquad, so a filter that is not ramping produces the same output.
+     *
+     * The set of stable pairs \f$ (a_1, a_2) \f$ is a triangle, so every intermediate filter of a ramp between two
+     * stable filters is stable too.
+     *
+     * @tparam T Value type.
+     */
+    template <typename T>
+    class smoothed_biquad {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates a filter with the given coefficients.
+         * @param initial Filter defining the initial coefficients.
+         * @param ramp Number of samples used to reach every new target.
+         */
+        explicit smoothed_biquad(const biquad<T>& initial = biquad<T>{}, size_type ramp = 64);
+
+        /**
+         * @brief Returns the number of samples used to reach every new target.
+         */
+        size_type ramp() const noexcept;
+
+        /**
+         * @brief Updates the number of samples used to reach the next targets.
+         *
+         * A ramp already in progress is not modified.
+         */
+        void set_ramp(size_type ramp) noexcept;
+
+        /**
+         * @brief Checks if the coefficients are still moving towards the target.
+         */
+        bool ramping() const noexcept;
+
+        /**
+         * @brief Returns a filter with the coefficients currently in use.
+         */
+        biquad<T> current() const noexcept;
+
+        /**
+         * @brief Returns a filter with the coefficients being reached.
+         */
+        biquad<T> target() const noexcept;
+
+        /**
+         * @brief Starts moving the coefficients towards the given filter, keeping the state.
+         * @param target Filter defining the coefficients to be reached.
+         */
+        void set_target(const biquad<T>& target) noexcept;
+
+        /**
+         * @brief Replaces the coefficients immediately, keeping the state.
+         * @param coefficients Filter defining the new coefficients.
+         */
+        void set_coefficients(const biquad<T>& coefficients) noexcept;
+
+        /**
+         * @brief Resets the state of the filter. The coefficients are not modified.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Filters the signal in the range [first, last) and stores the result in another range, beginning at d_first.
+         *
+         * The samples in the ramp are filtered updating the coefficients after every sample, and the rest with fixed
+         * coefficients.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the output of filtering one digital time-step.
+         * @param value Input value to be filtered.
+         * @return Filtered value.
+         */
+        value_type tick(value_type value) noexcept;
+
+    private:
+        /* Normalized coefficients, stored as b0, b1, b2, a1, a2 */
+        using coefficients_type = std::array<T, 5>;
+
+        static coefficients_type normalize(const biquad<T>& filter) noexcept;
+        static biquad<T> make_biquad(const coefficients_type& coefficients) noexcept;
+
+        coefficients_type current_{};
+        coefficients_type target_{};
+        coefficients_type step_{};
+        size_type ramp_{0};
+        size_type remaining_{0};
+        value_type w0_{0};
+        value_type w1_{0};
+    };
+
+    template <typename T>
+    smoothed_biquad<T>::smoothed_biquad(const biquad<T>& initial, size_type ramp) :
+        current_(normalize(initial)),
+        target_(current_),
+        ramp_(ramp) {}
+
+    template <typename T>
+    typename smoothed_biquad<T>::coefficients_type smoothed_biquad<T>::normalize(const biquad<T>& filter) noexcept {
+        const auto a0 = filter.a0();
+        return {{filter.b0() / a0, filter.b1() / a0, filter.b2() / a0, filter.a1() / a0, filter.a2() / a0}};
+    }
+
+    template <typename T>
+    biquad<T> smoothed_biquad<T>::make_biquad(const coefficients_type& coefficients) noexcept {
+        return biquad<T>(1, coefficients[3], coefficients[4], coefficients[0], coefficients[1], coefficients[2]);
+    }
+
+    template <typename T>
+    typename smoothed_biquad<T>::size_type smoothed_biquad<T>::ramp() const noexcept {
+        return ramp_;
+    }
+
+    template <typename T>
+    void smoothed_biquad<T>::set_ramp(size_type ramp) noexcept {
+        ramp_ = ramp;
+    }
+
+    template <typename T>
+    bool smoothed_biquad<T>::ramping() const noexcept {
+        return remaining_ > 0;
+    }
+
+    template <typename T>
+    biquad<T> smoothed_biquad<T>::current() const noexcept {
+        return make_biquad(current_);
+    }
+
+    template <typename T>
+    biquad<T> smoothed_biquad<T>::target() const noexcept {
+        return make_biquad(target_);
+    }
+
+    template <typename T>
+    void smoothed_biquad<T>::set_target(const biquad<T>& target) noexcept {
+        if (ramp_ == 0) {
+            set_coefficients(target);
+            return;
+        }
+
+        target_    = normalize(target);
+        remaining_ = ramp_;
+        for (size_type i = 0; i < step_.size(); ++i) {
+            step_[i] = (target_[i] - current_[i]) / static_cast<T>(ramp_);
+        }
+    }
+
+    template <typename T>
+    void smoothed_biquad<T>::set_coefficients(const biquad<T>& coefficients) noexcept {
+        current_   = normalize(coefficients);
+        target_    = current_;
+        remaining_ = 0;
+    }
+
+    template <typename T>
+    void smoothed_biquad<T>::reset() noexcept {
+        w0_ = 0;
+        w1_ = 0;
+    }
+
+    template <typename T>
+    typename smoothed_biquad<T>::value_type smoothed_biquad<T>::tick(const value_type value) noexcept {
+        if (remaining_ > 0) {
+            --remaining_;
+            if (remaining_ == 0) {
+                current_ = target_;
+            } else {
+                for (size_type i = 0; i < current_.size(); ++i) {
+                    current_[i] += step_[i];
+                }
+            }
+        }
+
+        const auto out = current_[0] * value + w0_;
+        w0_            = current_[1] * value - current_[3] * out + w1_;
+        w1_            = current_[2] * value - current_[4] * out;
+        return out;
+    }
+
+    template <typename T>
+    template <typename InputIt, typename OutputIt>
+    void smoothed_biquad<T>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        const core::denormal_guard guard;
+        const auto offset = core::denormal_offset<value_type>(guard);
+        for (; first != last && remaining_ > 0; ++first, ++d_first) {
+            *d_first = tick(*first + offset);
+        }
+
+        // The coefficients and the state are kept in locals, so the compiler does not reload them after every store
+        const auto b0 = current_[0], b1 = current_[1], b2 = current_[2], a1 = current_[3], a2 = current_[4];
+        auto w0 = w0_, w1 = w1_;
+        for (; first != last; ++first, ++d_first) {
+            const auto value = static_cast<value_type>(*first) + offset;
+            const auto out   = b0 * value + w0;
+            w0               = b1 * value - a1 * out + w1;
+            w1               = b2 * value - a2 * out;
+            *d_first         = out;
+        }
+        w0_ = w0;
+        w1_ = w1;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_SMOOTHED_BIQUAD_HPP
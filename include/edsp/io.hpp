@@ -23,6 +23,13 @@
 #ifndef EDSP_IO_HPP
 #define EDSP_IO_HPP
 
+#include <edsp/io/asrc.hpp>
+#include <edsp/io/async_decoder.hpp>
+#include <edsp/io/cached_reader.hpp>
 #include <edsp/io/decoder.hpp>
+#include <edsp/io/drift_controller.hpp>
+#include <edsp/io/encoder.hpp>
+#include <edsp/io/parallel_decoder.hpp>
+#include <edsp/io/resampler.hpp>
 
 #endif //EDSP_IO_HPP
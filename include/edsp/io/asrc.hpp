@@ -0,0 +1,359 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: asrc.hpp
+* Author: Mohammed Boujemaoui
+* Date: 23/10/18
+*/
+
+#ifndef EDSP_ASRC_HPP
+#define EDSP_ASRC_HPP
+
+#include <edsp/io/resampler.hpp>
+#include <edsp/io/internal/resampler/polyphase_resampler.hpp>
+#include <edsp/algorithm/dot.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/types/ring_buffer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class asrc
+     * @brief Asynchronous sample-rate converter, a resampler whose ratio can change while it is running.
+     *
+     * It is meant to bridge two clock domains running at nominally related rates (a capture device and a playback
+     * device, a network stream and the local clock...). The input is pushed as it arrives and the output is pulled
+     * when it is needed, and the ratio is corrected over time to follow the drift between both clocks, usually with a
+     * drift_controller fed by the buffer level available().
+     *
+     * The read position is kept in 32.32 fixed point, so a change of ratio never resets the phase. Every change is
+     * applied through a one-pole smoother, one output frame at a time, to avoid audible steps in the pitch. The output
+     * sample is computed from a table of 256 filter phases, linearly interpolated at the exact fractional position.
+     * The phases are designed for the nominal ratio, and designed again by set_ratio when the cutoff frequency of the
+     * new ratio moves by more than 1%. The length of the kernel is the one of the nominal ratio.
+     *
+     * The input and output data are interleaved. Every channel keeps its input frames in a ring_buffer, so consumed
+     * frames are dropped without moving the others. No memory is allocated after construction.
+     *
+     * @note push and pull are not synchronized. If they are called from different threads, the caller must serialize
+     * the calls.
+     */
+    template <typename T>
+    struct asrc {
+        using value_type = T;
+        using size_type  = long;
+
+        /**
+         * @brief Creates an asynchronous resampler with the given configuration.
+         * @param channels Number of channels.
+         * @param ratio Nominal resampling factor (output samplerate / input samplerate).
+         * @param capacity Maximum number of input frames that can be buffered.
+         * @param quality Quality of the resampling process.
+         */
+        asrc(size_type channels, value_type ratio, size_type capacity, resample_quality quality = sinc_fastest);
+
+        /**
+         * @brief Stores the interleaved elements in the range [first, last) in the internal buffer.
+         *
+         * If there is not enough space, only the first frames are stored.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @return Number of samples stored.
+         */
+        template <typename InputIt>
+        size_type push(InputIt first, InputIt last);
+
+        /**
+         * @brief Computes up to size interleaved samples and stores them in the range beginning at d_first.
+         *
+         * If the internal buffer runs out of input frames, less samples are computed.
+         *
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @param size Number of samples to compute.
+         * @return Number of samples computed in the output range.
+         */
+        template <typename OutputIt>
+        size_type pull(OutputIt d_first, size_type size);
+
+        /**
+         * @brief Returns the number of input frames buffered ahead of the read position.
+         * @return Number of buffered frames.
+         */
+        size_type available() const;
+
+        /**
+         * @brief Returns the maximum number of input frames that can be buffered.
+         * @return Capacity in frames.
+         */
+        size_type capacity() const;
+
+        /**
+         * @brief Returns the number of input frames needed ahead of the read position to compute an output frame.
+         * @return Latency in input frames.
+         */
+        size_type latency() const;
+
+        /**
+         * @brief Updates the resampling factor.
+         *
+         * The factor moves smoothly from the current value to the new one, see set_smoothing. The filter phases are
+         * designed again if the cutoff frequency moves by more than 1%.
+         *
+         * @param ratio Resampling factor (output samplerate / input samplerate).
+         */
+        void set_ratio(value_type ratio);
+
+        /**
+         * @brief Returns the resampling factor applied to the last computed frame.
+         * @return Current resampling factor.
+         */
+        value_type ratio() const;
+
+        /**
+         * @brief Returns the resampling factor requested in the last call to set_ratio.
+         * @return Target resampling factor.
+         */
+        value_type target_ratio() const;
+
+        /**
+         * @brief Sets the time constant of the ratio smoother.
+         * @param frames Time constant in output frames. Zero applies the changes instantly.
+         */
+        void set_smoothing(size_type frames);
+
+        /**
+         * @brief Discards the buffered data and restores the nominal resampling factor.
+         */
+        void reset();
+
+    private:
+        const value_type* phase_coefficients();
+        void advance();
+        void compact();
+        void design(double ratio);
+        size_type fill() const;
+
+        static constexpr std::uint64_t phases  = 256;
+        static constexpr std::uint64_t shift   = 32;
+        static constexpr std::uint64_t one     = std::uint64_t{1} << shift;
+        static constexpr size_type default_tau = 1024;
+
+        size_type channels_{1};
+        int quality_{sinc_fastest};
+        size_type half_{1};
+        size_type taps_{2};
+        size_type capacity_{0};
+        double nominal_{1};
+        double designed_{1};
+        double ratio_{1};
+        double target_{1};
+        double smoothing_{1};
+        std::uint64_t step_{one};
+        std::vector<value_type> table_;
+        std::vector<value_type> coefficients_;
+        std::vector<value_type> window_;
+        std::vector<ring_buffer<value_type>> history_;
+        size_type index_{0};
+        std::uint64_t phase_{0};
+    };
+
+    template <typename T>
+    asrc<T>::asrc(size_type channels, value_type ratio, size_type capacity, resample_quality quality) :
+        channels_(channels),
+        quality_(quality),
+        half_(make_polyphase_kernel(quality, static_cast<double>(ratio)).half),
+        taps_(2 * half_),
+        capacity_(capacity + taps_),
+        nominal_(static_cast<double>(ratio)),
+        table_((phases + 1) * static_cast<std::uint64_t>(taps_)),
+        coefficients_(static_cast<std::size_t>(taps_)),
+        window_(static_cast<std::size_t>(taps_)) {
+        meta::expects(channels > 0, "Expected at least one channel");
+        meta::expects(capacity > 0, "Expected a positive capacity");
+        meta::expects(polyphase_resampler<T>::valid_ratio(ratio), "Resampling factor out of range");
+        history_.reserve(static_cast<std::size_t>(channels));
+        for (size_type channel = 0; channel < channels; ++channel) {
+            history_.emplace_back(static_cast<std::size_t>(capacity_));
+        }
+        design(nominal_);
+        set_smoothing(default_tau);
+        reset();
+    }
+
+    template <typename T>
+    void asrc<T>::design(double ratio) {
+        design_polyphase_table(table_.data(), quality_, ratio, phases, half_);
+        designed_ = ratio;
+    }
+
+    template <typename T>
+    typename asrc<T>::size_type asrc<T>::fill() const {
+        return static_cast<size_type>(history_.front().size());
+    }
+
+    template <typename T>
+    void asrc<T>::reset() {
+        for (auto& history : history_) {
+            history.clear();
+            for (size_type i = 0; i < half_ - 1; ++i) {
+                history.push_back(static_cast<value_type>(0));
+            }
+        }
+        if (designed_ != nominal_) {
+            design(nominal_);
+        }
+        index_  = half_ - 1;
+        phase_  = 0;
+        ratio_  = nominal_;
+        target_ = nominal_;
+        step_   = static_cast<std::uint64_t>(std::llround(static_cast<double>(one) / ratio_));
+    }
+
+    template <typename T>
+    const typename asrc<T>::value_type* asrc<T>::phase_coefficients() {
+        constexpr auto fraction = shift - 8;
+        const auto row          = phase_ >> fraction;
+        const auto weight       = static_cast<value_type>(phase_ & ((std::uint64_t{1} << fraction) - 1)) /
+                            static_cast<value_type>(std::uint64_t{1} << fraction);
+        const auto* lower = table_.data() + row * taps_;
+        const auto* upper = lower + taps_;
+        for (size_type j = 0; j < taps_; ++j) {
+            coefficients_[j] = lower[j] + weight * (upper[j] - lower[j]);
+        }
+        return coefficients_.data();
+    }
+
+    template <typename T>
+    void asrc<T>::advance() {
+        if (ratio_ != target_) {
+            ratio_ += smoothing_ * (target_ - ratio_);
+            if (std::abs(target_ - ratio_) <= 1e-12 * target_) {
+                ratio_ = target_;
+            }
+            step_ = static_cast<std::uint64_t>(std::llround(static_cast<double>(one) / ratio_));
+        }
+
+        phase_ += step_;
+        index_ += static_cast<size_type>(phase_ >> shift);
+        phase_ &= one - 1;
+    }
+
+    template <typename T>
+    void asrc<T>::compact() {
+        const auto discard = std::min(index_ - half_ + 1, fill());
+        if (discard <= 0) {
+            return;
+        }
+
+        for (auto& history : history_) {
+            for (size_type i = 0; i < discard; ++i) {
+                history.pop_front();
+            }
+        }
+        index_ -= discard;
+    }
+
+    template <typename T>
+    template <typename InputIt>
+    typename asrc<T>::size_type asrc<T>::push(InputIt first, InputIt last) {
+        const auto size = static_cast<size_type>(std::distance(first, last));
+        meta::expects(size % channels_ == 0, "Expected an integer number of frames");
+
+        compact();
+        const auto frames = std::min(size / channels_, capacity_ - fill());
+        for (size_type i = 0; i < frames; ++i) {
+            for (size_type channel = 0; channel < channels_; ++channel, ++first) {
+                history_[channel].push_back(static_cast<value_type>(*first));
+            }
+        }
+        return frames * channels_;
+    }
+
+    template <typename T>
+    template <typename OutputIt>
+    typename asrc<T>::size_type asrc<T>::pull(OutputIt d_first, size_type size) {
+        meta::expects(size % channels_ == 0, "Expected an integer number of frames");
+
+        const auto frames   = size / channels_;
+        size_type generated = 0;
+        while (generated < frames && index_ + half_ < fill()) {
+            const auto* coefficients = phase_coefficients();
+            const auto start         = static_cast<int>(index_ - half_ + 1);
+            for (size_type channel = 0; channel < channels_; ++channel, ++d_first) {
+                // The window may wrap around the end of the ring, so it is gathered before the inner product
+                std::copy_n(history_[channel].begin() + start, taps_, std::begin(window_));
+                *d_first = algorithm::dot(coefficients, coefficients + taps_, window_.data());
+            }
+            advance();
+            ++generated;
+        }
+        compact();
+        return generated * channels_;
+    }
+
+    template <typename T>
+    typename asrc<T>::size_type asrc<T>::available() const {
+        return std::max(fill() - index_, size_type{0});
+    }
+
+    template <typename T>
+    typename asrc<T>::size_type asrc<T>::capacity() const {
+        return capacity_ - taps_;
+    }
+
+    template <typename T>
+    typename asrc<T>::size_type asrc<T>::latency() const {
+        return half_;
+    }
+
+    template <typename T>
+    void asrc<T>::set_ratio(value_type ratio) {
+        meta::expects(polyphase_resampler<T>::valid_ratio(ratio), "Resampling factor out of range");
+        target_ = static_cast<double>(ratio);
+
+        // Small corrections, as the ones of a drift controller, keep the current phases
+        const auto cutoff  = std::min(1.0, target_);
+        const auto current = std::min(1.0, designed_);
+        if (std::abs(cutoff - current) > 0.01 * current) {
+            design(target_);
+        }
+    }
+
+    template <typename T>
+    typename asrc<T>::value_type asrc<T>::ratio() const {
+        return static_cast<value_type>(ratio_);
+    }
+
+    template <typename T>
+    typename asrc<T>::value_type asrc<T>::target_ratio() const {
+        return static_cast<value_type>(target_);
+    }
+
+    template <typename T>
+    void asrc<T>::set_smoothing(size_type frames) {
+        meta::expects(frames >= 0, "Expected a non negative time constant");
+        smoothing_ = (frames == 0) ? 1.0 : 1.0 - std::exp(-1.0 / static_cast<double>(frames));
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_ASRC_HPP
@@ -0,0 +1,427 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: async_decoder.hpp
+* Author: Mohammed Boujemaoui
+* Date: 25/10/18
+*/
+
+#ifndef EDSP_ASYNC_DECODER_HPP
+#define EDSP_ASYNC_DECODER_HPP
+
+#include <edsp/io/decoder.hpp>
+#include <edsp/types/spsc_queue.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class async_decoder
+     * @brief This class implements a decoder that reads the audio file in a background thread.
+     *
+     * The background thread decodes the file ahead of the consumer into a pool of preallocated blocks. The decoded
+     * blocks are handed to the consumer, and returned to the background thread once they have been read, through two
+     * lock-free queues. The number of blocks in the pool bounds how far the decoding runs ahead of the consumer.
+     *
+     * A seek invalidates the blocks decoded before it: they are recycled without being delivered. A mutex is only used
+     * to put a thread to sleep when it has nothing to do, never to access the blocks.
+     *
+     * @note The public interface must be used from a single thread.
+     *
+     * @tparam T Value Type
+     * @tparam N Size of the internal buffer of the underlying decoder.
+     */
+    template <typename T, std::size_t N = 1024>
+    class async_decoder {
+    public:
+        using index_type = std::ptrdiff_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a decoder with the given configuration.
+         * @param block_size Number of samples decoded in each block.
+         * @param depth Number of blocks that can be decoded ahead of the consumer.
+         */
+        explicit async_decoder(index_type block_size = 8192, index_type depth = 4);
+
+        ~async_decoder();
+
+        /**
+         * @brief Opens an audio file and starts decoding it in the background.
+         * @param file_path Path to the file to be opened.
+         * @return true if the file has been opened, false otherwise.
+         */
+        bool open(const edsp::string_view& file_path);
+
+        /**
+         * @brief Stops the background thread and closes the audio file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the there is an audio file opened.
+         */
+        bool is_open() const noexcept;
+
+        /**
+         * @brief Returns the number of samples in the audio file.
+         */
+        index_type samples() const noexcept;
+
+        /**
+         * @brief Returns the number of frames in the audio file.
+         */
+        index_type frames() const noexcept;
+
+        /**
+         * @brief Returns the number of channels in the audio file.
+         */
+        index_type channels() const noexcept;
+
+        /**
+         * @brief Returns the duration of the audio file in seconds.
+         */
+        double duration() const noexcept;
+
+        /**
+         * @brief Returns the sampling rate of the audio file in Hz.
+         */
+        double samplerate() const noexcept;
+
+        /**
+         * @brief Checks if the audio file is seekable.
+         */
+        bool seekable() const noexcept;
+
+        /**
+         * @brief Updates the current frame position.
+         *
+         * The blocks decoded after the previous position are discarded, and the background thread restarts decoding
+         * from the new one. Positions past the end of the file are rejected, as in decoder. The background thread is
+         * the one seeking the file: if the underlying decoder can not reach the new position, the next read returns 0.
+         *
+         * @param position Frame position in the audio track.
+         * @returns On success, returns the requested frame position. On failure, return the value -1
+         */
+        index_type seek(index_type position);
+
+        /**
+         * @brief Returns the frame position of the next sample delivered by read.
+         */
+        index_type current() const noexcept;
+
+        /**
+         * @brief Reads data from the audio file and stores the results in the range [first, last)
+         *
+         * The function waits for the background thread only when there is no decoded block available.
+         *
+         * @param first Output iterator defining the beginning of the output range.
+         * @param last Output iterator defining the ending of the output range.
+         * @return Number of samples read with success. It is less than the size of the range at the end of the file.
+         */
+        template <typename OutputIt>
+        index_type read(OutputIt first, OutputIt last);
+
+    private:
+        struct block {
+            std::vector<T> data;
+            index_type size{0};
+            index_type position{0};
+            std::uint64_t generation{0};
+        };
+
+        void run();
+        void release(block* item);
+        block* acquire();
+
+        decoder<T, N> decoder_{};
+        std::vector<block> pool_;
+        spsc_queue<block*> ready_;
+        spsc_queue<block*> free_;
+        std::thread worker_{};
+        std::mutex mutex_{};
+        std::condition_variable wake_worker_{};
+        std::condition_variable wake_consumer_{};
+        std::atomic<bool> running_{false};
+        std::atomic<std::uint64_t> generation_{0};
+        std::atomic<index_type> seek_position_{0};
+
+        /* Consumer state */
+        block* current_{nullptr};
+        index_type offset_{0};
+        index_type position_{0};
+        index_type block_size_{0};
+        bool finished_{false};
+
+        /* Cached information about the file, the decoder is owned by the background thread while it runs */
+        index_type channels_{0};
+        index_type frames_{0};
+        double samplerate_{0};
+        bool seekable_{false};
+    };
+
+    template <typename T, std::size_t N>
+    async_decoder<T, N>::async_decoder(index_type block_size, index_type depth) :
+        pool_(static_cast<std::size_t>(depth)),
+        ready_(static_cast<std::size_t>(depth)),
+        free_(static_cast<std::size_t>(depth)) {
+        meta::expects(block_size > 0, "Expected a positive block size");
+        meta::expects(depth > 0, "Expected at least one block");
+        for (auto& item : pool_) {
+            item.data.resize(static_cast<std::size_t>(block_size));
+            free_.push(&item);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    async_decoder<T, N>::~async_decoder() {
+        close();
+    }
+
+    template <typename T, std::size_t N>
+    bool async_decoder<T, N>::open(const edsp::string_view& file_path) {
+        close();
+        if (!decoder_.open(file_path)) {
+            return false;
+        }
+
+        channels_   = decoder_.channels();
+        frames_     = decoder_.frames();
+        samplerate_ = decoder_.samplerate();
+        seekable_   = decoder_.seekable();
+
+        // Every block stores an integer number of frames
+        const auto capacity = static_cast<index_type>(pool_.front().data.size());
+        block_size_         = std::max(capacity - capacity % channels_, index_type{0});
+        if (block_size_ == 0) {
+            eWarning() << "The block size is smaller than a frame";
+            decoder_.close();
+            return false;
+        }
+
+        running_ = true;
+        worker_  = std::thread(&async_decoder::run, this);
+        return true;
+    }
+
+    template <typename T, std::size_t N>
+    void async_decoder<T, N>::close() {
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            wake_worker_.notify_one();
+            worker_.join();
+        }
+
+        // The worker is stopped, every block is given back to the pool
+        if (current_ != nullptr) {
+            free_.push(current_);
+            current_ = nullptr;
+        }
+        block* item = nullptr;
+        while (ready_.pop(item)) {
+            free_.push(item);
+        }
+
+        decoder_.close();
+        offset_     = 0;
+        position_   = 0;
+        finished_   = false;
+        channels_   = 0;
+        frames_     = 0;
+        samplerate_ = 0;
+        seekable_   = false;
+    }
+
+    template <typename T, std::size_t N>
+    void async_decoder<T, N>::run() {
+        auto generation  = generation_.load(std::memory_order_acquire);
+        auto end_of_file = false;
+        auto seek_failed = false;
+        while (running_.load(std::memory_order_acquire)) {
+            const auto requested = generation_.load(std::memory_order_acquire);
+            if (requested != generation) {
+                generation  = requested;
+                end_of_file = false;
+                seek_failed = decoder_.seek(seek_position_.load(std::memory_order_acquire)) < 0;
+            }
+
+            block* item = nullptr;
+            if (end_of_file || !free_.pop(item)) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_worker_.wait(lock, [&]() {
+                    return !running_ || generation_.load(std::memory_order_acquire) != generation ||
+                           (!end_of_file && !free_.empty());
+                });
+                continue;
+            }
+
+            // An empty block marks the end of the stream for the consumer, also when the seek failed
+            if (seek_failed) {
+                item->position = seek_position_.load(std::memory_order_acquire);
+                item->size     = 0;
+                seek_failed    = false;
+            } else {
+                item->position = decoder_.current();
+                item->size     = decoder_.read(std::begin(item->data), std::begin(item->data) + block_size_);
+            }
+            item->generation = generation;
+            end_of_file      = item->size < block_size_;
+            ready_.push(item);
+
+            // The consumer checks the ready queue with the mutex held before waiting. Taking it here means the consumer
+            // has either seen this block or is already waiting, so the notification can not be lost.
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            wake_consumer_.notify_one();
+        }
+    }
+
+    template <typename T, std::size_t N>
+    void async_decoder<T, N>::release(block* item) {
+        free_.push(item);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_worker_.notify_one();
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::block* async_decoder<T, N>::acquire() {
+        const auto generation = generation_.load(std::memory_order_relaxed);
+        for (;;) {
+            block* item = nullptr;
+            if (!ready_.pop(item)) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_consumer_.wait(lock, [this]() { return !ready_.empty(); });
+                continue;
+            }
+
+            if (item->generation == generation) {
+                return item;
+            }
+            release(item);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    template <typename OutputIt>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::read(OutputIt first, OutputIt last) {
+        if (!is_open()) {
+            return 0;
+        }
+
+        const auto total = static_cast<index_type>(std::distance(first, last));
+        index_type done  = 0;
+        while (done < total && !finished_) {
+            if (current_ == nullptr) {
+                current_ = acquire();
+                offset_  = 0;
+            }
+
+            const auto count = std::min(total - done, current_->size - offset_);
+            first            = std::copy(std::begin(current_->data) + offset_,
+                              std::begin(current_->data) + offset_ + count, first);
+            offset_ += count;
+            done += count;
+            position_ = current_->position + offset_ / channels_;
+
+            if (offset_ == current_->size) {
+                finished_ = current_->size < block_size_;
+                release(current_);
+                current_ = nullptr;
+            }
+        }
+        return done;
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::seek(index_type position) {
+        if (!is_open() || !seekable_ || position < 0 || position > frames_) {
+            return -1;
+        }
+
+        if (current_ != nullptr) {
+            release(current_);
+            current_ = nullptr;
+        }
+
+        seek_position_.store(position, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+        }
+        wake_worker_.notify_one();
+        position_ = position;
+        finished_ = false;
+        return position;
+    }
+
+    template <typename T, std::size_t N>
+    bool async_decoder<T, N>::is_open() const noexcept {
+        return worker_.joinable();
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::samples() const noexcept {
+        return frames_ * channels_;
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::frames() const noexcept {
+        return frames_;
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::channels() const noexcept {
+        return channels_;
+    }
+
+    template <typename T, std::size_t N>
+    double async_decoder<T, N>::duration() const noexcept {
+        return static_cast<double>(frames_) / samplerate_;
+    }
+
+    template <typename T, std::size_t N>
+    double async_decoder<T, N>::samplerate() const noexcept {
+        return samplerate_;
+    }
+
+    template <typename T, std::size_t N>
+    bool async_decoder<T, N>::seekable() const noexcept {
+        return seekable_;
+    }
+
+    template <typename T, std::size_t N>
+    typename async_decoder<T, N>::index_type async_decoder<T, N>::current() const noexcept {
+        return position_;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_ASYNC_DECODER_HPP
@@ -0,0 +1,459 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: cached_reader.hpp
+* Author: Mohammed Boujemaoui
+* Date: 28/10/18
+*/
+
+#ifndef EDSP_CACHED_READER_HPP
+#define EDSP_CACHED_READER_HPP
+
+#include <edsp/io/decoder.hpp>
+#include <edsp/types/span.hpp>
+#include <edsp/types/string_view.hpp>
+#include <edsp/meta/data.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class cached_reader
+     * @brief This class implements a random-access reader that keeps the recently decoded blocks in memory.
+     *
+     * The files are divided in blocks with a fixed number of frames, starting at multiples of the block size. The
+     * decoded blocks of all the opened files share a least recently used cache, bounded by a memory budget. A read
+     * only decodes the blocks missing from the cache, and reads crossing several blocks are served from all of them.
+     *
+     * When the prefetch is enabled and the blocks of a file are accessed sequentially, a miss decodes the following
+     * blocks with the same seek, so later reads find them in the cache.
+     *
+     * @note The pointers returned by view are invalidated by the next call to read, view or close.
+     *
+     * @tparam T Value Type
+     * @tparam N Size of the internal buffer of the underlying decoders.
+     */
+    template <typename T, std::size_t N = 1024>
+    class cached_reader {
+    public:
+        using index_type = std::ptrdiff_t;
+        using value_type = T;
+        using file_type  = index_type;
+
+        /**
+         * @brief Creates a reader with the given configuration.
+         * @param block_size Number of frames in a block.
+         * @param memory_budget Maximum number of bytes used by the decoded blocks.
+         * @param prefetch Number of blocks decoded ahead on a sequential miss. Zero disables the prefetch.
+         */
+        explicit cached_reader(index_type block_size = 4096, std::size_t memory_budget = 64 << 20,
+                               index_type prefetch = 0);
+
+        /**
+         * @brief Opens an audio file.
+         * @param file_path Path to the file to be opened.
+         * @return Identifier of the file, or -1 if the file could not be opened.
+         */
+        file_type open(const edsp::string_view& file_path);
+
+        /**
+         * @brief Closes an audio file and discards its cached blocks.
+         * @param file Identifier of the file.
+         */
+        void close(file_type file);
+
+        /**
+         * @brief Checks if the identifier refers to an opened file.
+         */
+        bool is_open(file_type file) const noexcept;
+
+        /**
+         * @brief Returns the number of frames in the audio file.
+         */
+        index_type frames(file_type file) const noexcept;
+
+        /**
+         * @brief Returns the number of channels in the audio file.
+         */
+        index_type channels(file_type file) const noexcept;
+
+        /**
+         * @brief Returns the sampling rate of the audio file in Hz.
+         */
+        double samplerate(file_type file) const noexcept;
+
+        /**
+         * @brief Reads the frames starting at the given position.
+         * @param file Identifier of the file.
+         * @param position Frame position of the first frame to be read.
+         * @param output Span where the interleaved samples are stored.
+         * @return Number of samples read with success. It is less than the size of the output at the end of the file.
+         */
+        index_type read(file_type file, index_type position, span<T> output);
+
+        /**
+         * @brief Returns the cached samples of the frames starting at the given position, without copying them.
+         * @param file Identifier of the file.
+         * @param position Frame position of the first frame.
+         * @param frames Number of frames.
+         * @return Span over the interleaved samples, or an empty span if the frames are not stored in the same block.
+         * It is shorter than requested at the end of the file.
+         */
+        span<const T> view(file_type file, index_type position, index_type frames);
+
+        /**
+         * @brief Returns the number of blocks found in the cache.
+         */
+        std::size_t hits() const noexcept;
+
+        /**
+         * @brief Returns the number of blocks decoded because they were not found in the cache.
+         */
+        std::size_t misses() const noexcept;
+
+        /**
+         * @brief Returns the number of blocks decoded ahead of the reads.
+         */
+        std::size_t prefetched() const noexcept;
+
+        /**
+         * @brief Resets the hit, miss and prefetch counters.
+         */
+        void reset_statistics() noexcept;
+
+        /**
+         * @brief Returns the number of bytes used by the decoded blocks.
+         */
+        std::size_t memory_usage() const noexcept;
+
+        /**
+         * @brief Returns the maximum number of bytes used by the decoded blocks.
+         */
+        std::size_t memory_budget() const noexcept;
+
+        /**
+         * @brief Returns the number of frames in a block.
+         */
+        index_type block_size() const noexcept;
+
+        /**
+         * @brief Updates the number of blocks decoded ahead on a sequential miss.
+         */
+        void set_prefetch(index_type prefetch);
+
+        /**
+         * @brief Discards all the cached blocks.
+         */
+        void clear();
+
+    private:
+        struct source {
+            decoder<T, N> handle{};
+            index_type channels{0};
+            index_type frames{0};
+            double samplerate{0};
+            index_type last_block{-1};
+        };
+
+        struct entry {
+            file_type file{0};
+            index_type block{0};
+            std::vector<T> data{};
+            index_type size{0};
+        };
+
+        using list_type = std::list<entry>;
+
+        static std::uint64_t make_key(file_type file, index_type block) noexcept;
+        const entry* fetch(file_type file, index_type block);
+        entry& allocate(file_type file, index_type block, std::size_t samples, const entry* pinned = nullptr);
+        void erase(typename list_type::iterator it);
+
+        std::vector<std::unique_ptr<source>> files_{};
+        list_type entries_{};
+        std::unordered_map<std::uint64_t, typename list_type::iterator> index_{};
+        std::vector<T> spare_{};
+        index_type block_size_{0};
+        std::size_t budget_{0};
+        std::size_t usage_{0};
+        index_type prefetch_{0};
+        std::size_t hits_{0};
+        std::size_t misses_{0};
+        std::size_t prefetched_{0};
+    };
+
+    template <typename T, std::size_t N>
+    cached_reader<T, N>::cached_reader(index_type block_size, std::size_t memory_budget, index_type prefetch) :
+        block_size_(block_size),
+        budget_(memory_budget),
+        prefetch_(prefetch) {
+        meta::expects(block_size > 0, "Expected a positive block size");
+        meta::expects(prefetch >= 0, "Expected a non negative prefetch");
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::file_type cached_reader<T, N>::open(const edsp::string_view& file_path) {
+        auto item = std::unique_ptr<source>(new source());
+        if (!item->handle.open(file_path)) {
+            return -1;
+        }
+
+        item->channels   = item->handle.channels();
+        item->frames     = item->handle.frames();
+        item->samplerate = item->handle.samplerate();
+
+        // The identifiers of the closed files are reused
+        const auto it = std::find(std::begin(files_), std::end(files_), nullptr);
+        if (it != std::end(files_)) {
+            *it = std::move(item);
+            return static_cast<file_type>(std::distance(std::begin(files_), it));
+        }
+        files_.push_back(std::move(item));
+        return static_cast<file_type>(files_.size() - 1);
+    }
+
+    template <typename T, std::size_t N>
+    void cached_reader<T, N>::close(file_type file) {
+        if (!is_open(file)) {
+            return;
+        }
+
+        for (auto it = std::begin(entries_); it != std::end(entries_);) {
+            const auto current = it++;
+            if (current->file == file) {
+                erase(current);
+            }
+        }
+        files_[static_cast<std::size_t>(file)].reset();
+    }
+
+    template <typename T, std::size_t N>
+    bool cached_reader<T, N>::is_open(file_type file) const noexcept {
+        return file >= 0 && static_cast<std::size_t>(file) < files_.size() &&
+               files_[static_cast<std::size_t>(file)] != nullptr;
+    }
+
+    template <typename T, std::size_t N>
+    std::uint64_t cached_reader<T, N>::make_key(file_type file, index_type block) noexcept {
+        return (static_cast<std::uint64_t>(file) << 40) ^ static_cast<std::uint64_t>(block);
+    }
+
+    template <typename T, std::size_t N>
+    void cached_reader<T, N>::erase(typename list_type::iterator it) {
+        usage_ -= it->data.size() * sizeof(T);
+        index_.erase(make_key(it->file, it->block));
+
+        // The storage of the evicted block is kept to decode the next one without allocating
+        spare_.swap(it->data);
+        entries_.erase(it);
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::entry& cached_reader<T, N>::allocate(file_type file, index_type block,
+                                                                        std::size_t samples, const entry* pinned) {
+        // The least recently used blocks are evicted first, except the pinned one
+        const auto bytes = samples * sizeof(T);
+        auto victim      = std::end(entries_);
+        while (victim != std::begin(entries_) && usage_ + bytes > budget_) {
+            const auto current = std::prev(victim);
+            if (&*current == pinned) {
+                victim = current;
+            } else {
+                erase(current);
+            }
+        }
+
+        // A spare storage of another size, from a file with another number of channels, would exceed the budget
+        entries_.emplace_front();
+        auto& item = entries_.front();
+        if (spare_.capacity() == samples) {
+            item.data.swap(spare_);
+        }
+        item.data.resize(samples);
+        item.file  = file;
+        item.block = block;
+        usage_ += item.data.size() * sizeof(T);
+        index_.emplace(make_key(file, block), std::begin(entries_));
+        return item;
+    }
+
+    template <typename T, std::size_t N>
+    const typename cached_reader<T, N>::entry* cached_reader<T, N>::fetch(file_type file, index_type block) {
+        auto& item = *files_[static_cast<std::size_t>(file)];
+        const auto sequential = block == item.last_block + 1;
+        item.last_block       = block;
+
+        const auto found = index_.find(make_key(file, block));
+        if (found != std::end(index_)) {
+            ++hits_;
+            entries_.splice(std::begin(entries_), entries_, found->second);
+            return &entries_.front();
+        }
+
+        ++misses_;
+        const auto blocks  = (item.frames + block_size_ - 1) / block_size_;
+        const auto samples = static_cast<std::size_t>(block_size_ * item.channels);
+        if (item.handle.seek(block * block_size_) < 0) {
+            return nullptr;
+        }
+
+        auto& requested = allocate(file, block, samples);
+        requested.size  = item.handle.read(std::begin(requested.data), std::end(requested.data));
+        const auto it   = std::begin(entries_);
+
+        // The prefetched blocks continue the same read, and never evict the requested one
+        const auto fitting = static_cast<index_type>(budget_ / (samples * sizeof(T))) - 1;
+        const auto ahead   = sequential ? std::min({prefetch_, fitting, blocks - block - 1}) : 0;
+        for (auto current = block + 1; current <= block + ahead; ++current) {
+            if (index_.count(make_key(file, current)) != 0) {
+                break;
+            }
+
+            auto& cached = allocate(file, current, samples, &*it);
+            cached.size  = item.handle.read(std::begin(cached.data), std::end(cached.data));
+            ++prefetched_;
+        }
+
+        // The requested block is the most recently used one
+        entries_.splice(std::begin(entries_), entries_, it);
+        return &entries_.front();
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::index_type cached_reader<T, N>::read(file_type file, index_type position,
+                                                                      span<T> output) {
+        if (!is_open(file) || position < 0) {
+            return 0;
+        }
+
+        const auto channels = files_[static_cast<std::size_t>(file)]->channels;
+        const auto size     = static_cast<index_type>(output.size());
+        meta::expects(size % channels == 0, "Expected an integer number of frames");
+
+        index_type done = 0;
+        while (done < size) {
+            const auto frame  = position + done / channels;
+            const auto cached = fetch(file, frame / block_size_);
+            if (cached == nullptr) {
+                break;
+            }
+
+            const auto offset = (frame % block_size_) * channels;
+            const auto count  = std::min(size - done, cached->size - offset);
+            if (count <= 0) {
+                break;
+            }
+            std::copy(std::begin(cached->data) + offset, std::begin(cached->data) + offset + count,
+                      std::begin(output) + done);
+            done += count;
+        }
+        return done;
+    }
+
+    template <typename T, std::size_t N>
+    span<const T> cached_reader<T, N>::view(file_type file, index_type position, index_type frames) {
+        if (!is_open(file) || position < 0 || frames < 0 ||
+            position / block_size_ != (position + std::max(frames, index_type{1}) - 1) / block_size_) {
+            return {};
+        }
+
+        const auto cached = fetch(file, position / block_size_);
+        if (cached == nullptr) {
+            return {};
+        }
+
+        const auto channels = files_[static_cast<std::size_t>(file)]->channels;
+        const auto offset   = (position % block_size_) * channels;
+        const auto count    = std::max(std::min(frames * channels, cached->size - offset), index_type{0});
+        return span<const T>(meta::data(cached->data) + std::min(offset, cached->size), count);
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::index_type cached_reader<T, N>::frames(file_type file) const noexcept {
+        return is_open(file) ? files_[static_cast<std::size_t>(file)]->frames : 0;
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::index_type cached_reader<T, N>::channels(file_type file) const noexcept {
+        return is_open(file) ? files_[static_cast<std::size_t>(file)]->channels : 0;
+    }
+
+    template <typename T, std::size_t N>
+    double cached_reader<T, N>::samplerate(file_type file) const noexcept {
+        return is_open(file) ? files_[static_cast<std::size_t>(file)]->samplerate : 0;
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t cached_reader<T, N>::hits() const noexcept {
+        return hits_;
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t cached_reader<T, N>::misses() const noexcept {
+        return misses_;
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t cached_reader<T, N>::prefetched() const noexcept {
+        return prefetched_;
+    }
+
+    template <typename T, std::size_t N>
+    void cached_reader<T, N>::reset_statistics() noexcept {
+        hits_       = 0;
+        misses_     = 0;
+        prefetched_ = 0;
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t cached_reader<T, N>::memory_usage() const noexcept {
+        return usage_;
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t cached_reader<T, N>::memory_budget() const noexcept {
+        return budget_;
+    }
+
+    template <typename T, std::size_t N>
+    typename cached_reader<T, N>::index_type cached_reader<T, N>::block_size() const noexcept {
+        return block_size_;
+    }
+
+    template <typename T, std::size_t N>
+    void cached_reader<T, N>::set_prefetch(index_type prefetch) {
+        meta::expects(prefetch >= 0, "Expected a non negative prefetch");
+        prefetch_ = prefetch;
+    }
+
+    template <typename T, std::size_t N>
+    void cached_reader<T, N>::clear() {
+        entries_.clear();
+        index_.clear();
+        spare_ = std::vector<T>();
+        usage_ = 0;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_CACHED_READER_HPP
@@ -25,6 +25,10 @@
 
 #include <edsp/types/string_view.hpp>
 #include <edsp/io/internal/codec/decoder_impl.hpp>
+#include <edsp/algorithm/deinterleave.hpp>
+#include <edsp/meta/data.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
 
 namespace edsp { namespace io {
 
@@ -32,6 +36,10 @@ namespace edsp { namespace io {
      * @class decoder
      * @brief This class implements a decoder object to read data from supported audio files.
      *
+     * The files are decoded by libaudiofile or libsndfile if enabled, or by the memory mapped mmap_decoder otherwise.
+     * Defining USE_MMAP_DECODER selects the mmap_decoder even if a library is enabled, which is faster for
+     * uncompressed files but limited to WAV, AIFF and AIFC.
+     *
      * @tparam T Value Type
      * @tparam N Size of the internal buffer.
      */
@@ -158,6 +166,29 @@ namespace edsp { namespace io {
             return impl_.read(d_first, d_last);
         }
 
+        /**
+         * @brief Attempts to read frames from the audio file and stores every channel in its own range.
+         *
+         * The frames are split into the channels straight from the blocks decoded by the backend, without any other
+         * interleaved copy. With the mmap_decoder, the samples stored as T are split straight from the mapped file.
+         *
+         * @param d_first Input iterator defining the beginning of the range of channel iterators, one per channel.
+         * @param d_last Input iterator defining the ending of the range of channel iterators.
+         * @param frames Maximum number of frames to read.
+         * @return Number of frames read with success.
+         */
+        template <typename ChannelIt>
+        index_type read_planar(ChannelIt d_first, ChannelIt d_last, index_type frames) {
+            const auto channels = impl_.channels();
+            meta::expects(std::distance(d_first, d_last) == channels, "Expected one output per channel");
+
+            index_type done = 0;
+            return impl_.read_blocks(frames, [&](const auto* data, index_type count) {
+                algorithm::internal::deinterleave_frames(data, count, d_first, channels, done);
+                done += count;
+            });
+        }
+
     private:
         decoder_impl<T, N> impl_;
     };
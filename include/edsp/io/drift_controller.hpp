@@ -0,0 +1,144 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: drift_controller.hpp
+* Author: Mohammed Boujemaoui
+* Date: 23/10/18
+*/
+
+#ifndef EDSP_DRIFT_CONTROLLER_HPP
+#define EDSP_DRIFT_CONTROLLER_HPP
+
+#include <edsp/meta/expects.hpp>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class drift_controller
+     * @brief Proportional-integral controller that estimates the clock drift from the level of a buffer.
+     *
+     * The controller compares the number of buffered frames with the desired level, and returns the correction that
+     * should be applied to the nominal resampling factor of an asrc:
+     *
+     * \f[
+     *      c(n) = \frac{1}{1 + k_p e(n) + k_i \sum_{k=0}^{n} e(k)}, \quad e(n) = \frac{f(n) - f_t}{f_t}
+     * \f]
+     *
+     * where \f$ f(n) \f$ is the measured level and \f$ f_t \f$ the target level. A buffer above the target makes the
+     * resampler consume the input faster, and a buffer below the target makes it consume the input slower. The
+     * integral term absorbs the constant drift, so the level settles at the target instead of a fixed offset.
+     *
+     * The deviation is limited to a maximum value, and the integral term stops accumulating while the output is
+     * saturated to avoid wind-up.
+     *
+     * A typical usage is to update it once per processed block:
+     * @code
+     *      converter.set_ratio(nominal * controller.update(converter.available()));
+     * @endcode
+     */
+    template <typename T>
+    struct drift_controller {
+        using value_type = T;
+
+        /**
+         * @brief Creates a controller with the given configuration.
+         * @param target Desired number of buffered frames.
+         * @param kp Proportional gain.
+         * @param ki Integral gain, applied once per update.
+         * @param max_deviation Maximum relative deviation from the nominal factor.
+         */
+        drift_controller(value_type target, value_type kp, value_type ki, value_type max_deviation);
+
+        /**
+         * @brief Updates the controller with a new measurement of the buffer level.
+         * @param fill Number of buffered frames.
+         * @return Correction factor to be applied to the nominal resampling factor.
+         */
+        value_type update(value_type fill);
+
+        /**
+         * @brief Returns the correction factor computed in the last update.
+         * @return Correction factor.
+         */
+        value_type correction() const;
+
+        /**
+         * @brief Returns the desired number of buffered frames.
+         * @return Target level.
+         */
+        value_type target() const;
+
+        /**
+         * @brief Resets the integral term.
+         */
+        void reset();
+
+    private:
+        value_type target_;
+        value_type kp_;
+        value_type ki_;
+        value_type max_deviation_;
+        value_type integral_{0};
+        value_type correction_{1};
+    };
+
+    template <typename T>
+    drift_controller<T>::drift_controller(value_type target, value_type kp, value_type ki, value_type max_deviation) :
+        target_(target),
+        kp_(kp),
+        ki_(ki),
+        max_deviation_(max_deviation) {
+        meta::expects(target > 0, "Expected a positive target level");
+        meta::expects(max_deviation > 0 && max_deviation < 1, "Expected a deviation in the range (0, 1)");
+    }
+
+    template <typename T>
+    typename drift_controller<T>::value_type drift_controller<T>::update(value_type fill) {
+        const auto error    = (fill - target_) / target_;
+        const auto integral = integral_ + ki_ * error;
+        auto deviation      = kp_ * error + integral;
+        if (deviation > max_deviation_) {
+            deviation = max_deviation_;
+        } else if (deviation < -max_deviation_) {
+            deviation = -max_deviation_;
+        } else {
+            integral_ = integral;
+        }
+
+        correction_ = 1 / (1 + deviation);
+        return correction_;
+    }
+
+    template <typename T>
+    typename drift_controller<T>::value_type drift_controller<T>::correction() const {
+        return correction_;
+    }
+
+    template <typename T>
+    typename drift_controller<T>::value_type drift_controller<T>::target() const {
+        return target_;
+    }
+
+    template <typename T>
+    void drift_controller<T>::reset() {
+        integral_   = 0;
+        correction_ = 1;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_DRIFT_CONTROLLER_HPP
@@ -0,0 +1,386 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: encoder.hpp
+* Author: Mohammed Boujemaoui
+* Date: 27/10/18
+*/
+
+#ifndef EDSP_ENCODER_HPP
+#define EDSP_ENCODER_HPP
+
+#include <edsp/io/internal/codec/encoder_impl.hpp>
+#include <edsp/types/spsc_queue.hpp>
+#include <edsp/types/string_view.hpp>
+#include <edsp/core/logger.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class encoder
+     * @brief This class implements an encoder object to write data to WAV files.
+     *
+     * The samples are expected in the range [-1, 1). They are stored in blocks, and every block is converted in bulk
+     * to the resolution of the file, optionally with TPDF dither, before being written.
+     *
+     * In write-behind mode, the blocks are handed to a background thread that converts and writes them, so the thread
+     * calling write only copies the samples. The blocks are allocated when the encoder is created. If the background
+     * thread falls behind and all of them are waiting to be written, write waits for the first one to be released.
+     *
+     * @note The public interface must be used from a single thread.
+     *
+     * @tparam T Value Type
+     */
+    template <typename T>
+    class encoder {
+        static_assert(std::is_floating_point<T>::value, "Expected floating point types");
+
+    public:
+        using index_type = std::ptrdiff_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates an encoder with the given configuration.
+         * @param block_size Number of samples converted at once.
+         * @param depth Number of blocks that can wait for the background thread. Zero disables the write-behind mode.
+         */
+        explicit encoder(index_type block_size = 8192, index_type depth = 0);
+
+        ~encoder();
+
+        /**
+         * @brief Creates an audio file.
+         * @param file_path Path to the file to be created.
+         * @param channels Number of channels.
+         * @param samplerate Sampling rate in Hz.
+         * @param format Encoding of the samples: int16, int24, int32 or float32.
+         * @param dither Enables the TPDF dither for integer encodings.
+         * @return true if the file has been created, false otherwise.
+         */
+        bool open(const edsp::string_view& file_path, index_type channels, double samplerate,
+                  pcm_format format = pcm_format::int16, bool dither = true);
+
+        /**
+         * @brief Writes the pending samples and closes the audio file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the there is an audio file opened.
+         */
+        bool is_open() const noexcept;
+
+        /**
+         * @brief Returns the number of channels of the audio file.
+         */
+        index_type channels() const noexcept;
+
+        /**
+         * @brief Returns the sampling rate of the audio file in Hz.
+         */
+        double samplerate() const noexcept;
+
+        /**
+         * @brief Returns the encoding of the samples in the audio file.
+         */
+        pcm_format format() const noexcept;
+
+        /**
+         * @brief Returns the number of frames written in the audio file, including the pending ones.
+         */
+        index_type frames() const noexcept;
+
+        /**
+         * @brief Writes the interleaved elements in the range [first, last).
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @return Number of samples written.
+         */
+        template <typename InputIt>
+        index_type write(InputIt first, InputIt last);
+
+        /**
+         * @brief Writes the pending samples and waits until the background thread has written all of them.
+         */
+        void flush();
+
+    private:
+        struct block {
+            std::vector<T> data;
+            index_type size{0};
+        };
+
+        void run();
+        void encode(block& item);
+        void submit();
+        block* acquire();
+
+        encoder_impl impl_{};
+        std::vector<block> pool_;
+        spsc_queue<block*> ready_;
+        spsc_queue<block*> free_;
+        std::vector<std::int32_t> integers_;
+        std::vector<float> floats_;
+        tpdf_dither dither_{};
+        bool dithered_{false};
+
+        /* Write-behind state */
+        bool asynchronous_{false};
+        std::thread worker_{};
+        std::mutex mutex_{};
+        std::condition_variable wake_worker_{};
+        std::condition_variable wake_producer_{};
+        std::atomic<bool> running_{false};
+        std::atomic<index_type> pending_{0};
+
+        /* Producer state */
+        block* current_{nullptr};
+        index_type block_size_{0};
+        index_type frames_{0};
+
+        /* Information about the file */
+        index_type channels_{0};
+        double samplerate_{0};
+        pcm_format format_{pcm_format::int16};
+    };
+
+    template <typename T>
+    encoder<T>::encoder(index_type block_size, index_type depth) :
+        pool_(static_cast<std::size_t>(std::max(depth, index_type{1}))),
+        ready_(pool_.size()),
+        free_(pool_.size()),
+        integers_(static_cast<std::size_t>(block_size)),
+        floats_(std::is_same<T, float>::value ? 0 : static_cast<std::size_t>(block_size)),
+        asynchronous_(depth > 0) {
+        meta::expects(block_size > 0, "Expected a positive block size");
+        meta::expects(depth >= 0, "Expected a non negative depth");
+        for (auto& item : pool_) {
+            item.data.resize(static_cast<std::size_t>(block_size));
+            free_.push(&item);
+        }
+    }
+
+    template <typename T>
+    encoder<T>::~encoder() {
+        close();
+    }
+
+    template <typename T>
+    bool encoder<T>::open(const edsp::string_view& file_path, index_type channels, double samplerate,
+                          pcm_format format, bool dither) {
+        close();
+        meta::expects(channels > 0, "Expected at least one channel");
+
+        // Every block stores an integer number of frames
+        const auto capacity = static_cast<index_type>(pool_.front().data.size());
+        block_size_         = capacity - capacity % channels;
+        if (block_size_ == 0) {
+            eWarning() << "The block size is smaller than a frame";
+            return false;
+        }
+
+        if (!impl_.open(file_path, channels, samplerate, format)) {
+            return false;
+        }
+
+        channels_   = channels;
+        samplerate_ = samplerate;
+        format_     = format;
+        dithered_   = dither && format != pcm_format::float32;
+        dither_     = tpdf_dither{};
+        frames_     = 0;
+        if (asynchronous_) {
+            running_ = true;
+            worker_  = std::thread(&encoder::run, this);
+        }
+        return true;
+    }
+
+    template <typename T>
+    void encoder<T>::close() {
+        if (!is_open()) {
+            return;
+        }
+
+        flush();
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            wake_worker_.notify_one();
+            worker_.join();
+        }
+        impl_.close();
+        channels_ = 0;
+    }
+
+    template <typename T>
+    void encoder<T>::encode(block& item) {
+        const auto frames = item.size / channels_;
+        const auto size   = static_cast<std::size_t>(item.size);
+        index_type written;
+        if (format_ != pcm_format::float32) {
+            quantize_pcm(item.data.data(), size, static_cast<int>(8 * pcm_width(format_)), integers_.data(),
+                         dithered_ ? &dither_ : nullptr);
+            written = impl_.write(integers_.data(), frames);
+        } else if (std::is_same<T, float>::value) {
+            written = impl_.write(reinterpret_cast<const float*>(item.data.data()), frames);
+        } else {
+            std::transform(std::begin(item.data), std::begin(item.data) + item.size, std::begin(floats_),
+                           [](const T value) { return static_cast<float>(value); });
+            written = impl_.write(floats_.data(), frames);
+        }
+
+        if (written != frames) {
+            eWarning() << "Could not write " << (frames - written) << " frames";
+        }
+        item.size = 0;
+    }
+
+    template <typename T>
+    void encoder<T>::run() {
+        for (;;) {
+            block* item = nullptr;
+            if (!ready_.pop(item)) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!running_) {
+                    break;
+                }
+                wake_worker_.wait(lock, [this]() { return !running_ || !ready_.empty(); });
+                continue;
+            }
+
+            encode(*item);
+            free_.push(item);
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+
+            // acquire tests the free queue under the mutex, so it can not miss this block between its test and its
+            // wait.
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            wake_producer_.notify_one();
+        }
+    }
+
+    template <typename T>
+    typename encoder<T>::block* encoder<T>::acquire() {
+        block* item = nullptr;
+        while (!free_.pop(item)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_producer_.wait(lock, [this]() { return !free_.empty(); });
+        }
+        return item;
+    }
+
+    template <typename T>
+    void encoder<T>::submit() {
+        if (!asynchronous_) {
+            encode(*current_);
+            free_.push(current_);
+        } else {
+            pending_.fetch_add(1, std::memory_order_acq_rel);
+            ready_.push(current_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            wake_worker_.notify_one();
+        }
+        current_ = nullptr;
+    }
+
+    template <typename T>
+    template <typename InputIt>
+    typename encoder<T>::index_type encoder<T>::write(InputIt first, InputIt last) {
+        if (!is_open()) {
+            return 0;
+        }
+
+        const auto size = static_cast<index_type>(std::distance(first, last));
+        meta::expects(size % channels_ == 0, "Expected an integer number of frames");
+
+        index_type done = 0;
+        while (done < size) {
+            if (current_ == nullptr) {
+                current_ = acquire();
+            }
+
+            const auto count = std::min(size - done, block_size_ - current_->size);
+            const auto next  = std::next(first, count);
+            std::transform(first, next, std::begin(current_->data) + current_->size,
+                           [](const meta::value_type_t<InputIt> value) { return static_cast<T>(value); });
+            first = next;
+            current_->size += count;
+            done += count;
+            if (current_->size == block_size_) {
+                submit();
+            }
+        }
+        frames_ += size / channels_;
+        return size;
+    }
+
+    template <typename T>
+    void encoder<T>::flush() {
+        if (current_ != nullptr && current_->size > 0) {
+            submit();
+        }
+
+        if (asynchronous_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_producer_.wait(lock, [this]() { return pending_.load(std::memory_order_acquire) == 0; });
+        }
+    }
+
+    template <typename T>
+    bool encoder<T>::is_open() const noexcept {
+        return impl_.is_open();
+    }
+
+    template <typename T>
+    typename encoder<T>::index_type encoder<T>::channels() const noexcept {
+        return channels_;
+    }
+
+    template <typename T>
+    double encoder<T>::samplerate() const noexcept {
+        return samplerate_;
+    }
+
+    template <typename T>
+    pcm_format encoder<T>::format() const noexcept {
+        return format_;
+    }
+
+    template <typename T>
+    typename encoder<T>::index_type encoder<T>::frames() const noexcept {
+        return frames_;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_ENCODER_HPP
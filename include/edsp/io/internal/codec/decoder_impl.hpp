@@ -22,22 +22,30 @@
 #ifndef EDSP_DECODER_IMPL_HPP
 #define EDSP_DECODER_IMPL_HPP
 
-#if defined(USE_LIBAUDIOFILE)
+#if defined(USE_MMAP_DECODER)
+#    include <edsp/io/internal/codec/mmap_impl.hpp>
+#elif defined(USE_LIBAUDIOFILE)
 #    include <edsp/io/internal/codec/libaudiofile_impl.hpp>
 #elif defined(USE_LIBSNDFILE)
 #    include <edsp/io/internal/codec/libsndfile_impl.hpp>
+#else
+#    include <edsp/io/internal/codec/mmap_impl.hpp>
 #endif
 
 namespace edsp { namespace io {
 
-#if defined(USE_LIBAUDIOFILE)
+#if defined(USE_MMAP_DECODER)
+    template <typename T, std::size_t N>
+    using decoder_impl = mmap_decoder<T, N>;
+#elif defined(USE_LIBAUDIOFILE)
     template <typename T, std::size_t N>
     using decoder_impl = libaudiofile_decoder<T, N>;
 #elif defined(USE_LIBSNDFILE)
     template <typename T, std::size_t N>
     using decoder_impl = libsndfile_decoder<T, N>;
 #else
-#    error "Compatible library not found!"
+    template <typename T, std::size_t N>
+    using decoder_impl = mmap_decoder<T, N>;
 #endif
 
 }} // namespace edsp::io
@@ -0,0 +1,46 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: encoder_impl.hpp
+* Author: Mohammed Boujemaoui
+* Date: 27/10/18
+*/
+
+#ifndef EDSP_ENCODER_IMPL_HPP
+#define EDSP_ENCODER_IMPL_HPP
+
+#if defined(USE_LIBAUDIOFILE)
+#    include <edsp/io/internal/codec/libaudiofile_impl.hpp>
+#elif defined(USE_LIBSNDFILE)
+#    include <edsp/io/internal/codec/libsndfile_impl.hpp>
+#else
+#    include <edsp/io/internal/codec/wav_impl.hpp>
+#endif
+
+namespace edsp { namespace io {
+
+#if defined(USE_LIBAUDIOFILE)
+    using encoder_impl = libaudiofile_encoder;
+#elif defined(USE_LIBSNDFILE)
+    using encoder_impl = libsndfile_encoder;
+#else
+    using encoder_impl = wav_encoder;
+#endif
+
+}} // namespace edsp::io
+
+#endif //EDSP_ENCODER_IMPL_HPP
@@ -24,11 +24,14 @@
 #define EDSP_AUDIOFILE_IMPL_HPP
 
 #include <edsp/core/logger.hpp>
+#include <edsp/io/internal/codec/pcm.hpp>
+#include <edsp/types/string_view.hpp>
 #include <edsp/meta/is_signed.hpp>
 #include <edsp/meta/advance.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <edsp/meta/data.hpp>
 #include <audiofile.h>
+#include <algorithm>
 #include <cmath>
 
 namespace edsp { namespace io {
@@ -68,6 +71,19 @@ namespace edsp { namespace io {
         template <typename OutputIt>
         index_type read(OutputIt first, OutputIt last);
 
+        /**
+         * @brief Reads up to the given number of frames and passes them to a function in interleaved blocks.
+         *
+         * The function is called as function(data, count), where data points to count interleaved frames decoded in
+         * the internal buffer.
+         *
+         * @param frames Maximum number of frames to read.
+         * @param function Function called with every block.
+         * @return Number of frames read with success.
+         */
+        template <typename Function>
+        index_type read_blocks(index_type frames, Function function);
+
     private:
         void update_format();
 
@@ -200,6 +216,28 @@ namespace edsp { namespace io {
         return total - remaining;
     }
 
+    template <typename T, size_t N>
+    template <typename Function>
+    typename libaudiofile_decoder<T, N>::index_type libaudiofile_decoder<T, N>::read_blocks(index_type frames,
+                                                                                          Function function) {
+        const auto block = static_cast<index_type>(N) / std::max(channels_, index_type{1});
+        index_type done  = 0;
+        while (done < frames && block > 0) {
+            const auto expected = std::min(block, frames - done);
+            const auto count    = static_cast<index_type>(
+                afReadFrames(file_, AF_DEFAULT_TRACK, meta::data(buffer_), static_cast<int>(expected)));
+            if (count <= 0) {
+                break;
+            }
+            function(static_cast<const T*>(meta::data(buffer_)), count);
+            done += count;
+            if (count < expected) {
+                break;
+            }
+        }
+        return done;
+    }
+
     template <typename T, size_t N>
     libaudiofile_decoder<T, N>::~libaudiofile_decoder() {
         close();
@@ -210,6 +248,89 @@ namespace edsp { namespace io {
         return true;
     }
 
+    /**
+     * @class libaudiofile_encoder
+     * @brief Writer of WAV files based in libaudiofile.
+     *
+     * The virtual format of the track is set to the layout produced by the encoder (32 bits integers or floats in the
+     * byte order of the host), and libaudiofile converts it to the resolution of the file.
+     */
+    struct libaudiofile_encoder {
+        using index_type = std::ptrdiff_t;
+
+        libaudiofile_encoder() = default;
+        ~libaudiofile_encoder();
+
+        bool open(const edsp::string_view& filepath, index_type channels, double samplerate, pcm_format format);
+
+        void close();
+
+        bool is_open() const noexcept;
+
+        index_type write(const std::int32_t* data, index_type frames);
+
+        index_type write(const float* data, index_type frames);
+
+    private:
+        /* File descriptor */
+        AFfilehandle file_{AF_NULL_FILEHANDLE};
+    };
+
+    inline libaudiofile_encoder::~libaudiofile_encoder() {
+        close();
+    }
+
+    inline bool libaudiofile_encoder::open(const edsp::string_view& filepath, index_type channels, double samplerate,
+                                           pcm_format format) {
+        close();
+        if (format != pcm_format::int16 && format != pcm_format::int24 && format != pcm_format::int32 &&
+            format != pcm_format::float32) {
+            eWarning() << "Unsupported WAV encoding";
+            return false;
+        }
+
+        const auto floating = format == pcm_format::float32;
+        const auto bits     = static_cast<int>(8 * pcm_width(format));
+        auto setup          = afNewFileSetup();
+        afInitFileFormat(setup, AF_FILE_WAVE);
+        afInitChannels(setup, AF_DEFAULT_TRACK, static_cast<int>(channels));
+        afInitRate(setup, AF_DEFAULT_TRACK, samplerate);
+        afInitSampleFormat(setup, AF_DEFAULT_TRACK, floating ? AF_SAMPFMT_FLOAT : AF_SAMPFMT_TWOSCOMP, bits);
+        file_ = afOpenFile(filepath.data(), "w", setup);
+        afFreeFileSetup(setup);
+        if (file_ == AF_NULL_FILEHANDLE) {
+            eWarning() << "Could not open file " << filepath;
+            return false;
+        }
+
+        const auto order = (native_byte_order() == byte_order::little) ? AF_BYTEORDER_LITTLEENDIAN
+                                                                       : AF_BYTEORDER_BIGENDIAN;
+        afSetVirtualSampleFormat(file_, AF_DEFAULT_TRACK, floating ? AF_SAMPFMT_FLOAT : AF_SAMPFMT_TWOSCOMP, 32);
+        afSetVirtualByteOrder(file_, AF_DEFAULT_TRACK, order);
+        return true;
+    }
+
+    inline void libaudiofile_encoder::close() {
+        if (!is_open()) {
+            return;
+        }
+
+        afCloseFile(file_);
+        file_ = AF_NULL_FILEHANDLE;
+    }
+
+    inline bool libaudiofile_encoder::is_open() const noexcept {
+        return file_ != AF_NULL_FILEHANDLE;
+    }
+
+    inline libaudiofile_encoder::index_type libaudiofile_encoder::write(const std::int32_t* data, index_type frames) {
+        return static_cast<index_type>(afWriteFrames(file_, AF_DEFAULT_TRACK, data, static_cast<int>(frames)));
+    }
+
+    inline libaudiofile_encoder::index_type libaudiofile_encoder::write(const float* data, index_type frames) {
+        return static_cast<index_type>(afWriteFrames(file_, AF_DEFAULT_TRACK, data, static_cast<int>(frames)));
+    }
+
 }} // namespace edsp::io
 
 #endif //EDSP_AUDIOFILE_IMPL_HPP
@@ -24,12 +24,14 @@
 #define EDSP_SNDFILE_IMPL_HPP
 
 #include <edsp/types/string_view.hpp>
+#include <edsp/io/internal/codec/pcm.hpp>
 #include <edsp/core/logger.hpp>
 #include <edsp/meta/is_signed.hpp>
 #include <edsp/meta/advance.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <audiofile.h>
 #include <sndfile.h>
+#include <algorithm>
 #include <cmath>
 #include <edsp/meta/is_null.hpp>
 
@@ -128,6 +130,19 @@ namespace edsp { namespace io {
         template <typename OutputIt>
         index_type read(OutputIt first, OutputIt last);
 
+        /**
+         * @brief Reads up to the given number of frames and passes them to a function in interleaved blocks.
+         *
+         * The function is called as function(data, count), where data points to count interleaved frames decoded in
+         * the internal buffer. Their type is the one read by libsndfile, which may differ from T.
+         *
+         * @param frames Maximum number of frames to read.
+         * @param function Function called with every block.
+         * @return Number of frames read with success.
+         */
+        template <typename Function>
+        index_type read_blocks(index_type frames, Function function);
+
     private:
         using underlying_t = typename reader<T>::value_type;
 
@@ -221,6 +236,30 @@ namespace edsp { namespace io {
         return total - remaining;
     }
 
+    template <typename T, size_t N>
+    template <typename Function>
+    typename libsndfile_decoder<T, N>::index_type libsndfile_decoder<T, N>::read_blocks(index_type frames,
+                                                                                      Function function) {
+        const auto channels = static_cast<index_type>(std::max(info_.channels, 1));
+        const auto block    = static_cast<index_type>(N) / channels;
+        index_type done     = 0;
+        while (done < frames && block > 0) {
+            const auto expected = std::min(block, frames - done);
+            const auto samples  = static_cast<index_type>(
+                internal::reader<T>{}.read(file_, meta::data(buffer_), static_cast<int>(expected * channels)));
+            const auto count = samples / channels;
+            if (count <= 0) {
+                break;
+            }
+            function(static_cast<const underlying_t*>(meta::data(buffer_)), count);
+            done += count;
+            if (count < expected) {
+                break;
+            }
+        }
+        return done;
+    }
+
     template <typename T, size_t N>
     libsndfile_decoder<T, N>::~libsndfile_decoder() {
         close();
@@ -231,6 +270,91 @@ namespace edsp { namespace io {
         return static_cast<bool>(info_.seekable);
     }
 
+    /**
+     * @class libsndfile_encoder
+     * @brief Writer of WAV files based in libsndfile.
+     *
+     * The integer samples are received left-justified in 32 bits, so libsndfile keeps the most significant bits of
+     * every sample without any further conversion.
+     */
+    struct libsndfile_encoder {
+        using index_type = std::ptrdiff_t;
+
+        libsndfile_encoder() = default;
+        ~libsndfile_encoder();
+
+        bool open(const edsp::string_view& filepath, index_type channels, double samplerate, pcm_format format);
+
+        void close();
+
+        bool is_open() const noexcept;
+
+        index_type write(const std::int32_t* data, index_type frames);
+
+        index_type write(const float* data, index_type frames);
+
+    private:
+        /* File descriptor */
+        SNDFILE* file_{nullptr};
+    };
+
+    inline libsndfile_encoder::~libsndfile_encoder() {
+        close();
+    }
+
+    inline bool libsndfile_encoder::open(const edsp::string_view& filepath, index_type channels, double samplerate,
+                                         pcm_format format) {
+        close();
+        SF_INFO info{};
+        info.channels   = static_cast<int>(channels);
+        info.samplerate = static_cast<int>(samplerate);
+        switch (format) {
+            case pcm_format::int16:
+                info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+                break;
+            case pcm_format::int24:
+                info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_24;
+                break;
+            case pcm_format::int32:
+                info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_32;
+                break;
+            case pcm_format::float32:
+                info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+                break;
+            default:
+                eWarning() << "Unsupported WAV encoding";
+                return false;
+        }
+
+        file_ = sf_open(filepath.data(), SFM_WRITE, &info);
+        if (meta::is_null(file_)) {
+            eWarning() << "Could not open file " << filepath;
+            return false;
+        }
+        return true;
+    }
+
+    inline void libsndfile_encoder::close() {
+        if (!is_open()) {
+            return;
+        }
+
+        sf_close(file_);
+        file_ = nullptr;
+    }
+
+    inline bool libsndfile_encoder::is_open() const noexcept {
+        return file_ != nullptr;
+    }
+
+    inline libsndfile_encoder::index_type libsndfile_encoder::write(const std::int32_t* data, index_type frames) {
+        return static_cast<index_type>(sf_writef_int(file_, data, frames));
+    }
+
+    inline libsndfile_encoder::index_type libsndfile_encoder::write(const float* data, index_type frames) {
+        return static_cast<index_type>(sf_writef_float(file_, data, frames));
+    }
+
 }} // namespace edsp::io
 
 #endif //EDSP_SNDFILE_IMPL_HPP
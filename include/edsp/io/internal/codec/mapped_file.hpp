@@ -0,0 +1,202 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: mapped_file.hpp
+* Author: Mohammed Boujemaoui
+* Date: 24/10/18
+*/
+
+#ifndef EDSP_MAPPED_FILE_HPP
+#define EDSP_MAPPED_FILE_HPP
+
+#include <edsp/types/string_view.hpp>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32) || defined(_WIN64)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace edsp { namespace io { inline namespace internal {
+
+    /**
+     * @class mapped_file
+     * @brief Read-only view of a whole file mapped in memory.
+     *
+     * The pages are loaded on demand by the operating system, so opening a file is cheap and the data is never copied
+     * to an user buffer.
+     */
+    class mapped_file {
+    public:
+        mapped_file() = default;
+        ~mapped_file();
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        /**
+         * @brief Maps a file in memory.
+         * @param file_path Path to the file to be mapped.
+         * @return true if the file has been mapped, false otherwise.
+         */
+        bool open(const edsp::string_view& file_path);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if there is a file mapped.
+         * @return true if a file has been mapped.
+         */
+        bool is_open() const noexcept;
+
+        /**
+         * @brief Returns a pointer to the first byte of the file.
+         */
+        const std::uint8_t* data() const noexcept;
+
+        /**
+         * @brief Returns the size of the file in bytes.
+         */
+        std::size_t size() const noexcept;
+
+    private:
+        const std::uint8_t* data_{nullptr};
+        std::size_t size_{0};
+#if defined(_WIN32) || defined(_WIN64)
+        HANDLE file_{INVALID_HANDLE_VALUE};
+        HANDLE mapping_{nullptr};
+#endif
+    };
+
+    inline mapped_file::~mapped_file() {
+        close();
+    }
+
+    inline bool mapped_file::is_open() const noexcept {
+        return data_ != nullptr;
+    }
+
+    inline const std::uint8_t* mapped_file::data() const noexcept {
+        return data_;
+    }
+
+    inline std::size_t mapped_file::size() const noexcept {
+        return size_;
+    }
+
+#if defined(_WIN32) || defined(_WIN64)
+
+    inline bool mapped_file::open(const edsp::string_view& file_path) {
+        close();
+        const std::string path(file_path.data(), file_path.size());
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) {
+            close();
+            return false;
+        }
+
+        data_ = static_cast<const std::uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (data_ == nullptr) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    inline void mapped_file::close() {
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+        data_    = nullptr;
+        size_    = 0;
+        mapping_ = nullptr;
+        file_    = INVALID_HANDLE_VALUE;
+    }
+
+#else
+
+    inline bool mapped_file::open(const edsp::string_view& file_path) {
+        close();
+        const std::string path(file_path.data(), file_path.size());
+        const auto descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return false;
+        }
+
+        struct stat status {};
+        if (::fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+            ::close(descriptor);
+            return false;
+        }
+
+        // The mapping keeps its own reference to the file, so the descriptor is not needed anymore.
+        const auto size    = static_cast<std::size_t>(status.st_size);
+        const auto address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+
+        ::posix_madvise(address, size, POSIX_MADV_SEQUENTIAL);
+        data_ = static_cast<const std::uint8_t*>(address);
+        size_ = size;
+        return true;
+    }
+
+    inline void mapped_file::close() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(data_), size_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+#endif
+
+}}} // namespace edsp::io::internal
+
+#endif //EDSP_MAPPED_FILE_HPP
@@ -0,0 +1,525 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: mmap_impl.hpp
+* Author: Mohammed Boujemaoui
+* Date: 24/10/18
+*/
+
+#ifndef EDSP_MMAP_IMPL_HPP
+#define EDSP_MMAP_IMPL_HPP
+
+#include <edsp/io/internal/codec/mapped_file.hpp>
+#include <edsp/io/internal/codec/pcm.hpp>
+#include <edsp/types/string_view.hpp>
+#include <edsp/types/span.hpp>
+#include <edsp/core/logger.hpp>
+#include <edsp/meta/data.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/is_iterator.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace edsp { namespace io {
+
+    inline namespace internal {
+
+        /**
+         * @brief Description of the samples stored in an uncompressed audio file.
+         */
+        struct pcm_layout {
+            pcm_format format{pcm_format::int16};
+            byte_order order{byte_order::little};
+            std::ptrdiff_t channels{0};
+            double samplerate{0};
+            std::size_t offset{0};
+            std::size_t size{0};
+        };
+
+        inline std::uint32_t read_le(const std::uint8_t* data, std::size_t width) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < width; ++i) {
+                value |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        inline std::uint32_t read_be(const std::uint8_t* data, std::size_t width) {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i < width; ++i) {
+                value = (value << 8) | data[i];
+            }
+            return value;
+        }
+
+        /* 80 bits IEEE-754 extended precision number, used by AIFF to store the sample rate */
+        inline double read_extended(const std::uint8_t* data) {
+            const auto exponent = static_cast<int>(read_be(data, 2) & 0x7FFF);
+            const auto mantissa = (static_cast<std::uint64_t>(read_be(data + 2, 4)) << 32) | read_be(data + 6, 4);
+            const auto value    = std::ldexp(static_cast<double>(mantissa), exponent - 16383 - 63);
+            return (data[0] & 0x80) ? -value : value;
+        }
+
+        inline bool parse_wav(const std::uint8_t* data, std::size_t size, pcm_layout& layout) {
+            if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+                return false;
+            }
+
+            auto found_format = false;
+            for (std::size_t position = 12; position + 8 <= size;) {
+                const auto* chunk = data + position;
+                const auto length = static_cast<std::size_t>(read_le(chunk + 4, 4));
+                const auto body   = position + 8;
+                if (std::memcmp(chunk, "fmt ", 4) == 0 && length >= 16 && body + 16 <= size) {
+                    auto tag          = read_le(chunk + 8, 2);
+                    const auto bits   = read_le(chunk + 22, 2);
+                    layout.channels   = static_cast<std::ptrdiff_t>(read_le(chunk + 10, 2));
+                    layout.samplerate = static_cast<double>(read_le(chunk + 12, 4));
+                    if (tag == 0xFFFE && length >= 40 && body + 40 <= size) {
+                        tag = read_le(chunk + 32, 2);
+                    }
+
+                    if (tag == 1 && bits == 8) {
+                        layout.format = pcm_format::uint8;
+                    } else if (tag == 1 && bits == 16) {
+                        layout.format = pcm_format::int16;
+                    } else if (tag == 1 && bits == 24) {
+                        layout.format = pcm_format::int24;
+                    } else if (tag == 1 && bits == 32) {
+                        layout.format = pcm_format::int32;
+                    } else if (tag == 3 && bits == 32) {
+                        layout.format = pcm_format::float32;
+                    } else if (tag == 3 && bits == 64) {
+                        layout.format = pcm_format::float64;
+                    } else {
+                        eWarning() << "Unsupported WAV encoding " << tag << " with " << bits << " bits";
+                        return false;
+                    }
+                    layout.order = byte_order::little;
+                    found_format = true;
+                } else if (std::memcmp(chunk, "data", 4) == 0) {
+                    // Streamed files may leave the size of the data chunk unset, the data goes up to the end of file
+                    layout.offset = body;
+                    layout.size   = std::min(length, size - body);
+                    return found_format;
+                }
+                position = body + length + (length & 1);
+            }
+            return false;
+        }
+
+        inline bool parse_aiff(const std::uint8_t* data, std::size_t size, pcm_layout& layout) {
+            if (size < 12 || std::memcmp(data, "FORM", 4) != 0) {
+                return false;
+            }
+
+            const auto compressed = std::memcmp(data + 8, "AIFC", 4) == 0;
+            if (!compressed && std::memcmp(data + 8, "AIFF", 4) != 0) {
+                return false;
+            }
+
+            auto found_format = false;
+            for (std::size_t position = 12; position + 8 <= size;) {
+                const auto* chunk = data + position;
+                const auto length = static_cast<std::size_t>(read_be(chunk + 4, 4));
+                const auto body   = position + 8;
+                if (std::memcmp(chunk, "COMM", 4) == 0 && length >= 18 && body + 18 <= size) {
+                    const auto bits   = read_be(chunk + 14, 2);
+                    layout.channels   = static_cast<std::ptrdiff_t>(read_be(chunk + 8, 2));
+                    layout.samplerate = read_extended(chunk + 16);
+                    layout.order      = byte_order::big;
+
+                    const std::uint8_t none[4] = {'N', 'O', 'N', 'E'};
+                    const auto* compression    = (compressed && length >= 22 && body + 22 <= size) ? chunk + 26 : none;
+                    if (std::memcmp(compression, "fl32", 4) == 0 || std::memcmp(compression, "FL32", 4) == 0) {
+                        layout.format = pcm_format::float32;
+                    } else if (std::memcmp(compression, "fl64", 4) == 0 || std::memcmp(compression, "FL64", 4) == 0) {
+                        layout.format = pcm_format::float64;
+                    } else if (std::memcmp(compression, "NONE", 4) != 0 && std::memcmp(compression, "sowt", 4) != 0) {
+                        eWarning() << "Unsupported AIFC compression";
+                        return false;
+                    } else if (bits == 8) {
+                        layout.format = pcm_format::int8;
+                    } else if (bits == 16) {
+                        layout.format = pcm_format::int16;
+                    } else if (bits == 24) {
+                        layout.format = pcm_format::int24;
+                    } else if (bits == 32) {
+                        layout.format = pcm_format::int32;
+                    } else {
+                        eWarning() << "Unsupported AIFF encoding with " << bits << " bits";
+                        return false;
+                    }
+
+                    if (std::memcmp(compression, "sowt", 4) == 0) {
+                        layout.order = byte_order::little;
+                    }
+                    found_format = true;
+                } else if (std::memcmp(chunk, "SSND", 4) == 0 && body + 8 <= size) {
+                    const auto offset = body + 8 + read_be(chunk + 8, 4);
+                    layout.offset     = std::min(offset, size);
+                    layout.size       = std::min(body + length, size) - std::min(offset, body + length);
+                    return found_format;
+                }
+                position = body + length + (length & 1);
+            }
+            return false;
+        }
+
+    } // namespace internal
+
+    /**
+     * @class mmap_decoder
+     * @brief Decoder of uncompressed audio files (WAV, AIFF, AIFC and RAW) based in a memory mapped file.
+     *
+     * The header is parsed once when the file is opened. After that, reading is just a conversion from the mapped pages
+     * to the output, without any intermediate copy in the kernel or in the library. If the samples are stored in the
+     * type T with the byte order of the host, they can be accessed without any copy at all with view().
+     *
+     * Floating-point outputs are normalized to the range [-1, 1), and integer outputs are scaled to their full range.
+     *
+     * Outputs of type T stored contiguously (pointers and std::vector iterators, see meta::is_contiguous_iterator) are
+     * decoded in place. Any other output is decoded through an internal buffer.
+     *
+     * @tparam T Value Type
+     * @tparam N Size of the internal buffer, used when the output range is not contiguous.
+     */
+    template <typename T, std::size_t N = 2048>
+    struct mmap_decoder {
+        static_assert(std::is_floating_point<T>::value || std::is_signed<T>::value, "Expected signed types");
+
+        using index_type = std::ptrdiff_t;
+        using value_type = T;
+
+        mmap_decoder() = default;
+        ~mmap_decoder();
+
+        void close();
+
+        /**
+         * @brief Opens a WAV, AIFF or AIFC file.
+         */
+        bool open(const edsp::string_view& filepath);
+
+        /**
+         * @brief Opens a RAW file, a file without header.
+         * @param filepath Path to the file to be opened.
+         * @param format Encoding of the samples.
+         * @param order Byte order of the samples.
+         * @param channels Number of interleaved channels.
+         * @param samplerate Sampling rate in Hz.
+         * @return true if the file has been opened, false otherwise.
+         */
+        bool open(const edsp::string_view& filepath, pcm_format format, byte_order order, index_type channels,
+                  double samplerate);
+
+        bool is_open() const noexcept;
+
+        index_type samples() const noexcept;
+
+        index_type frames() const noexcept;
+
+        index_type channels() const noexcept;
+
+        double duration() const noexcept;
+
+        double samplerate() const noexcept;
+
+        index_type seek(index_type position) noexcept;
+
+        index_type current() const noexcept;
+
+        bool seekable() const noexcept;
+
+        /**
+         * @brief Returns the encoding of the samples in the file.
+         */
+        pcm_format format() const noexcept;
+
+        /**
+         * @brief Returns the interleaved samples of the file without any conversion.
+         * @return Span over the samples, or an empty span if they are not stored as T in the byte order of the host.
+         */
+        span<const T> view() const noexcept;
+
+        template <typename OutputIt>
+        index_type read(OutputIt first, OutputIt last);
+
+        index_type read(T* first, T* last);
+
+        /**
+         * @brief Reads up to the given number of frames and passes them to a function in interleaved blocks.
+         *
+         * The function is called as function(data, count), where data points to count interleaved frames of type T.
+         * If the samples can be accessed with view(), a single block pointing to the mapped file is passed. Otherwise,
+         * the blocks are decoded in the internal buffer.
+         *
+         * @param frames Maximum number of frames to read.
+         * @param function Function called with every block.
+         * @return Number of frames read with success.
+         */
+        template <typename Function>
+        index_type read_blocks(index_type frames, Function function);
+
+    private:
+        template <typename OutputIt>
+        index_type read(OutputIt first, OutputIt last, std::true_type);
+
+        template <typename OutputIt>
+        index_type read(OutputIt first, OutputIt last, std::false_type);
+
+        bool attach(const pcm_layout& layout);
+        index_type reserve(index_type requested);
+
+        /* Internal buffer used to convert data for non contiguous outputs */
+        std::array<T, N> buffer_{};
+
+        /* Memory mapped file */
+        mapped_file file_{};
+
+        /* Information about the file */
+        pcm_layout layout_{};
+        index_type frames_{0};
+        index_type position_{0};
+    };
+
+    template <typename T, std::size_t N>
+    mmap_decoder<T, N>::~mmap_decoder() {
+        close();
+    }
+
+    template <typename T, std::size_t N>
+    void mmap_decoder<T, N>::close() {
+        file_.close();
+        layout_   = pcm_layout{};
+        frames_   = 0;
+        position_ = 0;
+    }
+
+    template <typename T, std::size_t N>
+    bool mmap_decoder<T, N>::attach(const pcm_layout& layout) {
+        if (layout.channels <= 0 || layout.samplerate <= 0) {
+            eWarning() << "Invalid audio format";
+            close();
+            return false;
+        }
+
+        layout_   = layout;
+        frames_   = static_cast<index_type>(layout.size / (pcm_width(layout.format) * layout.channels));
+        position_ = 0;
+        return true;
+    }
+
+    template <typename T, std::size_t N>
+    bool mmap_decoder<T, N>::open(const edsp::string_view& filepath) {
+        close();
+        if (!file_.open(filepath)) {
+            eWarning() << "Could not open file " << filepath;
+            return false;
+        }
+
+        pcm_layout layout{};
+        if (!parse_wav(file_.data(), file_.size(), layout) && !parse_aiff(file_.data(), file_.size(), layout)) {
+            eWarning() << "Unsupported file " << filepath;
+            close();
+            return false;
+        }
+        return attach(layout);
+    }
+
+    template <typename T, std::size_t N>
+    bool mmap_decoder<T, N>::open(const edsp::string_view& filepath, pcm_format format, byte_order order,
+                                  index_type channels, double samplerate) {
+        close();
+        if (!file_.open(filepath)) {
+            eWarning() << "Could not open file " << filepath;
+            return false;
+        }
+
+        pcm_layout layout{};
+        layout.format     = format;
+        layout.order      = order;
+        layout.channels   = channels;
+        layout.samplerate = samplerate;
+        layout.size       = file_.size();
+        return attach(layout);
+    }
+
+    template <typename T, std::size_t N>
+    bool mmap_decoder<T, N>::is_open() const noexcept {
+        return file_.is_open();
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::samples() const noexcept {
+        return frames_ * layout_.channels;
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::frames() const noexcept {
+        return frames_;
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::channels() const noexcept {
+        return layout_.channels;
+    }
+
+    template <typename T, std::size_t N>
+    double mmap_decoder<T, N>::duration() const noexcept {
+        return static_cast<double>(frames_) / layout_.samplerate;
+    }
+
+    template <typename T, std::size_t N>
+    double mmap_decoder<T, N>::samplerate() const noexcept {
+        return layout_.samplerate;
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::seek(index_type position) noexcept {
+        if (!is_open() || position < 0 || position > frames_) {
+            return -1;
+        }
+        position_ = position;
+        return position_;
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::current() const noexcept {
+        return is_open() ? position_ : -1;
+    }
+
+    template <typename T, std::size_t N>
+    bool mmap_decoder<T, N>::seekable() const noexcept {
+        return is_open();
+    }
+
+    template <typename T, std::size_t N>
+    pcm_format mmap_decoder<T, N>::format() const noexcept {
+        return layout_.format;
+    }
+
+    template <typename T, std::size_t N>
+    span<const T> mmap_decoder<T, N>::view() const noexcept {
+        const auto format = layout_.format;
+        const auto native = (std::is_same<T, float>::value && format == pcm_format::float32) ||
+                            (std::is_same<T, double>::value && format == pcm_format::float64) ||
+                            (std::is_same<T, std::int16_t>::value && format == pcm_format::int16) ||
+                            (std::is_same<T, std::int32_t>::value && format == pcm_format::int32) ||
+                            (std::is_same<T, std::int8_t>::value && format == pcm_format::int8);
+        const auto* data = file_.data() + layout_.offset;
+        if (!is_open() || !native || (layout_.order != native_byte_order() && sizeof(T) > 1) ||
+            reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) {
+            return {};
+        }
+        return span<const T>(reinterpret_cast<const T*>(data), samples());
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::reserve(index_type requested) {
+        const auto available = (frames_ - position_) * layout_.channels;
+        return std::min(requested - requested % std::max(layout_.channels, index_type{1}), available);
+    }
+
+    template <typename T, std::size_t N>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::read(T* first, T* last) {
+        const auto total = reserve(std::distance(first, last));
+        if (total <= 0) {
+            return 0;
+        }
+
+        const auto width = pcm_width(layout_.format);
+        const auto* data = file_.data() + layout_.offset + position_ * layout_.channels * width;
+        decode_pcm(data, layout_.format, layout_.order, static_cast<std::size_t>(total), first);
+        position_ += total / layout_.channels;
+        return total;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename OutputIt>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::read(OutputIt first, OutputIt last) {
+        using direct = std::integral_constant<bool, meta::is_contiguous_iterator<OutputIt>::value &&
+                                                        std::is_same<meta::value_type_t<OutputIt>, T>::value>;
+        return read(first, last, direct{});
+    }
+
+    template <typename T, std::size_t N>
+    template <typename OutputIt>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::read(OutputIt first, OutputIt last, std::true_type) {
+        if (first == last) {
+            return 0;
+        }
+        auto* data = std::addressof(*first);
+        return read(data, data + std::distance(first, last));
+    }
+
+    template <typename T, std::size_t N>
+    template <typename OutputIt>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::read(OutputIt first, OutputIt last, std::false_type) {
+        const auto total = reserve(std::distance(first, last));
+        const auto block = static_cast<index_type>(N) - static_cast<index_type>(N) % layout_.channels;
+        meta::expects(total <= 0 || block > 0, "Expected an internal buffer larger than a frame");
+        index_type done  = 0;
+        while (done < total) {
+            const auto size = std::min(block, total - done);
+            read(meta::data(buffer_), meta::data(buffer_) + size);
+            for (index_type i = 0; i < size; ++i, ++first) {
+                *first = static_cast<meta::value_type_t<OutputIt>>(buffer_[i]);
+            }
+            done += size;
+        }
+        return done;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename Function>
+    typename mmap_decoder<T, N>::index_type mmap_decoder<T, N>::read_blocks(index_type frames, Function function) {
+        if (!is_open()) {
+            return 0;
+        }
+
+        const auto channels = layout_.channels;
+        const auto total    = reserve(frames * channels) / channels;
+        const auto mapped   = view();
+        if (!mapped.empty()) {
+            if (total > 0) {
+                function(mapped.data() + position_ * channels, total);
+                position_ += total;
+            }
+            return total;
+        }
+
+        const auto block = static_cast<index_type>(N) / channels;
+        meta::expects(total <= 0 || block > 0, "Expected an internal buffer larger than a frame");
+        index_type done = 0;
+        while (done < total) {
+            const auto count = std::min(block, total - done);
+            read(meta::data(buffer_), meta::data(buffer_) + count * channels);
+            function(static_cast<const T*>(meta::data(buffer_)), count);
+            done += count;
+        }
+        return done;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_MMAP_IMPL_HPP
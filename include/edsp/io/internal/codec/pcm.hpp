@@ -0,0 +1,291 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: pcm.hpp
+* Author: Mohammed Boujemaoui
+* Date: 24/10/18
+*/
+
+#ifndef EDSP_PCM_HPP
+#define EDSP_PCM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace edsp { namespace io {
+
+    /**
+     * @brief The pcm_format enum represents the encodings of uncompressed audio samples.
+     */
+    enum class pcm_format {
+        uint8,   /*!< Unsigned 8 bits integer, with an offset of 128 */
+        int8,    /*!< Signed 8 bits integer */
+        int16,   /*!< Signed 16 bits integer */
+        int24,   /*!< Signed 24 bits integer, packed in 3 bytes */
+        int32,   /*!< Signed 32 bits integer */
+        float32, /*!< IEEE-754 single precision floating point */
+        float64  /*!< IEEE-754 double precision floating point */
+    };
+
+    /**
+     * @brief The byte_order enum represents the order of the bytes of a sample in memory.
+     */
+    enum class byte_order { little, big };
+
+    /**
+     * @brief Returns the byte order of the host.
+     */
+    constexpr byte_order native_byte_order() noexcept {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        return byte_order::big;
+#else
+        return byte_order::little;
+#endif
+    }
+
+    /**
+     * @brief Returns the number of bytes used to store a sample in the given format.
+     */
+    constexpr std::size_t pcm_width(pcm_format format) noexcept {
+        return (format == pcm_format::uint8 || format == pcm_format::int8)
+                   ? 1
+                   : (format == pcm_format::int16)
+                         ? 2
+                         : (format == pcm_format::int24) ? 3 : (format == pcm_format::float64) ? 8 : 4;
+    }
+
+    inline namespace internal {
+
+        template <typename U, byte_order Order, std::size_t Width>
+        inline U load_pcm(const std::uint8_t* data) noexcept {
+            U value = 0;
+            for (std::size_t i = 0; i < Width; ++i) {
+                value |= static_cast<U>(data[(Order == byte_order::little) ? i : Width - 1 - i]) << (8 * i);
+            }
+            return value;
+        }
+
+        template <typename T, typename U, bool = std::is_floating_point<T>::value>
+        struct pcm_cast {
+            static T apply(U value, T scale) noexcept {
+                return static_cast<T>(value) * scale;
+            }
+        };
+
+        template <typename T, typename U>
+        struct pcm_cast<T, U, false> {
+            static T apply(U value, double scale) noexcept {
+                constexpr auto range = static_cast<double>(std::numeric_limits<T>::max()) + 1;
+                const auto rounded   = std::round(static_cast<double>(value) * scale * range);
+                return static_cast<T>(std::min(std::max(rounded, static_cast<double>(std::numeric_limits<T>::min())),
+                                               static_cast<double>(std::numeric_limits<T>::max())));
+            }
+        };
+
+        template <typename T>
+        using pcm_scale_t = typename std::conditional<std::is_floating_point<T>::value, T, double>::type;
+
+        template <typename T, byte_order Order>
+        inline void decode_pcm_block(const std::uint8_t* data, pcm_format format, std::size_t size, T* d_first) {
+            using scale_t = pcm_scale_t<T>;
+            switch (format) {
+                case pcm_format::uint8:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto value = static_cast<std::int32_t>(data[i]) - 128;
+                        d_first[i]       = pcm_cast<T, std::int32_t>::apply(value, scale_t(1) / 128);
+                    }
+                    break;
+                case pcm_format::int8:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto value = static_cast<std::int32_t>(static_cast<std::int8_t>(data[i]));
+                        d_first[i]       = pcm_cast<T, std::int32_t>::apply(value, scale_t(1) / 128);
+                    }
+                    break;
+                case pcm_format::int16:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto bits  = load_pcm<std::uint32_t, Order, 2>(data + 2 * i);
+                        const auto value = static_cast<std::int32_t>(bits << 16) >> 16;
+                        d_first[i]       = pcm_cast<T, std::int32_t>::apply(value, scale_t(1) / 32768);
+                    }
+                    break;
+                case pcm_format::int24:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto bits  = load_pcm<std::uint32_t, Order, 3>(data + 3 * i);
+                        const auto value = static_cast<std::int32_t>(bits << 8) >> 8;
+                        d_first[i]       = pcm_cast<T, std::int32_t>::apply(value, scale_t(1) / 8388608);
+                    }
+                    break;
+                case pcm_format::int32:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto value = static_cast<std::int32_t>(load_pcm<std::uint32_t, Order, 4>(data + 4 * i));
+                        d_first[i]       = pcm_cast<T, std::int32_t>::apply(value, scale_t(1) / 2147483648.0);
+                    }
+                    break;
+                case pcm_format::float32:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto bits = load_pcm<std::uint32_t, Order, 4>(data + 4 * i);
+                        float value;
+                        std::memcpy(&value, &bits, sizeof(value));
+                        d_first[i] = pcm_cast<T, float>::apply(value, scale_t(1));
+                    }
+                    break;
+                case pcm_format::float64:
+                    for (std::size_t i = 0; i < size; ++i) {
+                        const auto bits = load_pcm<std::uint64_t, Order, 8>(data + 8 * i);
+                        double value;
+                        std::memcpy(&value, &bits, sizeof(value));
+                        d_first[i] = pcm_cast<T, double>::apply(value, scale_t(1));
+                    }
+                    break;
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Converts a block of encoded samples to the type T.
+     *
+     * Floating-point outputs are normalized to the range [-1, 1), and integer outputs are scaled to their full range.
+     * The bytes are composed explicitly, so the conversion does not depend on the alignment of the input or the byte
+     * order of the host, and every loop is simple enough to be vectorized by the compiler.
+     *
+     * @param data Pointer to the encoded samples.
+     * @param format Encoding of the samples.
+     * @param order Byte order of the samples.
+     * @param size Number of samples to convert.
+     * @param d_first Pointer to the beginning of the destination range.
+     */
+    template <typename T>
+    inline void decode_pcm(const std::uint8_t* data, pcm_format format, byte_order order, std::size_t size,
+                           T* d_first) {
+        static_assert(std::is_floating_point<T>::value || std::is_signed<T>::value, "Expected signed types");
+        if (order == byte_order::little) {
+            internal::decode_pcm_block<T, byte_order::little>(data, format, size, d_first);
+        } else {
+            internal::decode_pcm_block<T, byte_order::big>(data, format, size, d_first);
+        }
+    }
+
+    /**
+     * @class tpdf_dither
+     * @brief Generator of triangular probability density function (TPDF) dither.
+     *
+     * Every value is the difference of two independent uniform variables, so it lies in the range (-1, 1) with a
+     * triangular distribution. The values are computed from a hash of the sample index instead of a recursive
+     * generator, so a whole block of noise can be computed in parallel.
+     */
+    class tpdf_dither {
+    public:
+        /**
+         * @brief Creates a dither generator.
+         * @param seed Seed of the sequence.
+         */
+        explicit tpdf_dither(std::uint32_t seed = 0x2545F491) : seed_(seed) {}
+
+        /**
+         * @brief Returns the dither value of the sample index.
+         */
+        float operator()(std::uint32_t index) const noexcept {
+            auto hash = index * 0x9E3779B9u + seed_;
+            hash ^= hash >> 16;
+            hash *= 0x85EBCA6Bu;
+            hash ^= hash >> 13;
+            hash *= 0xC2B2AE35u;
+            hash ^= hash >> 16;
+            const auto first  = static_cast<std::int32_t>(hash & 0xFFFF);
+            const auto second = static_cast<std::int32_t>(hash >> 16);
+            return static_cast<float>(first - second) * (1.0f / 65536);
+        }
+
+        /**
+         * @brief Reserves the indexes of a block of samples.
+         * @param size Number of samples in the block.
+         * @return Index of the first sample of the block.
+         */
+        std::uint32_t reserve(std::size_t size) noexcept {
+            const auto index = counter_;
+            counter_ += static_cast<std::uint32_t>(size);
+            return index;
+        }
+
+    private:
+        std::uint32_t seed_;
+        std::uint32_t counter_{0};
+    };
+
+    inline namespace internal {
+
+        template <typename C, bool Dither, typename T>
+        inline void quantize_pcm_block(const T* data, std::size_t size, int bits, std::int32_t* d_first,
+                                       const tpdf_dither& dither, std::uint32_t index) {
+            const auto scale = static_cast<C>(std::uint64_t{1} << (bits - 1));
+            const auto upper = scale - 1;
+            const auto lower = -scale;
+            const auto shift = static_cast<std::uint32_t>(32 - bits);
+            for (std::size_t i = 0; i < size; ++i) {
+                auto value = static_cast<C>(data[i]) * scale;
+                if (Dither) {
+                    value += static_cast<C>(dither(index + static_cast<std::uint32_t>(i)));
+                }
+                value          = std::min(upper, std::max(lower, value));
+                value          = value + ((value < 0) ? static_cast<C>(-0.5) : static_cast<C>(0.5));
+                const auto raw = static_cast<std::uint32_t>(static_cast<std::int32_t>(value));
+                d_first[i]     = static_cast<std::int32_t>(raw << shift);
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Quantizes a block of floating-point samples to a signed integer resolution.
+     *
+     * The samples are expected in the range [-1, 1). They are scaled to the given number of bits, optionally dithered
+     * with TPDF noise of one LSB, rounded to the nearest integer, clipped and stored left-justified in 32 bits.
+     *
+     * @param data Pointer to the samples.
+     * @param size Number of samples to convert.
+     * @param bits Resolution of the output, between 8 and 32 bits.
+     * @param d_first Pointer to the beginning of the destination range.
+     * @param dither Dither generator, or nullptr to quantize without dither.
+     */
+    template <typename T>
+    inline void quantize_pcm(const T* data, std::size_t size, int bits, std::int32_t* d_first,
+                             tpdf_dither* dither = nullptr) {
+        static_assert(std::is_floating_point<T>::value, "Expected floating point types");
+        const auto index = (dither != nullptr) ? dither->reserve(size) : 0;
+        const auto noise = (dither != nullptr) ? *dither : tpdf_dither{};
+        if (bits > 24) {
+            // A float can not represent every 32 bits level
+            if (dither != nullptr) {
+                internal::quantize_pcm_block<double, true>(data, size, bits, d_first, noise, index);
+            } else {
+                internal::quantize_pcm_block<double, false>(data, size, bits, d_first, noise, index);
+            }
+        } else if (dither != nullptr) {
+            internal::quantize_pcm_block<float, true>(data, size, bits, d_first, noise, index);
+        } else {
+            internal::quantize_pcm_block<float, false>(data, size, bits, d_first, noise, index);
+        }
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_PCM_HPP
@@ -0,0 +1,239 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: wav_impl.hpp
+* Author: Mohammed Boujemaoui
+* Date: 27/10/18
+*/
+
+#ifndef EDSP_WAV_IMPL_HPP
+#define EDSP_WAV_IMPL_HPP
+
+#include <edsp/io/internal/codec/pcm.hpp>
+#include <edsp/types/string_view.hpp>
+#include <edsp/core/logger.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class wav_encoder
+     * @brief Native writer of uncompressed WAV files.
+     *
+     * The samples are received already converted by the encoder, and packed in little endian before being written.
+     * The sizes in the header are updated when the file is closed, and a pad byte is appended to odd sized data.
+     *
+     * Files with more than two channels or more than 16 bits per sample are written as WAVE_FORMAT_EXTENSIBLE.
+     */
+    struct wav_encoder {
+        using index_type = std::ptrdiff_t;
+
+        wav_encoder() = default;
+        ~wav_encoder();
+
+        bool open(const edsp::string_view& filepath, index_type channels, double samplerate, pcm_format format);
+
+        void close();
+
+        bool is_open() const noexcept;
+
+        index_type write(const std::int32_t* data, index_type frames);
+
+        index_type write(const float* data, index_type frames);
+
+    private:
+        bool extensible() const noexcept;
+        bool write_header();
+        std::size_t write_bytes(std::size_t size);
+
+        /* Internal buffer used to pack the samples */
+        std::array<std::uint8_t, 16384> buffer_{};
+
+        /* File descriptor */
+        std::FILE* file_{nullptr};
+
+        /* Information about the file */
+        pcm_format format_{pcm_format::int16};
+        index_type channels_{0};
+        double samplerate_{0};
+        std::uint64_t data_size_{0};
+    };
+
+    inline wav_encoder::~wav_encoder() {
+        close();
+    }
+
+    inline bool wav_encoder::is_open() const noexcept {
+        return file_ != nullptr;
+    }
+
+    inline bool wav_encoder::open(const edsp::string_view& filepath, index_type channels, double samplerate,
+                                  pcm_format format) {
+        close();
+        if (format != pcm_format::int16 && format != pcm_format::int24 && format != pcm_format::int32 &&
+            format != pcm_format::float32) {
+            eWarning() << "Unsupported WAV encoding";
+            return false;
+        }
+
+        const std::string path(filepath.data(), filepath.size());
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_ == nullptr) {
+            eWarning() << "Could not open file " << filepath;
+            return false;
+        }
+
+        format_     = format;
+        channels_   = channels;
+        samplerate_ = samplerate;
+        data_size_  = 0;
+        return write_header();
+    }
+
+    inline bool wav_encoder::extensible() const noexcept {
+        return channels_ > 2 || pcm_width(format_) > 2;
+    }
+
+    inline bool wav_encoder::write_header() {
+        const auto width    = static_cast<std::uint32_t>(pcm_width(format_));
+        const auto channels = static_cast<std::uint32_t>(channels_);
+        const auto rate     = static_cast<std::uint32_t>(samplerate_);
+        const auto tag      = (format_ == pcm_format::float32) ? 3u : 1u;
+        const auto format   = extensible() ? std::uint32_t{40} : std::uint32_t{16};
+        const auto size     = static_cast<std::size_t>(28 + format);
+        const auto limit    = static_cast<std::uint64_t>(0xFFFFFFFF - (size - 8) - 1);
+        const auto data     = static_cast<std::uint32_t>(std::min<std::uint64_t>(data_size_, limit));
+
+        std::uint8_t header[68];
+        const auto put = [&header](std::size_t position, std::uint32_t value, std::size_t size) {
+            for (std::size_t i = 0; i < size; ++i) {
+                header[position + i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        };
+        std::memcpy(header, "RIFF", 4);
+        put(4, static_cast<std::uint32_t>(size - 8) + data + (data & 1), 4);
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        put(16, format, 4);
+        put(20, extensible() ? 0xFFFE : tag, 2);
+        put(22, channels, 2);
+        put(24, rate, 4);
+        put(28, rate * channels * width, 4);
+        put(32, channels * width, 2);
+        put(34, 8 * width, 2);
+        if (extensible()) {
+            // Extension size, valid bits, speakers assigned in the default order and the sub-format GUID
+            static const std::uint8_t guid[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                                  0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+            put(36, 22, 2);
+            put(38, 8 * width, 2);
+            put(40, (channels <= 18) ? (1u << channels) - 1 : 0, 4);
+            put(44, tag, 2);
+            std::memcpy(header + 46, guid, sizeof(guid));
+        }
+        std::memcpy(header + size - 8, "data", 4);
+        put(size - 4, data, 4);
+
+        std::fseek(file_, 0, SEEK_SET);
+        if (std::fwrite(header, 1, size, file_) != size) {
+            eWarning() << "Could not write the WAV header";
+            return false;
+        }
+        std::fseek(file_, 0, SEEK_END);
+        return true;
+    }
+
+    inline void wav_encoder::close() {
+        if (!is_open()) {
+            return;
+        }
+
+        // The chunks are word aligned, the pad byte is not counted in the size of the data chunk
+        if ((data_size_ & 1) != 0) {
+            std::fputc(0, file_);
+        }
+        write_header();
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    inline std::size_t wav_encoder::write_bytes(std::size_t size) {
+        const auto written = std::fwrite(buffer_.data(), 1, size, file_);
+        data_size_ += written;
+        return written;
+    }
+
+    inline wav_encoder::index_type wav_encoder::write(const std::int32_t* data, index_type frames) {
+        const auto width   = pcm_width(format_);
+        const auto shift   = 32 - 8 * width;
+        const auto samples = static_cast<std::size_t>(frames * channels_);
+
+        // The blocks are not aligned to frames, so frames larger than the buffer are written in several blocks
+        const auto per_frame = width * static_cast<std::size_t>(channels_);
+        const auto per_write = buffer_.size() / width;
+
+        std::size_t written = 0;
+        for (std::size_t first = 0; first < samples; first += per_write) {
+            const auto count = std::min(per_write, samples - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto value = static_cast<std::uint32_t>(data[first + i]) >> shift;
+                for (std::size_t j = 0; j < width; ++j) {
+                    buffer_[i * width + j] = static_cast<std::uint8_t>(value >> (8 * j));
+                }
+            }
+
+            const auto done = write_bytes(count * width);
+            written += done;
+            if (done != count * width) {
+                break;
+            }
+        }
+        return static_cast<index_type>(written / per_frame);
+    }
+
+    inline wav_encoder::index_type wav_encoder::write(const float* data, index_type frames) {
+        const auto samples   = static_cast<std::size_t>(frames * channels_);
+        const auto per_frame = 4 * static_cast<std::size_t>(channels_);
+        const auto per_write = buffer_.size() / 4;
+
+        std::size_t written = 0;
+        for (std::size_t first = 0; first < samples; first += per_write) {
+            const auto count = std::min(per_write, samples - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t value;
+                std::memcpy(&value, data + first + i, sizeof(value));
+                for (std::size_t j = 0; j < 4; ++j) {
+                    buffer_[i * 4 + j] = static_cast<std::uint8_t>(value >> (8 * j));
+                }
+            }
+
+            const auto done = write_bytes(count * 4);
+            written += done;
+            if (done != count * 4) {
+                break;
+            }
+        }
+        return static_cast<index_type>(written / per_frame);
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_WAV_IMPL_HPP
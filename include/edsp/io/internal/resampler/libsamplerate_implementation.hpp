@@ -24,9 +24,22 @@
 #define EDSP_LIBSAMPLERATE_IMPL_HPP
 
 #include <edsp/core/logger.hpp>
+#include <edsp/types/span.hpp>
+#include <edsp/types/string_view.hpp>
 #include <samplerate.h>
-
-namespace edsp { namespace io { namespace internal {
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace edsp { namespace io { inline namespace internal {
+
+    /**
+     * @brief Result of a streaming resampling call, measured in interleaved samples.
+     */
+    struct resample_result {
+        long consumed{0}; /*!< Number of input samples read */
+        long produced{0}; /*!< Number of output samples written */
+    };
 
     inline namespace implementation {
         struct libsamplerate_implementation {
@@ -38,9 +51,42 @@ namespace edsp { namespace io { namespace internal {
 
             ~libsamplerate_implementation();
 
+            /**
+             * @brief Resamples the samples in the contiguous range [first, last).
+             *
+             * At most (ceil(frames * factor) + 1) * channels samples are written in the output, where frames is the
+             * number of input frames. The samples that do not fit are held back and written first by the next call.
+             */
             template <typename InputIt, typename OutputIt>
             inline size_type process(InputIt first, InputIt last, OutputIt d_first);
 
+            /**
+             * @brief Resamples the input span into the output span, after writing the samples held back by the
+             * iterator interface.
+             */
+            resample_result process(span<const value_type> input, span<value_type> output, bool end_of_input);
+
+            /**
+             * @brief Stores the samples of the input span resampled at the end of the held back samples.
+             */
+            void feed(span<const value_type> input);
+
+            /**
+             * @brief Writes up to capacity of the held back samples in the output.
+             * @return Number of samples written in the output.
+             */
+            template <typename OutputIt>
+            size_type drain(OutputIt d_first, std::size_t capacity);
+
+            /**
+             * @brief Returns the number of samples that the iterator interface may write for the given input size.
+             */
+            std::size_t capacity(std::size_t input_size) const;
+
+            size_type channels() const;
+
+            value_type factor() const;
+
             int quality() const;
 
             error_type reset();
@@ -52,8 +98,11 @@ namespace edsp { namespace io { namespace internal {
             static bool valid_ratio(value_type ratio);
 
         private:
+            resample_result convert(span<const value_type> input, span<value_type> output, bool end_of_input);
+
             void report_error(const char* function_name);
 
+            std::vector<value_type> held_{};
             SRC_DATA data_{};
             SRC_STATE* state_{nullptr};
             error_type error_{0};
@@ -62,86 +111,200 @@ namespace edsp { namespace io { namespace internal {
             value_type factor_{1};
         };
 
-        libsamplerate_implementation::libsamplerate_implementation(long channels, int quality, value_type factor) :
+        inline libsamplerate_implementation::libsamplerate_implementation(long channels, int quality,
+                                                                          value_type factor) :
             channels_(channels),
             quality_(quality),
             factor_(factor) {
-            const auto quality_value = static_cast<std::underlying_type<int>::type>(quality);
-            state_                   = src_new(quality_value, static_cast<int>(channels), &error_);
+            state_ = src_new(quality, static_cast<int>(channels), &error_);
             report_error(__PRETTY_FUNCTION__);
         }
 
-        libsamplerate_implementation::~libsamplerate_implementation() {
+        inline libsamplerate_implementation::~libsamplerate_implementation() {
             src_delete(state_);
         }
 
         template <typename InputIt, typename OutputIt>
         long libsamplerate_implementation::process(InputIt first, InputIt last, OutputIt d_first) {
-            const auto size         = std::distance(first, last);
-            data_.input_frames      = size / channels_;
-            data_.output_frames     = size / channels_;
-            data_.data_in           = &(*first);
-            data_.data_out          = &(*d_first);
+            const auto size = static_cast<std::size_t>(std::distance(first, last));
+            if (size == 0) {
+                return 0;
+            }
+            feed(span<const value_type>(&(*first), size));
+            return drain(d_first, capacity(size));
+        }
+
+        inline resample_result libsamplerate_implementation::process(span<const value_type> input,
+                                                                     span<value_type> output, bool end_of_input) {
+            const auto held = drain(output.begin(), static_cast<std::size_t>(output.size()));
+            if (held == static_cast<size_type>(output.size())) {
+                return {0, held};
+            }
+            const auto result = convert(input, output.subspan(held), end_of_input);
+            return {result.consumed, result.produced + held};
+        }
+
+        inline void libsamplerate_implementation::feed(span<const value_type> input) {
+            // The samples held back by earlier calls may fill the expected output before consuming all the input, so
+            // the input is resampled until it is consumed and the output that does not fit is held back
+            const auto window = capacity(static_cast<std::size_t>(input.size()));
+            while (!input.empty()) {
+                const auto held = held_.size();
+                held_.resize(held + window);
+                const auto result = convert(input, span<value_type>(held_.data() + held, window), false);
+                held_.resize(held + static_cast<std::size_t>(result.produced));
+                if (result.consumed == 0 && result.produced == 0) {
+                    break;
+                }
+                input = input.subspan(result.consumed);
+            }
+        }
+
+        template <typename OutputIt>
+        long libsamplerate_implementation::drain(OutputIt d_first, std::size_t capacity) {
+            const auto count = std::min(held_.size(), capacity);
+            std::copy(std::cbegin(held_), std::cbegin(held_) + count, d_first);
+            held_.erase(std::begin(held_), std::begin(held_) + count);
+            return static_cast<size_type>(count);
+        }
+
+        inline std::size_t libsamplerate_implementation::capacity(std::size_t input_size) const {
+            const auto channels = static_cast<std::size_t>(channels_);
+            const auto frames   = static_cast<double>(input_size / channels);
+            return static_cast<std::size_t>(std::ceil(frames * static_cast<double>(factor_)) + 1) * channels;
+        }
+
+        inline resample_result libsamplerate_implementation::convert(span<const value_type> input,
+                                                                     span<value_type> output, bool end_of_input) {
+            data_.data_in           = input.data();
+            data_.input_frames      = static_cast<long>(input.size()) / channels_;
+            data_.data_out          = output.data();
+            data_.output_frames     = static_cast<long>(output.size()) / channels_;
             data_.src_ratio         = factor_;
             data_.input_frames_used = 0;
             data_.output_frames_gen = 0;
-            data_.end_of_input      = 0;
+            data_.end_of_input      = end_of_input ? 1 : 0;
             error_                  = src_process(state_, &data_);
             report_error(__PRETTY_FUNCTION__);
-            return data_.output_frames_gen * channels_;
+            return {data_.input_frames_used * channels_, data_.output_frames_gen * channels_};
+        }
+
+        inline long libsamplerate_implementation::channels() const {
+            return channels_;
+        }
+
+        inline float libsamplerate_implementation::factor() const {
+            return factor_;
         }
 
-        int libsamplerate_implementation::quality() const {
+        inline int libsamplerate_implementation::quality() const {
             return quality_;
         }
 
-        int libsamplerate_implementation::reset() {
+        inline int libsamplerate_implementation::reset() {
+            held_.clear();
             error_ = src_reset(state_);
             report_error(__PRETTY_FUNCTION__);
             return error_;
         }
 
-        int libsamplerate_implementation::error() const {
+        inline int libsamplerate_implementation::error() const {
             return error_;
         }
 
-        const char* libsamplerate_implementation::error_string() const {
+        inline const char* libsamplerate_implementation::error_string() const {
             return src_strerror(error_);
         }
 
-        bool libsamplerate_implementation::valid_ratio(float ratio) {
+        inline bool libsamplerate_implementation::valid_ratio(float ratio) {
             return static_cast<bool>(src_is_valid_ratio(ratio));
         }
 
-        void libsamplerate_implementation::report_error(const char* function_name) {
+        inline void libsamplerate_implementation::report_error(const char* function_name) {
             if (error_ != 0) {
-                eError() << "Error while running" << __PRETTY_FUNCTION__ << ":" << error_string();
+                eError() << "Error while running" << function_name << ":" << error_string();
             }
         }
     } // namespace implementation
 
+    /**
+     * @brief Resampler based in libsamplerate for any arithmetic type.
+     *
+     * The samples are converted to float through two conversion buffers allocated on construction, that hold up to
+     * block_size frames. No memory is allocated while processing.
+     */
     template <typename T>
     struct libsamplerate_resampler {
-        using value_type = float;
+        using value_type = T;
         using size_type  = long;
         using error_type = int;
 
-        libsamplerate_resampler(size_type channels, int quality, value_type factor) : impl(channels, quality, factor) {}
+        static constexpr size_type block_size = 1024;
+
+        libsamplerate_resampler(size_type channels, int quality, float factor) :
+            impl(channels, quality, factor),
+            input(static_cast<std::size_t>(block_size * channels)),
+            output(static_cast<std::size_t>(std::ceil(block_size * static_cast<double>(factor)) + 1) *
+                   static_cast<std::size_t>(channels)) {}
 
         ~libsamplerate_resampler() = default;
 
         template <typename InputIt, typename OutputIt>
         inline size_type process(InputIt first, InputIt last, OutputIt d_first) {
             const auto size = static_cast<std::size_t>(std::distance(first, last));
-            input.resize(size);
-            output.resize(size);
-
-            std::copy(first, last, std::begin(input));
-            const auto result = impl.process(std::cbegin(input), std::cend(input), std::begin(output));
-            std::copy(std::cbegin(output), std::cend(output), d_first);
-            return result;
+            while (first != last) {
+                const auto count = std::min(static_cast<std::size_t>(std::distance(first, last)), input.size());
+                std::copy(first, first + count, std::begin(input));
+                first += count;
+                impl.feed(span<const float>(input.data(), count));
+            }
+            return impl.drain(d_first, impl.capacity(size));
         };
 
+        /**
+         * @brief Resamples the interleaved samples in the input span and stores the result in the output span.
+         *
+         * The call stops when the input is consumed or the output is full, so the caller has to feed the remaining
+         * samples again in a later call.
+         *
+         * @param input_data Interleaved input samples.
+         * @param output_data Interleaved output buffer.
+         * @param end_of_input Set to true in the last block of the stream.
+         * @return Number of samples consumed from the input and written in the output.
+         */
+        resample_result process(span<const value_type> input_data, span<value_type> output_data,
+                                bool end_of_input = false) {
+            resample_result total;
+            do {
+                const auto count = std::min(static_cast<std::size_t>(input_data.size()), input.size());
+                std::copy(input_data.begin(), input_data.begin() + count, std::begin(input));
+                const auto last_block = end_of_input && count == static_cast<std::size_t>(input_data.size());
+                const auto available  = std::min(static_cast<std::size_t>(output_data.size()), output.size());
+                const auto result     = impl.process(span<const float>(input.data(), count),
+                                                 span<float>(output.data(), available), last_block);
+                std::copy(std::cbegin(output), std::cbegin(output) + result.produced, output_data.begin());
+                input_data  = input_data.subspan(result.consumed);
+                output_data = output_data.subspan(result.produced);
+                total.consumed += result.consumed;
+                total.produced += result.produced;
+                if (result.consumed == 0 && result.produced == 0) {
+                    break;
+                }
+            } while (!output_data.empty() && (!input_data.empty() || end_of_input));
+            return total;
+        }
+
+        /**
+         * @brief Drains the samples buffered at the end of the stream.
+         *
+         * Call it until it returns zero, then call reset before processing a new stream.
+         * @param output_data Interleaved output buffer.
+         * @return Number of samples written in the output.
+         */
+        size_type flush(span<value_type> output_data) {
+            return process(span<const value_type>(), output_data, true).produced;
+        }
+
         int quality() const {
             return impl.quality();
         }
@@ -158,16 +321,19 @@ namespace edsp { namespace io { namespace internal {
             return impl.error_string();
         }
 
-        static bool valid_ratio(value_type ratio) {
+        static bool valid_ratio(float ratio) {
             return implementation::libsamplerate_implementation::valid_ratio(ratio);
         }
 
     private:
         implementation::libsamplerate_implementation impl;
-        std::vector<typename libsamplerate_implementation::value_type> input;
-        std::vector<typename libsamplerate_implementation::value_type> output;
+        std::vector<float> input;
+        std::vector<float> output;
     };
 
+    /**
+     * @brief Resampler based in libsamplerate working directly over the caller buffers.
+     */
     template <>
     struct libsamplerate_resampler<typename implementation::libsamplerate_implementation::value_type> {
         using value_type = float;
@@ -183,6 +349,43 @@ namespace edsp { namespace io { namespace internal {
             return impl.process(first, last, d_first);
         };
 
+        /**
+         * @brief Resamples the interleaved samples in the input span and stores the result in the output span.
+         *
+         * The data is read and written in place. The call stops when the input is consumed or the output is full, so
+         * the caller has to feed the remaining samples again in a later call.
+         *
+         * @param input Interleaved input samples.
+         * @param output Interleaved output buffer.
+         * @param end_of_input Set to true in the last block of the stream.
+         * @return Number of samples consumed from the input and written in the output.
+         */
+        resample_result process(span<const value_type> input, span<value_type> output, bool end_of_input = false) {
+            resample_result total;
+            do {
+                const auto result = impl.process(input, output, end_of_input);
+                input             = input.subspan(result.consumed);
+                output            = output.subspan(result.produced);
+                total.consumed += result.consumed;
+                total.produced += result.produced;
+                if (result.consumed == 0 && result.produced == 0) {
+                    break;
+                }
+            } while (!output.empty() && (!input.empty() || end_of_input));
+            return total;
+        }
+
+        /**
+         * @brief Drains the samples buffered at the end of the stream.
+         *
+         * Call it until it returns zero, then call reset before processing a new stream.
+         * @param output Interleaved output buffer.
+         * @return Number of samples written in the output.
+         */
+        size_type flush(span<value_type> output) {
+            return process(span<const value_type>(), output, true).produced;
+        }
+
         int quality() const {
             return impl.quality();
         }
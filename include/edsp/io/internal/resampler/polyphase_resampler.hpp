@@ -0,0 +1,523 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: polyphase_resampler.hpp
+* Author: Mohammed Boujemaoui
+* Date: 22/10/18
+*/
+
+#ifndef EDSP_POLYPHASE_RESAMPLER_HPP
+#define EDSP_POLYPHASE_RESAMPLER_HPP
+
+#include <edsp/algorithm/dot.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace edsp { namespace io { inline namespace internal {
+
+    /**
+     * @brief Shape of the interpolation kernel used by the polyphase resamplers.
+     */
+    struct polyphase_kernel {
+        long half;      /*!< Number of taps at each side of the interpolation point */
+        double rolloff; /*!< Cutoff frequency relative to the Nyquist frequency of the slowest rate */
+        double beta;    /*!< Shape factor of the Kaiser window */
+    };
+
+    /**
+     * @brief Returns the interpolation kernel of a resampling quality (see resample_quality).
+     *
+     * When decimating, the cutoff frequency of the windowed-sinc kernels moves down with the ratio, so their length is
+     * scaled by 1 / ratio to keep the same transition band and stop-band attenuation.
+     *
+     * @param quality Quality of the resampling process.
+     * @param ratio Resampling factor (output samplerate / input samplerate).
+     */
+    inline polyphase_kernel make_polyphase_kernel(int quality, double ratio = 1) {
+        const auto scale = [ratio](const long half) {
+            return static_cast<long>(std::ceil(static_cast<double>(half) * std::max(1.0, 1.0 / ratio)));
+        };
+        switch (quality) {
+            case 0:
+                return {scale(64), 0.95, 9.0};
+            case 1:
+                return {scale(32), 0.91, 8.0};
+            case 2:
+                return {scale(8), 0.75, 6.0};
+            default:
+                return {1, 1.0, 0.0};
+        }
+    }
+
+    /**
+     * @brief Computes the filter phases of an interpolation kernel.
+     *
+     * The table stores phases + 1 rows of 2 * half coefficients, where the row p samples the kernel at the fractional
+     * delay p / phases. Every row is normalized to unity gain at DC.
+     *
+     * @param table Pointer to the beginning of the table.
+     * @param quality Quality of the resampling process (see resample_quality).
+     * @param ratio Resampling factor (output samplerate / input samplerate), used to place the cutoff frequency.
+     * @param phases Number of phases.
+     * @param half Number of taps at each side of the interpolation point. Zero uses the length of the kernel for the
+     * given ratio.
+     */
+    template <typename T>
+    inline void design_polyphase_table(T* table, int quality, double ratio, std::uint64_t phases, long half = 0) {
+        auto config = make_polyphase_kernel(quality, ratio);
+        if (half > 0) {
+            config.half = half;
+        }
+        const auto taps = 2 * config.half;
+
+        const auto bessel_i0 = [](const double x) {
+            double sum = 1, term = 1;
+            for (auto k = 1; k < 64 && term > 1e-12 * sum; ++k) {
+                const auto factor = x / (2 * k);
+                term *= factor * factor;
+                sum += term;
+            }
+            return sum;
+        };
+
+        const auto cutoff = config.rolloff * std::min(1.0, ratio);
+        const auto norm   = bessel_i0(config.beta);
+        const auto kernel = [&](const double tau) -> double {
+            if (quality == 3) {
+                return (tau >= 0 && tau < 1) ? 1 : 0;
+            } else if (quality == 4) {
+                return std::max(0.0, 1 - std::abs(tau));
+            }
+            const auto x = tau / static_cast<double>(config.half);
+            if (std::abs(x) > 1) {
+                return 0;
+            }
+            const auto arg  = constants<double>::pi * cutoff * tau;
+            const auto sinc = (tau == 0) ? 1 : std::sin(arg) / arg;
+            return cutoff * sinc * bessel_i0(config.beta * std::sqrt(1 - x * x)) / norm;
+        };
+
+        std::vector<double> row_values(static_cast<std::size_t>(taps));
+        for (std::uint64_t row = 0; row <= phases; ++row) {
+            const auto frac = static_cast<double>(row) / static_cast<double>(phases);
+            double sum      = 0;
+            for (long j = 0; j < taps; ++j) {
+                row_values[j] = kernel(frac + static_cast<double>(config.half - 1 - j));
+                sum += row_values[j];
+            }
+
+            auto* coefficients = table + row * taps;
+            for (long j = 0; j < taps; ++j) {
+                coefficients[j] = static_cast<T>((sum != 0) ? row_values[j] / sum : row_values[j]);
+            }
+        }
+    }
+
+    /**
+     * @class polyphase_resampler
+     * @brief Native sample-rate converter based in a windowed-sinc polyphase filter bank.
+     *
+     * The output sample \f$ n \f$ is placed at the input time \f$ t_n = n / \lambda \f$, where \f$ \lambda \f$ is the
+     * resampling factor (output samplerate / input samplerate), and it is computed as the inner product between the
+     * filter phase of \f$ t_n \f$ and the surrounding input samples.
+     *
+     * If the factor can be expressed as a ratio \f$ L / M \f$ with \f$ L \leq 1024 \f$ (48k - 44.1k, 16k - 48k...),
+     * the \f$ L \f$ phases are precomputed and the conversion is exact. Otherwise, the phases are interpolated from a
+     * table of 256 phases.
+     *
+     * The input and output data are interleaved. Every channel keeps its own history, so the input can be streamed in
+     * blocks of any size without allocating memory after construction.
+     */
+    template <typename T>
+    struct polyphase_resampler {
+        using value_type = T;
+        using size_type  = long;
+        using error_type = int;
+
+        /**
+         * @brief Creates a resampler with the given configuration
+         * @param channels Number of channels.
+         * @param quality  Quality of the resampling process (see resample_quality).
+         * @param factor   Resampling factor (output samplerate / input samplerate)
+         */
+        polyphase_resampler(size_type channels, int quality, value_type factor);
+
+        /**
+         * @brief Creates a resampler converting between two sample rates.
+         * @param channels Number of channels.
+         * @param quality  Quality of the resampling process (see resample_quality).
+         * @param input_samplerate Sample rate of the input data in Hz.
+         * @param output_samplerate Sample rate of the output data in Hz.
+         */
+        polyphase_resampler(size_type channels, int quality, size_type input_samplerate, size_type output_samplerate);
+
+        /**
+         * @brief Resamples the interleaved elements in the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         *
+         * The number of computed samples can be known in advance with output_size.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Number of samples computed in the output range.
+         */
+        template <typename InputIt, typename OutputIt>
+        size_type process(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the remaining samples at the end of the stream and resets the internal state.
+         *
+         * After flushing, the total number of output frames is exactly \f$ \lceil \lambda N \rceil \f$, where N is the
+         * number of input frames.
+         *
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Number of samples computed in the output range.
+         */
+        template <typename OutputIt>
+        size_type flush(OutputIt d_first);
+
+        /**
+         * @brief Returns the number of samples that the next call to process will compute for the given input size.
+         * @param input_size Number of interleaved input samples.
+         * @return Number of interleaved output samples.
+         */
+        size_type output_size(size_type input_size) const;
+
+        /**
+         * @brief Returns the number of input frames needed ahead of an output sample before it can be computed.
+         * @return Latency in input frames.
+         */
+        size_type latency() const;
+
+        /**
+         * @brief Returns the quality used in the resampling process.
+         * @return Resampling quality.
+         */
+        int quality() const;
+
+        /**
+         * @brief Returns the resampling factor.
+         * @return Resampling factor (output samplerate / input samplerate).
+         */
+        value_type factor() const;
+
+        /**
+         * @brief Resets the internal buffers
+         * @return Returns non zero on error.
+         */
+        error_type reset();
+
+        /**
+         * @brief Returns the internal error code.
+         * @return Return non zero on error.
+         */
+        error_type error() const;
+
+        /**
+         * @brief Returns a description of the internal error code.
+         * @return Description of the internal error code.
+         */
+        const char* error_string() const;
+
+        /**
+         * @brief Checks if a ratio is valid
+         * @param ratio Ratio to be tested
+         * @return true if the ratio is valid, false otherwise.
+         */
+        static bool valid_ratio(value_type ratio);
+
+    private:
+        void configure(std::uint64_t up, std::uint64_t down);
+        void design();
+        const value_type* phase_coefficients();
+
+        template <typename OutputIt>
+        size_type produce(OutputIt& d_first, std::int64_t bound);
+
+        void compact();
+
+        static constexpr std::uint64_t max_phases    = 1024;
+        static constexpr std::uint64_t interp_phases = 256;
+        static constexpr size_type block_size        = 1024;
+
+        size_type channels_{1};
+        int quality_{0};
+        value_type factor_{1};
+        bool rational_{true};
+        std::uint64_t denominator_{1};
+        std::uint64_t step_{1};
+        std::uint64_t phases_{1};
+        size_type half_{1};
+        size_type taps_{2};
+        size_type capacity_{0};
+        std::vector<value_type> table_;
+        std::vector<value_type> coefficients_;
+        std::vector<value_type> buffer_;
+        size_type fill_{0};
+        size_type index_{0};
+        std::uint64_t phase_{0};
+        std::int64_t offset_{0};
+        std::int64_t consumed_{0};
+    };
+
+    template <typename T>
+    polyphase_resampler<T>::polyphase_resampler(size_type channels, int quality, value_type factor) :
+        channels_(channels),
+        quality_(quality),
+        factor_(factor) {
+        meta::expects(channels > 0, "Expected at least one channel");
+        meta::expects(valid_ratio(factor), "Resampling factor out of range");
+
+        // Continued fraction expansion, looking for a ratio L / M with a small number of phases
+        const auto target = static_cast<double>(factor);
+        auto x            = target;
+        std::uint64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+        for (auto i = 0; i < 32; ++i) {
+            const auto a  = static_cast<std::uint64_t>(std::floor(x));
+            const auto p2 = a * p1 + p0;
+            const auto q2 = a * q1 + q0;
+            if (p2 > max_phases) {
+                break;
+            }
+            p0 = p1, q0 = q1, p1 = p2, q1 = q2;
+            if (std::abs(static_cast<double>(p1) / static_cast<double>(q1) - target) <= 1e-6 * target) {
+                configure(p1, q1);
+                return;
+            }
+            const auto remainder = x - static_cast<double>(a);
+            if (remainder < 1e-12) {
+                break;
+            }
+            x = 1 / remainder;
+        }
+
+        rational_    = false;
+        denominator_ = std::uint64_t{1} << 32;
+        step_        = static_cast<std::uint64_t>(std::llround(static_cast<double>(denominator_) / target));
+        phases_      = interp_phases;
+        design();
+    }
+
+    template <typename T>
+    polyphase_resampler<T>::polyphase_resampler(size_type channels, int quality, size_type input_samplerate,
+                                                size_type output_samplerate) :
+        channels_(channels),
+        quality_(quality),
+        factor_(static_cast<value_type>(output_samplerate) / static_cast<value_type>(input_samplerate)) {
+        meta::expects(channels > 0, "Expected at least one channel");
+        meta::expects(input_samplerate > 0 && output_samplerate > 0, "Expected positive sample rates");
+        meta::expects(valid_ratio(factor_), "Resampling factor out of range");
+
+        auto a = static_cast<std::uint64_t>(output_samplerate);
+        auto b = static_cast<std::uint64_t>(input_samplerate);
+        while (b != 0) {
+            const auto r = a % b;
+            a            = b;
+            b            = r;
+        }
+
+        const auto up   = static_cast<std::uint64_t>(output_samplerate) / a;
+        const auto down = static_cast<std::uint64_t>(input_samplerate) / a;
+        if (up <= max_phases) {
+            configure(up, down);
+        } else {
+            rational_    = false;
+            denominator_ = std::uint64_t{1} << 32;
+            step_        = (static_cast<std::uint64_t>(input_samplerate) << 32) / output_samplerate;
+            phases_      = interp_phases;
+            design();
+        }
+    }
+
+    template <typename T>
+    void polyphase_resampler<T>::configure(std::uint64_t up, std::uint64_t down) {
+        rational_    = true;
+        denominator_ = up;
+        step_        = down;
+        phases_      = up;
+        design();
+    }
+
+    template <typename T>
+    void polyphase_resampler<T>::design() {
+        const auto ratio = static_cast<double>(denominator_) / static_cast<double>(step_);
+        half_            = make_polyphase_kernel(quality_, ratio).half;
+        taps_            = 2 * half_;
+        capacity_        = taps_ + block_size;
+        table_.resize((phases_ + 1) * static_cast<std::uint64_t>(taps_));
+        coefficients_.resize(static_cast<std::size_t>(taps_));
+        buffer_.resize(static_cast<std::size_t>(channels_ * capacity_));
+        design_polyphase_table(table_.data(), quality_, ratio, phases_);
+        reset();
+    }
+
+    template <typename T>
+    const typename polyphase_resampler<T>::value_type* polyphase_resampler<T>::phase_coefficients() {
+        if (rational_) {
+            return table_.data() + phase_ * taps_;
+        }
+
+        constexpr auto shift = 24;
+        const auto row       = phase_ >> shift;
+        const auto weight    = static_cast<value_type>(phase_ & ((std::uint64_t{1} << shift) - 1)) /
+                            static_cast<value_type>(std::uint64_t{1} << shift);
+        const auto* lower = table_.data() + row * taps_;
+        const auto* upper = lower + taps_;
+        for (size_type j = 0; j < taps_; ++j) {
+            coefficients_[j] = lower[j] + weight * (upper[j] - lower[j]);
+        }
+        return coefficients_.data();
+    }
+
+    template <typename T>
+    template <typename OutputIt>
+    typename polyphase_resampler<T>::size_type polyphase_resampler<T>::produce(OutputIt& d_first,
+                                                                               std::int64_t bound) {
+        size_type generated = 0;
+        while (index_ + half_ < fill_ && offset_ + index_ < bound) {
+            const auto* coefficients = phase_coefficients();
+            const auto* window       = buffer_.data() + (index_ - half_ + 1);
+            for (size_type channel = 0; channel < channels_; ++channel, ++d_first) {
+                const auto* samples = window + channel * capacity_;
+                *d_first            = algorithm::dot(coefficients, coefficients + taps_, samples);
+            }
+
+            phase_ += step_;
+            index_ += static_cast<size_type>(phase_ / denominator_);
+            phase_ %= denominator_;
+            ++generated;
+        }
+        return generated;
+    }
+
+    template <typename T>
+    void polyphase_resampler<T>::compact() {
+        const auto discard = std::min(index_ - half_ + 1, fill_);
+        if (discard <= 0) {
+            return;
+        }
+
+        for (size_type channel = 0; channel < channels_; ++channel) {
+            auto* samples = buffer_.data() + channel * capacity_;
+            std::copy(samples + discard, samples + fill_, samples);
+        }
+        fill_ -= discard;
+        index_ -= discard;
+        offset_ += discard;
+    }
+
+    template <typename T>
+    template <typename InputIt, typename OutputIt>
+    typename polyphase_resampler<T>::size_type polyphase_resampler<T>::process(InputIt first, InputIt last,
+                                                                               OutputIt d_first) {
+        const auto size = static_cast<size_type>(std::distance(first, last));
+        meta::expects(size % channels_ == 0, "Expected an integer number of frames");
+
+        auto frames         = size / channels_;
+        size_type generated = 0;
+        while (frames > 0) {
+            const auto count = std::min(frames, capacity_ - fill_);
+            for (size_type i = 0; i < count; ++i) {
+                for (size_type channel = 0; channel < channels_; ++channel, ++first) {
+                    buffer_[channel * capacity_ + fill_ + i] = static_cast<value_type>(*first);
+                }
+            }
+            fill_ += count;
+            frames -= count;
+            consumed_ += count;
+            generated += produce(d_first, std::numeric_limits<std::int64_t>::max());
+            compact();
+        }
+        return generated * channels_;
+    }
+
+    template <typename T>
+    template <typename OutputIt>
+    typename polyphase_resampler<T>::size_type polyphase_resampler<T>::flush(OutputIt d_first) {
+        const auto padding = std::min(half_, capacity_ - fill_);
+        for (size_type channel = 0; channel < channels_; ++channel) {
+            auto* samples = buffer_.data() + channel * capacity_ + fill_;
+            std::fill(samples, samples + padding, static_cast<value_type>(0));
+        }
+        fill_ += padding;
+
+        const auto generated = produce(d_first, consumed_);
+        reset();
+        return generated * channels_;
+    }
+
+    template <typename T>
+    typename polyphase_resampler<T>::size_type polyphase_resampler<T>::output_size(size_type input_size) const {
+        const auto available = fill_ + input_size / channels_;
+        const auto last      = available - half_ - 1 - index_;
+        if (last < 0) {
+            return 0;
+        }
+        const auto numerator = (static_cast<std::uint64_t>(last) + 1) * denominator_ - phase_;
+        return static_cast<size_type>((numerator + step_ - 1) / step_) * channels_;
+    }
+
+    template <typename T>
+    typename polyphase_resampler<T>::size_type polyphase_resampler<T>::latency() const {
+        return half_;
+    }
+
+    template <typename T>
+    int polyphase_resampler<T>::quality() const {
+        return quality_;
+    }
+
+    template <typename T>
+    typename polyphase_resampler<T>::value_type polyphase_resampler<T>::factor() const {
+        return factor_;
+    }
+
+    template <typename T>
+    typename polyphase_resampler<T>::error_type polyphase_resampler<T>::reset() {
+        std::fill(std::begin(buffer_), std::end(buffer_), static_cast<value_type>(0));
+        fill_     = half_ - 1;
+        index_    = half_ - 1;
+        phase_    = 0;
+        offset_   = -static_cast<std::int64_t>(half_ - 1);
+        consumed_ = 0;
+        return 0;
+    }
+
+    template <typename T>
+    typename polyphase_resampler<T>::error_type polyphase_resampler<T>::error() const {
+        return 0;
+    }
+
+    template <typename T>
+    const char* polyphase_resampler<T>::error_string() const {
+        return "No error";
+    }
+
+    template <typename T>
+    bool polyphase_resampler<T>::valid_ratio(value_type ratio) {
+        return ratio >= static_cast<value_type>(1) / 256 && ratio <= 256;
+    }
+
+}}} // namespace edsp::io::internal
+
+#endif //EDSP_POLYPHASE_RESAMPLER_HPP
@@ -27,18 +27,35 @@
 #    include <edsp/io/internal/resampler/libsamplerate_implementation.hpp>
 #elif defined(USE_LIBRESAMPLE)
 #    include <edsp/io/internal/resampler/libresample_resampler.hpp>
+#else
+#    include <edsp/io/internal/resampler/polyphase_resampler.hpp>
 #endif
+#include <type_traits>
 
 namespace edsp { namespace io { inline namespace internal {
 
 #if defined(USE_LIBSAMPLERATE)
     template <typename T>
     using resampler_impl = libsamplerate_resampler<T>;
+
+    template <typename T>
+    struct is_native_resampler : std::false_type {};
 #elif defined(USE_LIBRESAMPLE)
     template <typename T>
     using resampler_impl = libresample_resampler<T>;
+
+    template <typename T>
+    struct is_native_resampler : std::false_type {};
 #else
-#    error "Compatible library not found!"
+    template <typename T>
+    using resampler_impl = polyphase_resampler<T>;
+
+    /**
+     * @brief Checks if the resampler of the given type is the native polyphase_resampler, the only backend whose
+     * output length is known in advance.
+     */
+    template <typename T>
+    struct is_native_resampler : std::true_type {};
 #endif
 
 }}} // namespace edsp::io::internal
@@ -0,0 +1,317 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: parallel_decoder.hpp
+* Author: Mohammed Boujemaoui
+* Date: 28/10/18
+*/
+
+#ifndef EDSP_PARALLEL_DECODER_HPP
+#define EDSP_PARALLEL_DECODER_HPP
+
+#include <edsp/core/parallel_for.hpp>
+#include <edsp/io/decoder.hpp>
+#include <edsp/types/string_view.hpp>
+#include <edsp/core/logger.hpp>
+#include <edsp/meta/data.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace edsp { namespace io {
+
+    /**
+     * @class parallel_decoder
+     * @brief This class implements a decoder that splits a seekable audio file in chunks decoded by several threads.
+     *
+     * The requested range of frames is divided in chunks with a fixed number of frames. Every thread opens its own
+     * handle to the file, and takes the next pending chunk until all of them have been decoded, so faster threads
+     * decode more chunks. Every chunk is decoded at its own position of the output, so the result is identical to a
+     * sequential read.
+     *
+     * If a chunk cannot be decoded entirely, because a handle cannot be opened or seeked or the file is shorter than
+     * announced, the reads return the number of samples decoded before that chunk and the failing one. The contents
+     * of the output after them are unspecified.
+     *
+     * @tparam T Value Type
+     * @tparam N Size of the internal buffer of the underlying decoders.
+     */
+    template <typename T, std::size_t N = 1024>
+    class parallel_decoder {
+    public:
+        using index_type = std::ptrdiff_t;
+        using value_type = T;
+
+        /**
+         * @brief Creates a decoder with the given configuration.
+         * @param threads Maximum number of threads decoding the file. Zero uses one thread per hardware thread.
+         * @param chunk_size Number of frames decoded at once by a thread.
+         */
+        explicit parallel_decoder(index_type threads = 0, index_type chunk_size = 65536);
+
+        /**
+         * @brief Opens a seekable audio file.
+         * @param file_path Path to the file to be opened.
+         * @return true if the file has been opened, false otherwise.
+         */
+        bool open(const edsp::string_view& file_path);
+
+        /**
+         * @brief Closes the audio file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the there is an audio file opened.
+         */
+        bool is_open() const noexcept;
+
+        /**
+         * @brief Returns the number of samples in the audio file.
+         */
+        index_type samples() const noexcept;
+
+        /**
+         * @brief Returns the number of frames in the audio file.
+         */
+        index_type frames() const noexcept;
+
+        /**
+         * @brief Returns the number of channels in the audio file.
+         */
+        index_type channels() const noexcept;
+
+        /**
+         * @brief Returns the duration of the audio file in seconds.
+         */
+        double duration() const noexcept;
+
+        /**
+         * @brief Returns the sampling rate of the audio file in Hz.
+         */
+        double samplerate() const noexcept;
+
+        /**
+         * @brief Returns the maximum number of threads decoding the file.
+         */
+        index_type threads() const noexcept;
+
+        /**
+         * @brief Returns the number of frames decoded at once by a thread.
+         */
+        index_type chunk_size() const noexcept;
+
+        /**
+         * @brief Reads the frames starting at the given position and stores them in the range [first, last).
+         * @param position Frame position of the first frame to be read.
+         * @param first Random access iterator defining the beginning of the output range.
+         * @param last Random access iterator defining the ending of the output range.
+         * @return Number of samples read with success. It is less than the size of the range at the end of the file, or
+         * if a chunk could not be decoded.
+         */
+        template <typename RandomIt>
+        index_type read(index_type position, RandomIt first, RandomIt last);
+
+        /**
+         * @brief Decodes the given range of frames and calls a function for every chunk.
+         *
+         * The function is called concurrently from several threads with the arguments
+         * (index_type position, const T* first, const T* last), where position is the frame position of the chunk
+         * and [first, last) its interleaved samples. The chunks decoded by a thread are delivered in increasing order.
+         *
+         * @param position Frame position of the first frame to be decoded.
+         * @param frames Number of frames to be decoded.
+         * @param function Function called for every chunk.
+         * @return Number of samples decoded with success before the first chunk that could not be decoded entirely,
+         * included. The function may have been called for chunks after that one.
+         */
+        template <typename Function>
+        index_type for_each(index_type position, index_type frames, Function function);
+
+    private:
+        template <typename Task>
+        index_type dispatch(index_type position, index_type frames, Task task);
+
+        std::string path_{};
+        index_type threads_{0};
+        index_type chunk_size_{0};
+
+        /* Information about the file */
+        bool open_{false};
+        index_type channels_{0};
+        index_type frames_{0};
+        double samplerate_{0};
+    };
+
+    template <typename T, std::size_t N>
+    parallel_decoder<T, N>::parallel_decoder(index_type threads, index_type chunk_size) :
+        threads_(threads > 0 ? threads : std::max(static_cast<index_type>(std::thread::hardware_concurrency()),
+                                                  index_type{1})),
+        chunk_size_(chunk_size) {
+        meta::expects(threads >= 0, "Expected a non negative number of threads");
+        meta::expects(chunk_size > 0, "Expected a positive chunk size");
+    }
+
+    template <typename T, std::size_t N>
+    bool parallel_decoder<T, N>::open(const edsp::string_view& file_path) {
+        close();
+        decoder<T, N> probe;
+        if (!probe.open(file_path)) {
+            return false;
+        }
+
+        if (!probe.seekable()) {
+            eWarning() << "The file " << file_path << " is not seekable";
+            return false;
+        }
+
+        path_.assign(file_path.data(), file_path.size());
+        channels_   = probe.channels();
+        frames_     = probe.frames();
+        samplerate_ = probe.samplerate();
+        open_       = true;
+        return true;
+    }
+
+    template <typename T, std::size_t N>
+    void parallel_decoder<T, N>::close() {
+        path_.clear();
+        open_       = false;
+        channels_   = 0;
+        frames_     = 0;
+        samplerate_ = 0;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename Task>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::dispatch(index_type position,
+                                                                                 index_type frames, Task task) {
+        if (!is_open() || position < 0 || position >= frames_ || frames <= 0) {
+            return 0;
+        }
+
+        const auto last   = std::min(position + frames, frames_);
+        const auto chunks = (last - position + chunk_size_ - 1) / chunk_size_;
+
+        // Every worker decodes the chunks it takes with its own handle to the file
+        std::vector<index_type> decoded(static_cast<std::size_t>(chunks), 0);
+        parallel_for(static_cast<std::size_t>(chunks), static_cast<std::size_t>(threads_), [&]() {
+            auto local = std::unique_ptr<decoder<T, N>>(new decoder<T, N>());
+            if (!local->open(path_)) {
+                eWarning() << "Could not open the file " << path_;
+            }
+            return [&, local = std::move(local), scratch = std::vector<T>()](std::size_t chunk) mutable {
+                const auto start = position + static_cast<index_type>(chunk) * chunk_size_;
+                const auto count = std::min(chunk_size_, last - start);
+                if (!local->is_open()) {
+                    return;
+                }
+                if (local->seek(start) != start) {
+                    eWarning() << "Could not seek to frame " << start;
+                    return;
+                }
+                decoded[chunk] = task(*local, scratch, start, count);
+            };
+        });
+
+        // The output is only valid up to the first chunk not decoded entirely
+        index_type total = 0;
+        for (auto chunk = index_type{0}; chunk < chunks; ++chunk) {
+            const auto expected = std::min(chunk_size_, last - position - chunk * chunk_size_) * channels_;
+            total += decoded[static_cast<std::size_t>(chunk)];
+            if (decoded[static_cast<std::size_t>(chunk)] != expected) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename RandomIt>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::read(index_type position, RandomIt first,
+                                                                             RandomIt last) {
+        const auto size = static_cast<index_type>(std::distance(first, last));
+        meta::expects(!is_open() || size % channels_ == 0, "Expected an integer number of frames");
+        return dispatch(position, is_open() ? size / channels_ : 0,
+                        [this, first, position](decoder<T, N>& local, std::vector<T>&, index_type start, index_type count) {
+                            const auto output = first + (start - position) * channels_;
+                            return local.read(output, output + count * channels_);
+                        });
+    }
+
+    template <typename T, std::size_t N>
+    template <typename Function>
+    typename parallel_decoder<T, N>::index_type
+        parallel_decoder<T, N>::for_each(index_type position, index_type frames, Function function) {
+        // Every thread decodes into its own buffer, allocated the first time it decodes a chunk
+        return dispatch(position, frames,
+                        [this, &function](decoder<T, N>& local, std::vector<T>& buffer, index_type start,
+                                          index_type count) {
+                            buffer.resize(static_cast<std::size_t>(chunk_size_ * channels_));
+                            const auto data    = meta::data(buffer);
+                            const auto samples = local.read(data, data + count * channels_);
+                            function(start, static_cast<const T*>(data), static_cast<const T*>(data + samples));
+                            return samples;
+                        });
+    }
+
+    template <typename T, std::size_t N>
+    bool parallel_decoder<T, N>::is_open() const noexcept {
+        return open_;
+    }
+
+    template <typename T, std::size_t N>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::samples() const noexcept {
+        return frames_ * channels_;
+    }
+
+    template <typename T, std::size_t N>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::frames() const noexcept {
+        return frames_;
+    }
+
+    template <typename T, std::size_t N>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::channels() const noexcept {
+        return channels_;
+    }
+
+    template <typename T, std::size_t N>
+    double parallel_decoder<T, N>::duration() const noexcept {
+        return static_cast<double>(frames_) / samplerate_;
+    }
+
+    template <typename T, std::size_t N>
+    double parallel_decoder<T, N>::samplerate() const noexcept {
+        return samplerate_;
+    }
+
+    template <typename T, std::size_t N>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::threads() const noexcept {
+        return threads_;
+    }
+
+    template <typename T, std::size_t N>
+    typename parallel_decoder<T, N>::index_type parallel_decoder<T, N>::chunk_size() const noexcept {
+        return chunk_size_;
+    }
+
+}} // namespace edsp::io
+
+#endif //EDSP_PARALLEL_DECODER_HPP
@@ -43,7 +43,8 @@ namespace edsp { namespace io {
      * @class resampler
      * @brief This class implements a resampler object to perform sample-rate conversion.
      *
-     * The class resamples an input signal in a factor proportional to the desired sample-rate..
+     * The class resamples an input signal in a factor proportional to the desired sample-rate. The conversion is
+     * performed by libsamplerate or libresample if enabled, or by the native polyphase_resampler otherwise.
      */
     template <typename T>
     struct resampler {
@@ -89,6 +90,33 @@ namespace edsp { namespace io {
             return impl.process(first, last, d_first);
         }
 
+        /**
+         * @brief Computes the remaining samples at the end of the stream and resets the internal state.
+         *
+         * @note Only available with the native polyphase_resampler backend, it does not compile with the others.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @return Number of samples computed in the output range.
+         */
+        template <typename OutputIt>
+        inline size_type flush(OutputIt d_first) {
+            static_assert(internal::is_native_resampler<T>::value,
+                          "flush is only available with the native polyphase_resampler backend");
+            return impl.flush(d_first);
+        }
+
+        /**
+         * @brief Returns the number of samples that the next call to process will compute for the given input size.
+         *
+         * @note Only available with the native polyphase_resampler backend, it does not compile with the others.
+         * @param input_size Number of interleaved input samples.
+         * @return Number of interleaved output samples.
+         */
+        size_type output_size(size_type input_size) const {
+            static_assert(internal::is_native_resampler<T>::value,
+                          "output_size is only available with the native polyphase_resampler backend");
+            return impl.output_size(input_size);
+        }
+
         /**
          * @brief Returns the quality used in the resampling process.
          * @return Resampling quality.
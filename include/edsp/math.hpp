@@ -25,6 +25,7 @@
 
 #include <edsp/math/complex.hpp>
 #include <edsp/math/constant.hpp>
+#include <edsp/math/fast.hpp>
 #include <edsp/math/numeric.hpp>
 
 #endif //EDSP_META_MATH_H
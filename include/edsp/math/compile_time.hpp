@@ -0,0 +1,323 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: compile_time.hpp
+ * Date: 30/10/18
+ * Author: Mohammed Boujemaoui
+ */
+
+#ifndef EDSP_MATH_COMPILE_TIME_HPP
+#define EDSP_MATH_COMPILE_TIME_HPP
+
+#include <limits>
+
+/**
+ * @brief Elementary functions that can be evaluated in constant expressions.
+ *
+ * The functions are computed in long double with range reduction followed by series that are summed until the terms
+ * no longer change the result, so the error is below 1 ULP for float and double in most of the domain. They are
+ * intended to compute constants, such as filter coefficients, and are slower than the standard library at runtime.
+ *
+ * The trigonometric functions reduce the argument with a three-part value of \f$ \pi/2 \f$, which is accurate
+ * for \f$ |x| < 2^{31} \f$.
+ */
+namespace edsp { inline namespace math { namespace compile_time {
+
+    namespace internal {
+
+        using real = long double;
+
+        constexpr real ln_two  = 6.931471805599453094172321214581765680e-01L;
+        constexpr real half_pi = 1.570796326794896619231321691639751442e+00L;
+
+        /* pi / 2 split in two parts of 32 bits, exact when multiplied by integers below 2^31, and the remainder */
+        constexpr real half_pi_1 = 1.570796326734125614166259765625L;
+        constexpr real half_pi_2 = 6.077100506303965976595549136618501506745815277099609375e-11L;
+        constexpr real half_pi_3 = 2.022266248795950732399684620094757716e-21L;
+
+        constexpr real abs(real x) noexcept {
+            return x < 0 ? -x : x;
+        }
+
+        constexpr bool is_nan(real x) noexcept {
+            return x != x;
+        }
+
+        constexpr bool is_inf(real x) noexcept {
+            return x == std::numeric_limits<real>::infinity() || x == -std::numeric_limits<real>::infinity();
+        }
+
+        /**
+         * @brief Rounds to the nearest integer, valid for |x| < 2^62.
+         */
+        constexpr long long round(real x) noexcept {
+            return static_cast<long long>(x < 0 ? x - 0.5L : x + 0.5L);
+        }
+
+        /**
+         * @brief Computes \f$ x 2^n \f$ by squaring.
+         */
+        constexpr real scale(real x, long long n) noexcept {
+            real factor = n < 0 ? 0.5L : 2.0L;
+            for (auto k = n < 0 ? -n : n; k > 0; k /= 2) {
+                if (k % 2 == 1) {
+                    x *= factor;
+                }
+                factor *= factor;
+            }
+            return x;
+        }
+
+        constexpr real sqrt(real x) noexcept {
+            if (is_nan(x) || x < 0) {
+                return std::numeric_limits<real>::quiet_NaN();
+            }
+            if (x == 0 || is_inf(x)) {
+                return x;
+            }
+
+            // Reduces x to [0.25, 1) * 4^e so that the iteration starts close to the root
+            long long e = 0;
+            for (; x >= 1; x /= 4) {
+                ++e;
+            }
+            for (; x < 0.25L; x *= 4) {
+                --e;
+            }
+
+            real y = (1 + x) / 2;
+            for (auto i = 0; i < 8; ++i) {
+                y = (y + x / y) / 2;
+            }
+            return scale(y, e);
+        }
+
+        constexpr real exp(real x) noexcept {
+            if (is_nan(x)) {
+                return x;
+            }
+            if (x > 11357) {
+                return std::numeric_limits<real>::infinity();
+            }
+            if (x < -11400) {
+                return 0;
+            }
+
+            const auto n = round(x / ln_two);
+            const auto r = x - static_cast<real>(n) * ln_two;
+            real sum = 1, term = 1;
+            for (auto k = 1; k < 64; ++k) {
+                term *= r / k;
+                const auto next = sum + term;
+                if (next == sum) {
+                    break;
+                }
+                sum = next;
+            }
+            return scale(sum, n);
+        }
+
+        constexpr real log(real x) noexcept {
+            if (is_nan(x) || x < 0) {
+                return std::numeric_limits<real>::quiet_NaN();
+            }
+            if (x == 0) {
+                return -std::numeric_limits<real>::infinity();
+            }
+            if (is_inf(x)) {
+                return x;
+            }
+
+            // Splits x = 2^e m with m in [sqrt(2)/2, sqrt(2))
+            long long e = 0;
+            for (; x >= 18446744073709551616.0L; x *= 5.42101086242752217003726400434970855712890625e-20L) {
+                e += 64;
+            }
+            for (; x < 5.42101086242752217003726400434970855712890625e-20L; x *= 18446744073709551616.0L) {
+                e -= 64;
+            }
+            for (; x >= 1.4142135623730950488L; x /= 2) {
+                ++e;
+            }
+            for (; x < 0.70710678118654752440L; x *= 2) {
+                --e;
+            }
+
+            // ln(m) = 2 atanh(t), with t = (m - 1) / (m + 1)
+            const auto t  = (x - 1) / (x + 1);
+            const auto t2 = t * t;
+            real sum = t, power = t;
+            for (auto k = 3; k < 128; k += 2) {
+                power *= t2;
+                const auto next = sum + power / k;
+                if (next == sum) {
+                    break;
+                }
+                sum = next;
+            }
+            return static_cast<real>(e) * ln_two + 2 * sum;
+        }
+
+        constexpr real sin_series(real r) noexcept {
+            const auto r2 = r * r;
+            real sum = r, term = r;
+            for (auto k = 2; k < 64; k += 2) {
+                term *= -r2 / (k * (k + 1));
+                const auto next = sum + term;
+                if (next == sum) {
+                    break;
+                }
+                sum = next;
+            }
+            return sum;
+        }
+
+        constexpr real cos_series(real r) noexcept {
+            const auto r2 = r * r;
+            real sum = 1, term = 1;
+            for (auto k = 1; k < 64; k += 2) {
+                term *= -r2 / (k * (k + 1));
+                const auto next = sum + term;
+                if (next == sum) {
+                    break;
+                }
+                sum = next;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Evaluates sin(x) if sine is true, cos(x) otherwise, after reducing x to [-pi/4, pi/4].
+         */
+        constexpr real trigonometric(real x, bool sine) noexcept {
+            if (is_nan(x) || is_inf(x)) {
+                return std::numeric_limits<real>::quiet_NaN();
+            }
+
+            const auto n        = round(x / half_pi);
+            const auto k        = static_cast<real>(n);
+            const auto r        = ((x - k * half_pi_1) - k * half_pi_2) - k * half_pi_3;
+            const auto quadrant = static_cast<int>(((n % 4) + 4) % 4) + (sine ? 0 : 1);
+            switch (quadrant % 4) {
+                case 0:
+                    return sin_series(r);
+                case 1:
+                    return cos_series(r);
+                case 2:
+                    return -sin_series(r);
+                default:
+                    return -cos_series(r);
+            }
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Computes the absolute value of x.
+     */
+    template <typename T>
+    constexpr T abs(T x) noexcept {
+        return x < 0 ? -x : x;
+    }
+
+    /**
+     * @brief Computes the square root of x.
+     * @returns Square root of x, NaN if x is negative.
+     */
+    template <typename T>
+    constexpr T sqrt(T x) noexcept {
+        return static_cast<T>(internal::sqrt(x));
+    }
+
+    /**
+     * @brief Computes the exponential function \f$ e^x \f$.
+     */
+    template <typename T>
+    constexpr T exp(T x) noexcept {
+        return static_cast<T>(internal::exp(x));
+    }
+
+    /**
+     * @brief Computes the natural logarithm \f$ \ln(x) \f$.
+     * @returns Natural logarithm of x, -inf if x is zero and NaN if x is negative.
+     */
+    template <typename T>
+    constexpr T log(T x) noexcept {
+        return static_cast<T>(internal::log(x));
+    }
+
+    /**
+     * @brief Computes the common logarithm \f$ \log_{10}(x) \f$.
+     */
+    template <typename T>
+    constexpr T log10(T x) noexcept {
+        return static_cast<T>(internal::log(x) / internal::log(10.0L));
+    }
+
+    /**
+     * @brief Computes x raised to the power y.
+     *
+     * Negative bases are only supported with integer exponents.
+     */
+    template <typename T>
+    constexpr T pow(T x, T y) noexcept {
+        if (y == 0) {
+            return 1;
+        }
+        if (x == 0) {
+            return y > 0 ? 0 : std::numeric_limits<T>::infinity();
+        }
+
+        const auto magnitude = internal::exp(y * internal::log(internal::abs(x)));
+        if (x > 0) {
+            return static_cast<T>(magnitude);
+        }
+
+        const auto integer = internal::round(y);
+        if (static_cast<internal::real>(integer) != static_cast<internal::real>(y)) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        return static_cast<T>(integer % 2 == 0 ? magnitude : -magnitude);
+    }
+
+    /**
+     * @brief Computes the sine of x (measured in radians).
+     */
+    template <typename T>
+    constexpr T sin(T x) noexcept {
+        return static_cast<T>(internal::trigonometric(x, true));
+    }
+
+    /**
+     * @brief Computes the cosine of x (measured in radians).
+     */
+    template <typename T>
+    constexpr T cos(T x) noexcept {
+        return static_cast<T>(internal::trigonometric(x, false));
+    }
+
+    /**
+     * @brief Computes the tangent of x (measured in radians).
+     */
+    template <typename T>
+    constexpr T tan(T x) noexcept {
+        return static_cast<T>(internal::trigonometric(x, true) / internal::trigonometric(x, false));
+    }
+
+}}} // namespace edsp::math::compile_time
+
+#endif // EDSP_MATH_COMPILE_TIME_HPP
@@ -0,0 +1,367 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: fast.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-10-21
+ */
+
+#ifndef EDSP_MATH_FAST_HPP
+#define EDSP_MATH_FAST_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/**
+ * @brief Fast single precision transcendental functions.
+ *
+ * The single precision kernels are written without branches, table lookups or library calls, so that loops calling
+ * them over contiguous buffers are vectorized by the compiler (SSE/AVX/NEON). Special values are resolved with
+ * selects at the end of every kernel.
+ *
+ * The documented maximum errors are measured in ULP against the correctly rounded result for finite, normal inputs
+ * inside the stated domains. Any other floating-point type falls back to the standard library implementation.
+ *
+ * The hypotenuse is evaluated in double precision through std::sqrt and is only vectorized when errno reporting is
+ * disabled (-fno-math-errno).
+ */
+namespace edsp { inline namespace math { namespace fast {
+
+    namespace internal {
+
+        inline std::uint32_t as_uint(float x) noexcept {
+            std::uint32_t i;
+            std::memcpy(&i, &x, sizeof(i));
+            return i;
+        }
+
+        inline float as_float(std::uint32_t i) noexcept {
+            float x;
+            std::memcpy(&x, &i, sizeof(x));
+            return x;
+        }
+
+        /**
+         * @brief Selects a or b with a bitwise blend, which keeps the kernels free of branches after inlining.
+         */
+        inline float select(bool c, float a, float b) noexcept {
+            const std::uint32_t mask = 0u - static_cast<std::uint32_t>(c);
+            return as_float((as_uint(a) & mask) | (as_uint(b) & ~mask));
+        }
+
+        /**
+         * @brief Rounds to the nearest integer (ties away from zero).
+         *
+         * The input is saturated to \f$ \pm 2^{30} \f$ before the conversion, and NaN is mapped to \f$ -2^{30} \f$.
+         */
+        inline std::int32_t round(float x) noexcept {
+            const float lo = select(x > -1073741824.0f, x, -1073741824.0f);
+            const float cx = select(lo < 1073741824.0f, lo, 1073741824.0f);
+            return static_cast<std::int32_t>(cx + (cx < 0 ? -0.5f : 0.5f));
+        }
+
+        /**
+         * @brief Computes \f$ x 2^n \f$ for n in [-252, 254] by splitting the exponent in two normal factors.
+         */
+        inline float scale(float x, std::int32_t n) noexcept {
+            const std::int32_t n1 = n >> 1;
+            const std::int32_t n2 = n - n1;
+            return (x * as_float(static_cast<std::uint32_t>(n1 + 127) << 23)) *
+                   as_float(static_cast<std::uint32_t>(n2 + 127) << 23);
+        }
+
+        /**
+         * @brief Evaluates \f$ e^r \f$ for \f$ |r| \leq \ln(2)/2 \f$ (Taylor series truncated at degree 7).
+         */
+        inline float exp_kernel(float r) noexcept {
+            return 1.0f +
+                   r * (1.0f +
+                        r * (0.5f +
+                             r * (1.66666672e-1f +
+                                  r * (4.16666679e-2f +
+                                       r * (8.33333377e-3f + r * (1.38888892e-3f + r * 1.98412701e-4f))))));
+        }
+
+        /**
+         * @brief Splits a positive finite number into \f$ x = 2^e m \f$ with \f$ m \in [\sqrt{2}/2, \sqrt{2}) \f$ and
+         * returns \f$ \ln(m) / 2 \f$ as an odd series in \f$ t = (m - 1) / (m + 1) \f$.
+         */
+        inline float log_kernel(float x, float& e) noexcept {
+            // The bits are handled as unsigned integers, the negative inputs wrap around and are resolved later
+            const std::uint32_t tiny = 0u - static_cast<std::uint32_t>(x < std::numeric_limits<float>::min());
+            const std::uint32_t i    = (as_uint(x * 8388608.0f) & tiny) | (as_uint(x) & ~tiny);
+            const std::int32_t k     = static_cast<std::int32_t>(i - 0x3f3504f3u) >> 23;
+            const float m            = as_float(i - (static_cast<std::uint32_t>(k) << 23));
+            e                        = static_cast<float>(k - static_cast<std::int32_t>(tiny & 23u));
+
+            const float t  = (m - 1.0f) / (m + 1.0f);
+            const float t2 = t * t;
+            return t + t * t2 * (3.33333343e-1f + t2 * (2.00000003e-1f + t2 * (1.42857149e-1f + t2 * 1.11111112e-1f)));
+        }
+
+        /**
+         * @brief Resolves the special values of the logarithmic functions.
+         */
+        inline float log_special(float x, float r) noexcept {
+            r = select(x == 0, -std::numeric_limits<float>::infinity(), r);
+            r = select((x < 0) | (x != x), std::numeric_limits<float>::quiet_NaN(), r);
+            return select(x == std::numeric_limits<float>::infinity(), x, r);
+        }
+
+        /**
+         * @brief Reduces x to \f$ r \in [-\pi/4, \pi/4] \f$ with \f$ x = n\pi/2 + r \f$ (three-term Cody-Waite).
+         */
+        inline float trig_reduce(float x, std::int32_t& n) noexcept {
+            n              = internal::round(x * 6.36619772e-1f);
+            const float nf = static_cast<float>(n);
+            return ((x - nf * 1.5703125f) - nf * 4.83751297e-4f) - nf * 7.54978995e-8f;
+        }
+
+        inline float sin_kernel(float r) noexcept {
+            const float z = r * r;
+            return r + r * z * (-1.66666546e-1f + z * (8.33216087e-3f + z * -1.95152959e-4f));
+        }
+
+        inline float cos_kernel(float r) noexcept {
+            const float z = r * r;
+            return 1.0f - 0.5f * z + z * z * (4.16666456e-2f + z * (-1.38873163e-3f + z * 2.44331571e-5f));
+        }
+
+        inline float copysign(float x, float y) noexcept {
+            return as_float((as_uint(x) & 0x7fffffffu) | (as_uint(y) & 0x80000000u));
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Computes the exponential function \f$ e^x \f$.
+     *
+     * Maximum error: 2 ULP. Results below FLT_MIN are gradually flushed and return 0 for x < -103.6.
+     * @param x Input value.
+     * @returns Exponential of x.
+     */
+    inline float exp(float x) noexcept {
+        const float v        = x * 1.44269504f;
+        const float lo       = internal::select(v > -150.0f, v, -150.0f);
+        const float cv       = internal::select(lo < 129.0f, lo, 129.0f);
+        const std::int32_t n = static_cast<std::int32_t>(cv + 256.5f) - 256;
+        const float nf       = static_cast<float>(n);
+        const float r        = (x - nf * 0.693145751953125f) - nf * 1.428606765330187045e-06f;
+        const float y        = internal::scale(internal::exp_kernel(r), n);
+        const float z        = internal::select(n > 128, std::numeric_limits<float>::infinity(), y);
+        return internal::select(x != x, x, internal::select(n < -149, 0.0f, z));
+    }
+
+    /**
+     * @brief Computes the base-2 exponential function \f$ 2^x \f$.
+     *
+     * Maximum error: 2 ULP.
+     * @param x Input value.
+     * @returns Base-2 exponential of x.
+     */
+    inline float exp2(float x) noexcept {
+        const float lo       = internal::select(x > -150.0f, x, -150.0f);
+        const float cx       = internal::select(lo < 129.0f, lo, 129.0f);
+        const std::int32_t n = static_cast<std::int32_t>(cx + 256.5f) - 256;
+        const float r        = (cx - static_cast<float>(n)) * 6.93147182e-1f;
+        const float y        = internal::scale(internal::exp_kernel(r), n);
+        const float z        = internal::select(n > 128, std::numeric_limits<float>::infinity(), y);
+        return internal::select(x != x, x, internal::select(n < -149, 0.0f, z));
+    }
+
+    /**
+     * @brief Computes the natural logarithm \f$ \ln(x) \f$.
+     *
+     * Maximum error: 2 ULP. Denormal inputs are supported.
+     * @param x Input value.
+     * @returns Natural logarithm of x, -inf if x is zero and NaN if x is negative.
+     */
+    inline float log(float x) noexcept {
+        float e;
+        const float s = internal::log_kernel(x, e);
+        return internal::log_special(x, e * 0.693145751953125f + (e * 1.428606765330187045e-06f + 2.0f * s));
+    }
+
+    /**
+     * @brief Computes the binary logarithm \f$ \log_2(x) \f$.
+     *
+     * Maximum error: 4 ULP. Denormal inputs are supported.
+     * @param x Input value.
+     * @returns Binary logarithm of x, -inf if x is zero and NaN if x is negative.
+     */
+    inline float log2(float x) noexcept {
+        float e;
+        const float s = internal::log_kernel(x, e);
+        return internal::log_special(x, e + s * 2.88539008f);
+    }
+
+    /**
+     * @brief Computes the common logarithm \f$ \log_{10}(x) \f$.
+     *
+     * Maximum error: 4 ULP. Denormal inputs are supported.
+     * @param x Input value.
+     * @returns Common logarithm of x, -inf if x is zero and NaN if x is negative.
+     */
+    inline float log10(float x) noexcept {
+        float e;
+        const float s = internal::log_kernel(x, e);
+        return internal::log_special(x, e * 3.01025391e-1f + (e * 4.60503907e-6f + s * 8.68588964e-1f));
+    }
+
+    /**
+     * @brief Computes the power function \f$ x^y \f$ for non-negative bases.
+     *
+     * Evaluated as \f$ 2^{y \log_2(x)} \f$, so the relative error grows with the magnitude of the exponent:
+     * maximum error 2 ULP for \f$ |y \log_2(x)| < 1 \f$ and 80 ULP for \f$ |y \log_2(x)| < 128 \f$.
+     * @param x Base value, must be non-negative.
+     * @param y Exponent value.
+     * @returns x raised to the power of y, NaN if x is negative, and 1 if x is 1 or y is 0 as in std::pow.
+     */
+    inline float pow(float x, float y) noexcept {
+        const float r = exp2(y * log2(x));
+        return internal::select((y == 0) | (x == 1), 1.0f, r);
+    }
+
+    /**
+     * @brief Computes the sine of x (measured in radians).
+     *
+     * Maximum error: 2 ULP for \f$ |x| \leq \pi \f$. The absolute error stays below \f$ 10^{-7} \f$ for
+     * \f$ |x| < 8192 \f$ and below \f$ 10^{-6} \f$ for \f$ |x| < 10^5 \f$. The argument reduction saturates for
+     * \f$ |x| > 10^9 \f$, where the result is meaningless.
+     * @param x Input value.
+     * @returns Sine of x, NaN if x is infinite or NaN.
+     */
+    inline float sin(float x) noexcept {
+        std::int32_t n;
+        const float r = internal::trig_reduce(x, n);
+        const float y = (n & 1) ? internal::cos_kernel(r) : internal::sin_kernel(r);
+        const float z = (n & 2) ? -y : y;
+        return (x - x == 0) ? z : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    /**
+     * @brief Computes the cosine of x (measured in radians).
+     *
+     * Maximum error: 2 ULP for \f$ |x| \leq \pi \f$. The absolute error stays below \f$ 10^{-7} \f$ for
+     * \f$ |x| < 8192 \f$ and below \f$ 10^{-6} \f$ for \f$ |x| < 10^5 \f$. The argument reduction saturates for
+     * \f$ |x| > 10^9 \f$, where the result is meaningless.
+     * @param x Input value.
+     * @returns Cosine of x, NaN if x is infinite or NaN.
+     */
+    inline float cos(float x) noexcept {
+        std::int32_t n;
+        const float r = internal::trig_reduce(x, n);
+        const float y = (n & 1) ? internal::sin_kernel(r) : internal::cos_kernel(r);
+        const float z = ((n + 1) & 2) ? -y : y;
+        return (x - x == 0) ? z : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    /**
+     * @brief Computes the arc tangent of y/x using the signs of the arguments to determine the quadrant.
+     *
+     * Maximum error: 3 ULP.
+     * @param y Value representing the proportion of the y-coordinate.
+     * @param x Value representing the proportion of the x-coordinate.
+     * @returns Arc tangent of y/x in the interval \f$ [-\pi, \pi] \f$.
+     */
+    inline float atan2(float y, float x) noexcept {
+        const float ax    = std::abs(x);
+        const float ay    = std::abs(y);
+        const float hi    = (ax > ay) ? ax : ay;
+        const float lo    = (ax > ay) ? ay : ax;
+        const bool reduce = lo > 4.14213562e-1f * hi;
+        const float num   = reduce ? lo - hi : lo;
+        const float den   = reduce ? lo + hi : hi;
+        const float z     = num / ((den == 0) ? 1.0f : den);
+        const float z2    = z * z;
+        const float p =
+            z + z * z2 * (-3.33329491e-1f + z2 * (1.99777106e-1f + z2 * (-1.38776856e-1f + z2 * 8.05374450e-2f)));
+        float r = reduce ? 7.85398163e-1f + p : p;
+        r       = (ay > ax) ? 1.57079637f - r : r;
+        r       = (internal::as_uint(x) >> 31) ? 3.14159274f - r : r;
+        return internal::copysign(r, y);
+    }
+
+    /**
+     * @brief Computes the square root of the sum of the squares of x and y, without undue overflow or underflow.
+     *
+     * Maximum error: 1 ULP.
+     * @param x Floating point value.
+     * @param y Floating point value.
+     * @returns The hypotenuse of a right-angled triangle whose legs are x and y.
+     */
+    inline float hypot(float x, float y) noexcept {
+        const auto dx = static_cast<double>(x);
+        const auto dy = static_cast<double>(y);
+        return static_cast<float>(std::sqrt(dx * dx + dy * dy));
+    }
+
+    template <typename T>
+    inline T exp(T x) {
+        return std::exp(x);
+    }
+
+    template <typename T>
+    inline T exp2(T x) {
+        return std::exp2(x);
+    }
+
+    template <typename T>
+    inline T log(T x) {
+        return std::log(x);
+    }
+
+    template <typename T>
+    inline T log2(T x) {
+        return std::log2(x);
+    }
+
+    template <typename T>
+    inline T log10(T x) {
+        return std::log10(x);
+    }
+
+    template <typename T>
+    inline T pow(T x, T y) {
+        return std::pow(x, y);
+    }
+
+    template <typename T>
+    inline T sin(T x) {
+        return std::sin(x);
+    }
+
+    template <typename T>
+    inline T cos(T x) {
+        return std::cos(x);
+    }
+
+    template <typename T>
+    inline T atan2(T y, T x) {
+        return std::atan2(y, x);
+    }
+
+    template <typename T>
+    inline T hypot(T x, T y) {
+        return std::hypot(x, y);
+    }
+
+}}} // namespace edsp::math::fast
+
+#endif //EDSP_MATH_FAST_HPP
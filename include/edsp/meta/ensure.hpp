@@ -27,6 +27,7 @@
 #include <edsp/meta/data.hpp>
 #include <edsp/meta/unused.hpp>
 #include <cassert>
+#include <cstddef>
 #include <string>
 
 namespace edsp { namespace meta {
@@ -43,6 +44,18 @@ namespace edsp { namespace meta {
         assert(condition && data(msg));
     }
 
+    /**
+     * @brief Overload for string literals. The message is only read when the condition fails, so it can be called in
+     * constant expressions.
+     */
+    template <std::size_t N>
+    constexpr void ensure(bool condition, const char (&msg)[N]) {
+        if (!condition) {
+            eCritical() << edsp::string_view(msg, N - 1);
+        }
+        assert(condition);
+    }
+
 }} // namespace edsp::meta
 
 #endif
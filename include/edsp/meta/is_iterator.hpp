@@ -23,6 +23,8 @@
 #define EDSP_META_IS_ITERATOR_HPP
 
 #include <iterator>
+#include <type_traits>
+#include <vector>
 
 namespace edsp { namespace meta {
 
@@ -78,6 +80,31 @@ namespace edsp { namespace meta {
     template <typename T>
     constexpr bool is_random_access_iterator_v = is_random_access_iterator<T>::value;
 
+    namespace {
+        template <typename Iterator, typename T,
+                  bool = std::is_object<T>::value && !std::is_same<T, bool>::value>
+        struct _is_vector_iterator
+            : std::integral_constant<bool, std::is_same<Iterator, typename std::vector<T>::iterator>::value ||
+                                               std::is_same<Iterator, typename std::vector<T>::const_iterator>::value> {
+        };
+
+        template <typename Iterator, typename T>
+        struct _is_vector_iterator<Iterator, T, false> : std::false_type {};
+    } // namespace
+
+    /**
+     * @brief Checks if the iterator refers to elements stored contiguously in memory.
+     *
+     * It detects pointers and the iterators of std::vector. The iterators of std::array are detected when they are
+     * pointers, as in libstdc++ and libc++.
+     */
+    template <typename T, typename Value = typename std::iterator_traits<T>::value_type>
+    struct is_contiguous_iterator
+        : std::integral_constant<bool, std::is_pointer<T>::value || _is_vector_iterator<T, Value>::value> {};
+
+    template <typename T>
+    constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<T>::value;
+
 }} // namespace edsp::meta
 
 #endif // EDSP_META_IS_ITERATOR_HPP
@@ -23,6 +23,7 @@
 #define EDSP_CEPSTRUM_HPP
 
 #include <edsp/spectral/dft.hpp>
+#include <edsp/math/fast.hpp>
 #include <vector>
 
 namespace edsp { inline namespace spectral {
@@ -36,6 +37,10 @@ namespace edsp { inline namespace spectral {
      * {\displaystyle C_K =\left|{\mathcal {F}}^{-1}\left\{\log \left(\left|{\mathcal {F}}\{f(t)\}\right|^{2}\right)\right\}\right|^{2}}
      * \f]
      *
+     * The output is the real cepstrum \f$ {\mathcal {F}}^{-1}\{\log|{\mathcal {F}}\{f(t)\}|\} \f$, half the inverse
+     * transform of the log periodogram, as in the previous releases. The magnitude of every bin is computed with
+     * hypot, so the large bins of single precision inputs do not overflow.
+     *
      * @param first Input iterator defining the beginning of the input range.
      * @param last Input iterator defining the ending of the input range.
      * @param d_first Output iterator defining the beginning of the destination range.
@@ -58,7 +63,7 @@ namespace edsp { inline namespace spectral {
 
         std::transform(std::cbegin(fft_data_), std::cend(fft_data_), std::begin(fft_data_),
                        [](const std::complex<value_type>& val) -> std::complex<value_type> {
-                           return std::complex<value_type>(std::log(std::abs(val)), 0);
+                           return std::complex<value_type>(fast::log(fast::hypot(val.real(), val.imag())), 0);
                        });
 
         ifft_.idft(meta::data(fft_data_), meta::data(temp_output));
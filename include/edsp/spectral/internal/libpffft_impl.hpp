@@ -27,6 +27,7 @@
 #include <edsp/meta/iterator.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/data.hpp>
+#include <edsp/math/constant.hpp>
 
 #include <complex>
 #include <pffft.h>
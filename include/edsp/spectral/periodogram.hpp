@@ -23,8 +23,8 @@
 #define EDSP_SPECTROGRAM_HPP
 
 #include <edsp/spectral/dft.hpp>
-#include <edsp/converter/mag2db.hpp>
 #include <edsp/math/numeric.hpp>
+#include <edsp/math/fast.hpp>
 #include <vector>
 
 namespace edsp { inline namespace spectral {
@@ -51,6 +51,9 @@ namespace edsp { inline namespace spectral {
      *
      * where T, is the inverse of the sample rate \f$ f_s \f$.
      *
+     * The logarithmic scale returns \f$ 20 \log_{10}|X_k| \f$, the same values as the previous releases except for the
+     * empty bins: they are mapped to -inf instead of failing the precondition of converter::mag2db.
+     *
      * @param first Input iterator defining the beginning of the input range.
      * @param last Input iterator defining the ending of the input range.
      * @param d_first Output iterator defining the beginning of the destination range.
@@ -68,12 +71,12 @@ namespace edsp { inline namespace spectral {
         if (scale == SpectralScale::Linear) {
             std::transform(std::cbegin(fft_data_), std::cend(fft_data_), d_first,
                            [](const std::complex<value_type>& val) -> meta::value_type_t<OutputIt> {
-                               return math::square(std::abs(val));
+                               return std::norm(val);
                            });
         } else {
             std::transform(std::cbegin(fft_data_), std::cend(fft_data_), d_first,
                            [](const std::complex<value_type>& val) -> meta::value_type_t<OutputIt> {
-                               return converter::mag2db(std::abs(val));
+                               return static_cast<value_type>(20) * fast::log10(fast::hypot(val.real(), val.imag()));
                            });
         }
     }
@@ -36,6 +36,9 @@
 #include <edsp/statistics/median.hpp>
 #include <edsp/statistics/min.hpp>
 #include <edsp/statistics/moment.hpp>
+#include <edsp/statistics/moments_accumulator.hpp>
+#include <edsp/statistics/norm.hpp>
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/statistics/peak.hpp>
 #include <edsp/feature/temporal/rms.hpp>
 #include <edsp/feature/temporal/rssq.hpp>
@@ -22,7 +22,9 @@
 #ifndef EDSP_STATISTICAL_ENTROPY_HPP
 #define EDSP_STATISTICAL_ENTROPY_HPP
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
+#include <edsp/math/fast.hpp>
 #include <numeric>
 #include <cmath>
 
@@ -51,13 +53,32 @@ namespace edsp { namespace statistics {
     constexpr meta::value_type_t<ForwardIt> entropy(ForwardIt first, ForwardIt last) {
         using input_t        = meta::value_type_t<ForwardIt>;
         const auto predicate = [](const input_t accumulated, const input_t current) {
-            return (accumulated + std::log2(current) * current);
+            return (accumulated + fast::log2(current) * current);
         };
         const auto size = static_cast<input_t>(std::distance(first, last));
         const auto acc  = std::accumulate(first, last, static_cast<input_t>(0), predicate);
         return -acc / std::log2(size);
     }
 
+    /**
+     * @brief Computes the entropy of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The entropy of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> entropy(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t   = meta::value_type_t<RandomIt>;
+        const auto size = static_cast<input_t>(std::distance(first, last));
+        const auto acc  = internal::reduce_sum(policy, first, last,
+                                               [](const input_t current) { return fast::log2(current) * current; });
+        return -acc / std::log2(size);
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_ENTROPY_HPP
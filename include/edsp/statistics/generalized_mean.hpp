@@ -23,6 +23,7 @@
 #define EDSP_STATISTICAL_GENERALIZED_MEAN_H
 
 #include <edsp/math/numeric.hpp>
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <numeric>
 
@@ -53,6 +54,28 @@ namespace edsp { namespace statistics {
         return std::pow(temp, math::inv(static_cast<input_t>(b)));
     }
 
+    /**
+     * @brief Computes the generalized mean of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @param beta Exponent of the generalized mean.
+     * @returns The generalized mean of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt, typename Integer,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> generalized_mean(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                                                  Integer beta) {
+        using input_t             = meta::value_type_t<RandomIt>;
+        const auto b              = static_cast<int>(beta);
+        const input_t accumulated = internal::reduce_sum(
+            policy, first, last, [b](const input_t current) { return static_cast<input_t>(std::pow(current, b)); });
+        const input_t temp = accumulated / static_cast<input_t>(std::distance(first, last));
+        return std::pow(temp, math::inv(static_cast<input_t>(b)));
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_GENERALIZED_MEAN_H
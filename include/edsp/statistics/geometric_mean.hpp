@@ -23,7 +23,9 @@
 #define EDSP_STATISTICAL_GEOMETRIC_MEAN_H
 
 #include <edsp/math/numeric.hpp>
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
+#include <cmath>
 #include <numeric>
 
 namespace edsp { namespace statistics {
@@ -48,6 +50,26 @@ namespace edsp { namespace statistics {
         return std::pow(acc, math::inv(sz));
     }
 
+    /**
+     * @brief Computes the geometric mean of the range [first, last) with the given execution policy.
+     *
+     * The product of a large number of elements overflows or underflows, so the mean of their logarithms is computed
+     * instead. The elements must be positive.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The geometric mean of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> geometric_mean(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t  = meta::value_type_t<RandomIt>;
+        const auto acc = internal::reduce_sum(policy, first, last, [](const input_t value) { return std::log(value); });
+        return std::exp(acc / static_cast<input_t>(std::distance(first, last)));
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_GEOMETRIC_MEAN_H
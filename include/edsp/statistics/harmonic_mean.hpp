@@ -23,6 +23,7 @@
 #define EDSP_STATISTICAL_HARMONIC_MEAN_H
 
 #include <edsp/math/numeric.hpp>
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <numeric>
 
@@ -48,6 +49,23 @@ namespace edsp { namespace statistics {
         const auto acc       = std::accumulate(first, last, static_cast<input_t>(0), predicate);
         return static_cast<input_t>(std::distance(first, last)) / acc;
     }
+
+    /**
+     * @brief Computes the harmonic mean of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The harmonic mean of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> harmonic_mean(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t  = meta::value_type_t<RandomIt>;
+        const auto acc = internal::reduce_sum(policy, first, last, [](const input_t value) { return math::inv(value); });
+        return static_cast<input_t>(std::distance(first, last)) / acc;
+    }
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_HARMONIC_MEAN_H
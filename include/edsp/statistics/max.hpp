@@ -22,6 +22,7 @@
 #ifndef EDSP_STATISTICAL_MAX_HPP
 #define EDSP_STATISTICAL_MAX_HPP
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <algorithm>
 
@@ -53,6 +54,34 @@ namespace edsp { namespace statistics {
         return std::abs(*std::max_element(first, last, comp));
     }
 
+    /**
+     * @brief Computes the maximum value of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The maximum value of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> max(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t = meta::value_type_t<RandomIt>;
+        return internal::reduce_extremum(policy, first, last, std::less<input_t>()).second;
+    }
+
+    /**
+     * @brief Computes the maximum absolute value of the range [first, last) with the given execution policy.
+     * @see max
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> maxabs(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t   = meta::value_type_t<RandomIt>;
+        const auto comp = [](const input_t left, const input_t right) { return std::abs(left) < std::abs(right); };
+        return std::abs(internal::reduce_extremum(policy, first, last, comp).second);
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_MAX_HPP
@@ -22,6 +22,7 @@
 #ifndef EDSP_STATISTICAL_MEAN_H
 #define EDSP_STATISTICAL_MEAN_H
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <numeric>
 #include <algorithm>
@@ -46,6 +47,23 @@ namespace edsp { namespace statistics {
         const auto acc = std::accumulate(first, last, static_cast<input_t>(0));
         return acc / static_cast<input_t>(std::distance(first, last));
     }
+
+    /**
+     * @brief Computes the average or mean value of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The average of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> mean(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t  = meta::value_type_t<RandomIt>;
+        const auto acc = internal::reduce_sum(policy, first, last, [](const input_t value) { return value; });
+        return acc / static_cast<input_t>(std::distance(first, last));
+    }
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_MEAN_H
@@ -22,6 +22,7 @@
 #ifndef EDSP_STATISTICAL_MIN_HPP
 #define EDSP_STATISTICAL_MIN_HPP
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <algorithm>
 
@@ -53,6 +54,34 @@ namespace edsp { namespace statistics {
         return std::abs(*std::min_element(first, last, comp));
     }
 
+    /**
+     * @brief Computes the minimum value of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The minimum value of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> min(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t = meta::value_type_t<RandomIt>;
+        return internal::reduce_extremum(policy, first, last, std::greater<input_t>()).second;
+    }
+
+    /**
+     * @brief Computes the minimum absolute value of the range [first, last) with the given execution policy.
+     * @see min
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> minabs(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using input_t   = meta::value_type_t<RandomIt>;
+        const auto comp = [](const input_t left, const input_t right) { return std::abs(left) > std::abs(right); };
+        return std::abs(internal::reduce_extremum(policy, first, last, comp).second);
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_MIN_HPP
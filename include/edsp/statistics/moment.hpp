@@ -24,32 +24,43 @@
 
 #include <edsp/statistics/mean.hpp>
 #include <edsp/meta/iterator.hpp>
+#include <cstddef>
+#include <iterator>
 #include <numeric>
 
 namespace edsp { namespace statistics {
 
     namespace internal {
 
-        // TODO: update this internal
-        template <int N, class T>
-        constexpr T nthPower(T x) {
-            T ret = x;
-            for (int i = 1; i < N; ++i) {
-                ret *= x;
+        /**
+         * @brief Computes x^N with N - 1 multiplications unrolled at compile time.
+         */
+        template <std::size_t N>
+        struct nthPower {
+            template <class T>
+            static constexpr T compute(T x) noexcept {
+                return x * nthPower<N - 1>::compute(x);
             }
-            return ret;
-        }
+        };
+
+        template <>
+        struct nthPower<0> {
+            template <class T>
+            static constexpr T compute(T) noexcept {
+                return T(1);
+            }
+        };
 
-        template <class T, int N>
+        template <class T, std::size_t N>
         struct SumDiffNthPower {
             explicit SumDiffNthPower(T x) : mean_(x) {}
             constexpr T operator()(T sum, T current) {
-                return sum + nthPower<N>(current - mean_);
+                return sum + nthPower<N>::compute(current - mean_);
             }
             T mean_;
         };
 
-        template <class T, int N, class Iter_T>
+        template <class T, std::size_t N, class Iter_T>
         T nthMoment(Iter_T first, Iter_T last, T mean) {
             const auto cnt = std::distance(first, last);
             return std::accumulate(first, last, T(), SumDiffNthPower<T, N>(mean)) /
@@ -0,0 +1,271 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: moments_accumulator.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-11-01
+ */
+
+#ifndef EDSP_STATISTICAL_MOMENTS_ACCUMULATOR_HPP
+#define EDSP_STATISTICAL_MOMENTS_ACCUMULATOR_HPP
+
+#include <cmath>
+#include <cstddef>
+
+namespace edsp { namespace statistics {
+
+    /**
+     * @class moments_accumulator
+     * @brief Computes the count, mean, variance, skewness and kurtosis of a sequence of values in a single pass.
+     *
+     * The accumulator stores the number of values n, their mean and the sums of the powers of their deviations from
+     * the mean, \f$ M_p = \sum (x - \mu)^p \f$ for p = 2, 3, 4. Updating the central sums instead of the raw sums of
+     * powers keeps the results accurate when the mean is large compared to the deviations.
+     *
+     * A single value is added with the update of Welford, extended to the higher moments by Terriberry. Ranges are
+     * added in chunks that fit in the cache: the mean and the central sums of every chunk are computed in two passes
+     * with several partial sums, which the compiler keeps in the SIMD lanes, and the chunk is then merged with the
+     * formulas of Pébay. The same merge combines the accumulators of different blocks or threads.
+     *
+     * @tparam T  Type of element.
+     */
+    template <typename T>
+    class moments_accumulator {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates an empty accumulator.
+         */
+        constexpr moments_accumulator() noexcept = default;
+
+        /**
+         * @brief Adds a value.
+         * @param value Value to add.
+         */
+        constexpr void push(value_type value) noexcept;
+
+        /**
+         * @brief Adds the values in the range [first, last).
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         */
+        template <typename InputIt>
+        void push(InputIt first, InputIt last);
+
+        /**
+         * @brief Adds the values accumulated by another accumulator.
+         * @param other Accumulator to combine with this one.
+         */
+        constexpr void merge(const moments_accumulator& other) noexcept;
+
+        /**
+         * @brief Removes all the values.
+         */
+        constexpr void reset() noexcept;
+
+        /**
+         * @brief Returns the number of values.
+         */
+        constexpr size_type count() const noexcept;
+
+        /**
+         * @brief Returns the mean of the values.
+         */
+        constexpr value_type mean() const noexcept;
+
+        /**
+         * @brief Returns the variance of the values, the second central moment \f$ M_2 / n \f$.
+         */
+        constexpr value_type variance() const noexcept;
+
+        /**
+         * @brief Returns the standard deviation of the values, the square root of the variance.
+         */
+        value_type standard_deviation() const noexcept;
+
+        /**
+         * @brief Returns the skewness of the values, the third standardized moment.
+         */
+        value_type skewness() const noexcept;
+
+        /**
+         * @brief Returns the kurtosis of the values, the fourth standardized moment.
+         */
+        constexpr value_type kurtosis() const noexcept;
+
+    private:
+        // Values per chunk, and independent partial sums per pass over the chunk: with fewer of them, the compiler
+        // unrolls the loop over the partial sums and vectorises the loop over the values with strided loads instead
+        static constexpr size_type chunk_size = 512;
+        static constexpr size_type lanes      = 32;
+
+        void push_chunk(const value_type* values, size_type size) noexcept;
+
+        size_type count_{0};
+        value_type mean_{0};
+        value_type m2_{0};
+        value_type m3_{0};
+        value_type m4_{0};
+    };
+
+    template <typename T>
+    constexpr void moments_accumulator<T>::push(const value_type value) noexcept {
+        const auto n1      = static_cast<value_type>(count_);
+        const auto n       = n1 + 1;
+        const auto delta   = value - mean_;
+        const auto delta_n = delta / n;
+        const auto term    = delta * delta_n * n1;
+
+        m4_ += term * delta_n * delta_n * (n * n - 3 * n + 3) + 6 * delta_n * delta_n * m2_ - 4 * delta_n * m3_;
+        m3_ += term * delta_n * (n - 2) - 3 * delta_n * m2_;
+        m2_ += term;
+        mean_ += delta_n;
+        ++count_;
+    }
+
+    template <typename T>
+    template <typename InputIt>
+    void moments_accumulator<T>::push(InputIt first, InputIt last) {
+        value_type chunk[chunk_size];
+        while (first != last) {
+            size_type size = 0;
+            for (; size < chunk_size && first != last; ++size, ++first) {
+                chunk[size] = static_cast<value_type>(*first);
+            }
+            push_chunk(chunk, size);
+        }
+    }
+
+    template <typename T>
+    void moments_accumulator<T>::push_chunk(const value_type* values, const size_type size) noexcept {
+        const auto blocks = size / lanes * lanes;
+
+        value_type sum[lanes] = {};
+        for (size_type i = 0; i < blocks; i += lanes) {
+            for (size_type lane = 0; lane < lanes; ++lane) {
+                sum[lane] += values[i + lane];
+            }
+        }
+        auto total = value_type(0);
+        for (size_type lane = 0; lane < lanes; ++lane) {
+            total += sum[lane];
+        }
+        for (auto i = blocks; i < size; ++i) {
+            total += values[i];
+        }
+
+        moments_accumulator chunk;
+        chunk.count_ = size;
+        chunk.mean_  = total / static_cast<value_type>(size);
+
+        value_type s2[lanes] = {}, s3[lanes] = {}, s4[lanes] = {};
+        for (size_type i = 0; i < blocks; i += lanes) {
+            for (size_type lane = 0; lane < lanes; ++lane) {
+                const auto d  = values[i + lane] - chunk.mean_;
+                const auto d2 = d * d;
+                s2[lane] += d2;
+                s3[lane] += d2 * d;
+                s4[lane] += d2 * d2;
+            }
+        }
+        for (size_type lane = 0; lane < lanes; ++lane) {
+            chunk.m2_ += s2[lane];
+            chunk.m3_ += s3[lane];
+            chunk.m4_ += s4[lane];
+        }
+        for (auto i = blocks; i < size; ++i) {
+            const auto d  = values[i] - chunk.mean_;
+            const auto d2 = d * d;
+            chunk.m2_ += d2;
+            chunk.m3_ += d2 * d;
+            chunk.m4_ += d2 * d2;
+        }
+        merge(chunk);
+    }
+
+    template <typename T>
+    constexpr void moments_accumulator<T>::merge(const moments_accumulator& other) noexcept {
+        if (other.count_ == 0) {
+            return;
+        }
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+
+        const auto na      = static_cast<value_type>(count_);
+        const auto nb      = static_cast<value_type>(other.count_);
+        const auto n       = na + nb;
+        const auto delta   = other.mean_ - mean_;
+        const auto delta_n = delta / n;
+        const auto product = na * nb * delta * delta_n;
+
+        const auto m4 = m4_ + other.m4_ + product * delta_n * delta_n * (na * na - na * nb + nb * nb) +
+                        6 * delta_n * delta_n * (na * na * other.m2_ + nb * nb * m2_) +
+                        4 * delta_n * (na * other.m3_ - nb * m3_);
+        const auto m3 = m3_ + other.m3_ + product * delta_n * (na - nb) + 3 * delta_n * (na * other.m2_ - nb * m2_);
+        m2_           = m2_ + other.m2_ + product;
+        m3_           = m3;
+        m4_           = m4;
+        mean_ += delta_n * nb;
+        count_ += other.count_;
+    }
+
+    template <typename T>
+    constexpr void moments_accumulator<T>::reset() noexcept {
+        count_ = 0;
+        mean_  = 0;
+        m2_    = 0;
+        m3_    = 0;
+        m4_    = 0;
+    }
+
+    template <typename T>
+    constexpr typename moments_accumulator<T>::size_type moments_accumulator<T>::count() const noexcept {
+        return count_;
+    }
+
+    template <typename T>
+    constexpr typename moments_accumulator<T>::value_type moments_accumulator<T>::mean() const noexcept {
+        return mean_;
+    }
+
+    template <typename T>
+    constexpr typename moments_accumulator<T>::value_type moments_accumulator<T>::variance() const noexcept {
+        return m2_ / static_cast<value_type>(count_);
+    }
+
+    template <typename T>
+    typename moments_accumulator<T>::value_type moments_accumulator<T>::standard_deviation() const noexcept {
+        return std::sqrt(variance());
+    }
+
+    template <typename T>
+    typename moments_accumulator<T>::value_type moments_accumulator<T>::skewness() const noexcept {
+        return std::sqrt(static_cast<value_type>(count_)) * m3_ / (m2_ * std::sqrt(m2_));
+    }
+
+    template <typename T>
+    constexpr typename moments_accumulator<T>::value_type moments_accumulator<T>::kurtosis() const noexcept {
+        return static_cast<value_type>(count_) * m4_ / (m2_ * m2_);
+    }
+
+}} // namespace edsp::statistics
+
+#endif // EDSP_STATISTICAL_MOMENTS_ACCUMULATOR_HPP
@@ -23,6 +23,7 @@
 #ifndef EDSP_NORM_HPP
 #define EDSP_NORM_HPP
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <edsp/math/numeric.hpp>
 #include <functional>
@@ -54,6 +55,23 @@ namespace edsp { namespace statistics {
         return std::sqrt(accumulated);
     }
 
+    /**
+     * @brief Computes the norm of the range [first, last) with the given execution policy.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns The norm of the input range.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    meta::value_type_t<RandomIt> norm(ExecutionPolicy&& policy, RandomIt first, RandomIt last) {
+        using value_type = meta::value_type_t<RandomIt>;
+        return std::sqrt(internal::reduce_sum(policy, first, last,
+                                              [](const value_type value) { return math::square(std::abs(value)); }));
+    }
+
 }} // namespace edsp::statistics
 
 #endif //EDSP_NORM_HPP
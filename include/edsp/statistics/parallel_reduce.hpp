@@ -0,0 +1,241 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ * File: parallel_reduce.hpp
+ * Author: Mohammed Boujemaoui
+ * Date: 2018-11-01
+ */
+
+#ifndef EDSP_STATISTICAL_PARALLEL_REDUCE_HPP
+#define EDSP_STATISTICAL_PARALLEL_REDUCE_HPP
+
+#include <edsp/core/parallel_for.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace edsp { namespace statistics {
+
+    namespace execution {
+
+        /**
+         * @brief Execution policy running a reduction in the calling thread.
+         */
+        struct sequenced_policy {
+            std::size_t chunk_size{65536}; /*!< Number of elements reduced at once */
+        };
+
+        /**
+         * @brief Execution policy distributing the chunks of a reduction among several threads.
+         */
+        struct parallel_policy {
+            std::size_t threads{0};        /*!< Maximum number of threads. Zero uses one per hardware thread */
+            std::size_t chunk_size{65536}; /*!< Number of elements reduced at once */
+        };
+
+        constexpr sequenced_policy seq{};
+        constexpr parallel_policy par{};
+
+        template <typename T>
+        struct is_execution_policy : std::false_type {};
+
+        template <>
+        struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+        template <>
+        struct is_execution_policy<parallel_policy> : std::true_type {};
+
+        template <typename T>
+        using enable_if_execution_policy_t =
+            typename std::enable_if<is_execution_policy<typename std::decay<T>::type>::value>::type;
+
+    } // namespace execution
+
+    namespace internal {
+
+        /**
+         * @brief Number of independent partial sums of a chunk, enough to fill the SIMD registers.
+         */
+        constexpr std::size_t reduce_lanes = 32;
+
+        /**
+         * @brief Computes the sum of map(x) over the range [first, last) with several partial sums.
+         */
+        template <typename T, typename RandomIt, typename Mapping>
+        T lane_sum(RandomIt first, RandomIt last, Mapping map) {
+            const auto size   = static_cast<std::size_t>(std::distance(first, last));
+            const auto blocks = size / reduce_lanes * reduce_lanes;
+
+            T sum[reduce_lanes] = {};
+            for (std::size_t i = 0; i < blocks; i += reduce_lanes) {
+                for (std::size_t lane = 0; lane < reduce_lanes; ++lane) {
+                    sum[lane] += map(first[i + lane]);
+                }
+            }
+            for (auto i = blocks; i < size; ++i) {
+                sum[i - blocks] += map(first[i]);
+            }
+
+            // Pairwise, as the partial results of the chunks
+            for (auto width = reduce_lanes / 2; width > 0; width /= 2) {
+                for (std::size_t lane = 0; lane < width; ++lane) {
+                    sum[lane] += sum[lane + width];
+                }
+            }
+            return sum[0];
+        }
+
+        /**
+         * @brief Combines the partial results in place by pairs of neighbours, until one is left.
+         */
+        template <typename T, typename Combine>
+        T combine_pairwise(std::vector<T>& partials, Combine combine) {
+            auto count = partials.size();
+            while (count > 1) {
+                const auto half = count / 2;
+                for (std::size_t i = 0; i < half; ++i) {
+                    partials[i] = combine(partials[2 * i], partials[2 * i + 1]);
+                }
+                if (count % 2 != 0) {
+                    partials[half] = partials[count - 1];
+                }
+                count = half + count % 2;
+            }
+            return partials.front();
+        }
+
+        template <typename T, typename RandomIt, typename ChunkReduce>
+        void reduce_chunk(std::vector<T>& partials, std::size_t chunk, std::size_t chunk_size, RandomIt first,
+                          std::size_t size, ChunkReduce& partial) {
+            const auto offset = chunk * chunk_size;
+            const auto length = std::min(chunk_size, size - offset);
+            const auto begin  = first + static_cast<meta::diff_type_t<RandomIt>>(offset);
+            partials[chunk]   = partial(begin, begin + static_cast<meta::diff_type_t<RandomIt>>(length), offset);
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Reduces the range [first, last) in the calling thread.
+     *
+     * The range is split in chunks of a fixed size, every chunk is reduced to a partial result and the partial
+     * results are combined by pairs of neighbours. The order of the operations does not depend on the policy, so the
+     * sequenced and parallel reductions of a range give the same result, bit by bit.
+     *
+     * @param policy Execution policy.
+     * @param first Random access iterator defining the beginning of the range.
+     * @param last Random access iterator defining the ending of the range.
+     * @param partial Function partial(chunk_first, chunk_last, offset) returning the partial result of a chunk, where
+     * offset is the position of the chunk in the range.
+     * @param combine Function combine(left, right) merging the partial results of two consecutive ranges.
+     * @return The result of the reduction, or a value-initialized result if the range is empty.
+     */
+    template <typename RandomIt, typename ChunkReduce, typename Combine>
+    auto reduce(const execution::sequenced_policy& policy, RandomIt first, RandomIt last, ChunkReduce partial,
+                Combine combine) -> decltype(partial(first, last, std::size_t{0})) {
+        using result_type = decltype(partial(first, last, std::size_t{0}));
+        const auto size   = static_cast<std::size_t>(std::distance(first, last));
+        meta::expects(policy.chunk_size > 0, "Expected a positive chunk size");
+        if (size == 0 || policy.chunk_size == 0) {
+            return result_type{};
+        }
+
+        const auto chunks = (size + policy.chunk_size - 1) / policy.chunk_size;
+        std::vector<result_type> partials(chunks);
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            internal::reduce_chunk(partials, chunk, policy.chunk_size, first, size, partial);
+        }
+        return internal::combine_pairwise(partials, combine);
+    }
+
+    /**
+     * @brief Reduces the range [first, last) with several threads.
+     *
+     * The chunks are distributed among the threads with parallel_for. The partial results are stored by chunk and
+     * combined as in the sequenced reduction, so the result does not depend on the number of threads.
+     *
+     * @see reduce
+     */
+    template <typename RandomIt, typename ChunkReduce, typename Combine>
+    auto reduce(const execution::parallel_policy& policy, RandomIt first, RandomIt last, ChunkReduce partial,
+                Combine combine) -> decltype(partial(first, last, std::size_t{0})) {
+        using result_type = decltype(partial(first, last, std::size_t{0}));
+        const auto size   = static_cast<std::size_t>(std::distance(first, last));
+        meta::expects(policy.chunk_size > 0, "Expected a positive chunk size");
+        if (size == 0 || policy.chunk_size == 0) {
+            return result_type{};
+        }
+
+        const auto chunks = (size + policy.chunk_size - 1) / policy.chunk_size;
+        std::vector<result_type> partials(chunks);
+        parallel_for(chunks, policy.threads, [&]() {
+            return [&](std::size_t chunk) {
+                internal::reduce_chunk(partials, chunk, policy.chunk_size, first, size, partial);
+            };
+        });
+        return internal::combine_pairwise(partials, combine);
+    }
+
+    namespace internal {
+
+        /**
+         * @brief Computes the sum of map(x) over the range [first, last) with the given execution policy.
+         */
+        template <typename ExecutionPolicy, typename RandomIt, typename Mapping>
+        meta::value_type_t<RandomIt> reduce_sum(const ExecutionPolicy& policy, RandomIt first, RandomIt last,
+                                                Mapping map) {
+            using value_type = meta::value_type_t<RandomIt>;
+            return statistics::reduce(
+                policy, first, last,
+                [&map](RandomIt chunk_first, RandomIt chunk_last, std::size_t) {
+                    return lane_sum<value_type>(chunk_first, chunk_last, map);
+                },
+                [](const value_type left, const value_type right) { return left + right; });
+        }
+
+        /**
+         * @brief Finds the first element of the range [first, last) for which no other element compares greater.
+         * @return Position and value of the element.
+         */
+        template <typename ExecutionPolicy, typename RandomIt, typename Compare>
+        std::pair<meta::diff_type_t<RandomIt>, meta::value_type_t<RandomIt>>
+            reduce_extremum(const ExecutionPolicy& policy, RandomIt first, RandomIt last, Compare comp) {
+            using result_type = std::pair<meta::diff_type_t<RandomIt>, meta::value_type_t<RandomIt>>;
+            return statistics::reduce(
+                policy, first, last,
+                [&comp](RandomIt chunk_first, RandomIt chunk_last, std::size_t offset) {
+                    const auto iter = std::max_element(chunk_first, chunk_last, comp);
+                    return result_type{static_cast<meta::diff_type_t<RandomIt>>(offset) +
+                                           std::distance(chunk_first, iter),
+                                       *iter};
+                },
+                [&comp](const result_type& left, const result_type& right) {
+                    // The left range comes first, so it wins the ties as in std::max_element
+                    return comp(left.second, right.second) ? right : left;
+                });
+        }
+
+    } // namespace internal
+
+}} // namespace edsp::statistics
+
+#endif // EDSP_STATISTICAL_PARALLEL_REDUCE_HPP
@@ -22,6 +22,7 @@
 #ifndef EDSP_STATISTICAL_PEAK_HPP
 #define EDSP_STATISTICAL_PEAK_HPP
 
+#include <edsp/statistics/parallel_reduce.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <algorithm>
 
@@ -57,6 +58,38 @@ namespace edsp { namespace statistics {
         return {std::distance(first, iter), *iter};
     }
 
+    /**
+     * @brief Computes the position and value of the maximum of the range [first, last) with the given execution
+     * policy. The first one is returned if several elements are equal to the maximum.
+     *
+     * @param policy Execution policy, execution::seq or execution::par.
+     * @param first Random access iterator defining the begin of the range to examine.
+     * @param last Random access iterator defining the end of the range to examine.
+     * @returns A pair with the position and value of the peak.
+     * @see reduce
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    auto peak(ExecutionPolicy&& policy, RandomIt first, RandomIt last)
+        -> std::pair<typename meta::diff_type_t<RandomIt>, typename meta::value_type_t<RandomIt>> {
+        using input_t = meta::value_type_t<RandomIt>;
+        return internal::reduce_extremum(policy, first, last, std::less<input_t>());
+    }
+
+    /**
+     * @brief Computes the position and value of the maximum absolute value of the range [first, last) with the given
+     * execution policy.
+     * @see peak
+     */
+    template <typename ExecutionPolicy, typename RandomIt,
+              typename = execution::enable_if_execution_policy_t<ExecutionPolicy>>
+    auto peakabs(ExecutionPolicy&& policy, RandomIt first, RandomIt last)
+        -> std::pair<typename meta::diff_type_t<RandomIt>, typename meta::value_type_t<RandomIt>> {
+        using input_t   = meta::value_type_t<RandomIt>;
+        const auto comp = [](const input_t left, const input_t right) { return std::abs(left) < std::abs(right); };
+        return internal::reduce_extremum(policy, first, last, comp);
+    }
+
 }} // namespace edsp::statistics
 
 #endif // EDSP_STATISTICAL_PEAK_HPP
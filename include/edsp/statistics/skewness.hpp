@@ -22,7 +22,7 @@
 #ifndef EDSP_STATISTICAL_SKEWNESS_H
 #define EDSP_STATISTICAL_SKEWNESS_H
 
-#include <edsp/statistics/moment.hpp>
+#include <edsp/statistics/moments_accumulator.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <cmath>
 
@@ -41,14 +41,13 @@ namespace edsp { namespace statistics {
      * @param first Forward iterator defining the begin of the range to examine.
      * @param last Forward iterator defining the end of the range to examine.
      * @returns The skewness of the input range.
-     * @see moment, standard_deviation
+     * @see moment, standard_deviation, moments_accumulator
      */
     template <typename ForwardIt>
     constexpr meta::value_type_t<ForwardIt> skewness(ForwardIt first, ForwardIt last) {
-        const auto m  = mean(first, last);
-        const auto m3 = moment<3>(first, last, m);
-        const auto m2 = moment<2>(first, last, m);
-        return m3 / (m2 * std::sqrt(m2));
+        moments_accumulator<meta::value_type_t<ForwardIt>> accumulator;
+        accumulator.push(first, last);
+        return accumulator.skewness();
     }
 }} // namespace edsp::statistics
 
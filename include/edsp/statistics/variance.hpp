@@ -22,7 +22,7 @@
 #ifndef EDSP_STATISTICAL_VARIANCE_H
 #define EDSP_STATISTICAL_VARIANCE_H
 
-#include <edsp/statistics/moment.hpp>
+#include <edsp/statistics/moments_accumulator.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <cmath>
 
@@ -38,11 +38,13 @@ namespace edsp { namespace statistics {
      * @param first Forward iterator defining the begin of the range to examine.
      * @param last Forward iterator defining the end of the range to examine.
      * @returns The variance of the input range.
-     * @see standard_deviation
+     * @see standard_deviation, moments_accumulator
      */
     template <typename ForwardIt>
     constexpr meta::value_type_t<ForwardIt> variance(ForwardIt first, ForwardIt last) {
-        return moment<2>(first, last);
+        moments_accumulator<meta::value_type_t<ForwardIt>> accumulator;
+        accumulator.push(first, last);
+        return accumulator.variance();
     }
 
     /**
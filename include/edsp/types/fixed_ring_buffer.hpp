@@ -26,6 +26,8 @@
 #include <edsp/meta/unused.hpp>
 #include <edsp/types/ring_span.hpp>
 #include <array>
+#include <memory>
+#include <utility>
 
 namespace edsp { inline namespace types {
 
@@ -58,11 +60,32 @@ namespace edsp { inline namespace types {
         typedef std::ptrdiff_t difference_type;
         typedef std::array<T, MaxSize> container_type;
 
-        fixed_ring_buffer()                             = default;
-        fixed_ring_buffer(const fixed_ring_buffer&)     = default;
-        fixed_ring_buffer(fixed_ring_buffer&&) noexcept = default;
-        fixed_ring_buffer& operator=(const fixed_ring_buffer&) = default;
-        fixed_ring_buffer& operator=(fixed_ring_buffer&&) noexcept = default;
+        fixed_ring_buffer() = default;
+
+        /**
+         *  @brief Copies the elements of other. The copy views its own storage, with the same front and size.
+         */
+        fixed_ring_buffer(const fixed_ring_buffer& other) : buffer_(other.buffer_), ring_(rebind(buffer_, other)) {}
+
+        fixed_ring_buffer(fixed_ring_buffer&& other) noexcept :
+            buffer_(std::move(other.buffer_)),
+            ring_(rebind(buffer_, other)) {}
+
+        fixed_ring_buffer& operator=(const fixed_ring_buffer& other) {
+            if (this != &other) {
+                buffer_ = other.buffer_;
+                ring_   = rebind(buffer_, other);
+            }
+            return *this;
+        }
+
+        fixed_ring_buffer& operator=(fixed_ring_buffer&& other) noexcept {
+            if (this != &other) {
+                buffer_ = std::move(other.buffer_);
+                ring_   = rebind(buffer_, other);
+            }
+            return *this;
+        }
 
         /**
          *  @brief Default destructor.
@@ -426,11 +449,18 @@ namespace edsp { inline namespace types {
          * @brief Returns a const pointer to the underlying data of the internal buffer
          * @return Array holding the internal data.
          */
-        const_pointer* data() const {
+        const value_type* data() const {
             return buffer_.data();
         }
 
     private:
+        /* Views the storage of buffer with the front and size of the ring of other */
+        static edsp::ring_span<T> rebind(container_type& buffer, const fixed_ring_buffer& other) noexcept {
+            const auto front = static_cast<size_type>(std::addressof(other.ring_.front()) - other.buffer_.data());
+            return edsp::ring_span<T>(std::begin(buffer), std::end(buffer), std::begin(buffer) + front,
+                                      other.ring_.size());
+        }
+
         container_type buffer_{};
         edsp::ring_span<T> ring_{std::begin(buffer_), std::end(buffer_)};
     };
@@ -28,6 +28,7 @@
 
 #include <edsp/meta/unused.hpp>
 #include <edsp/types/ring_span.hpp>
+#include <memory>
 #include <vector>
 
 namespace edsp { inline namespace types {
@@ -62,11 +63,22 @@ namespace edsp { inline namespace types {
         typedef std::vector<T, Allocator> container_type;
 
         constexpr ring_buffer()                       = default;
-        constexpr ring_buffer(const ring_buffer&)     = default;
         constexpr ring_buffer(ring_buffer&&) noexcept = default;
-        constexpr ring_buffer& operator=(const ring_buffer&) = default;
         constexpr ring_buffer& operator=(ring_buffer&&) noexcept = default;
 
+        /**
+         *  @brief Copies the elements of other. The copy views its own storage, with the same front and size.
+         */
+        ring_buffer(const ring_buffer& other) : buffer_(other.buffer_), ring_(rebind(buffer_, other)) {}
+
+        ring_buffer& operator=(const ring_buffer& other) {
+            if (this != &other) {
+                buffer_ = other.buffer_;
+                ring_   = rebind(buffer_, other);
+            }
+            return *this;
+        }
+
         /**
          *  @brief Creates a %ring_buffer with default constructed elements.
          *  @param N The number of elements to initially create.
@@ -468,6 +480,15 @@ namespace edsp { inline namespace types {
         }
 
     private:
+        static edsp::ring_span<T> rebind(container_type& buffer, const ring_buffer& other) noexcept {
+            if (buffer.empty()) {
+                return edsp::ring_span<T>(std::begin(buffer), std::end(buffer));
+            }
+            const auto front = static_cast<size_type>(std::addressof(other.ring_.front()) - other.buffer_.data());
+            return edsp::ring_span<T>(std::begin(buffer), std::end(buffer), std::begin(buffer) + front,
+                                      other.ring_.size());
+        }
+
         container_type buffer_{};
         edsp::ring_span<T> ring_{std::begin(buffer_), std::end(buffer_)};
     };
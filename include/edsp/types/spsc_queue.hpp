@@ -0,0 +1,119 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along withº
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* File: spsc_queue.hpp
+* Author: Mohammed Boujemaoui
+* Date: 25/10/18
+*/
+
+#ifndef EDSP_SPSC_QUEUE_HPP
+#define EDSP_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace edsp { inline namespace types {
+
+    /**
+     * @class spsc_queue
+     * @brief Bounded lock-free queue for one producer thread and one consumer thread.
+     *
+     * The producer only writes the tail index and the consumer only writes the head index, so both sides progress
+     * without locks or compare-and-swap loops. The storage is allocated once in the constructor.
+     *
+     * push may only be called from the producer thread, and pop, front and empty from the consumer thread.
+     *
+     * @tparam T Type of element.
+     */
+    template <typename T>
+    class spsc_queue {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates a queue able to store up to capacity elements.
+         * @param capacity Maximum number of elements.
+         */
+        explicit spsc_queue(size_type capacity) : buffer_(capacity + 1) {}
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        /**
+         * @brief Inserts an element at the end of the queue.
+         * @param value Element to be inserted.
+         * @return true if the element has been inserted, false if the queue is full.
+         */
+        bool push(const value_type& value) {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            const auto next = increment(tail);
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            buffer_[tail] = value;
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Extracts the element at the beginning of the queue.
+         * @param value Reference where the element is stored.
+         * @return true if an element has been extracted, false if the queue is empty.
+         */
+        bool pop(value_type& value) {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = buffer_[head];
+            head_.store(increment(head), std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks if the queue is empty.
+         */
+        bool empty() const {
+            return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns the maximum number of elements.
+         */
+        size_type capacity() const noexcept {
+            return buffer_.size() - 1;
+        }
+
+    private:
+        size_type increment(size_type index) const noexcept {
+            return (index + 1 == buffer_.size()) ? 0 : index + 1;
+        }
+
+        /* Both indexes are kept in different cache lines to avoid false sharing between the threads */
+        static constexpr size_type cache_line = 64;
+
+        std::vector<T> buffer_;
+        std::atomic<size_type> head_{0};
+        char padding_[cache_line - sizeof(std::atomic<size_type>)];
+        std::atomic<size_type> tail_{0};
+    };
+
+}} // namespace edsp::types
+
+#endif //EDSP_SPSC_QUEUE_HPP
@@ -23,6 +23,7 @@
 #define EDSP_BLACKMAN_HPP
 
 #include <edsp/math/numeric.hpp>
+#include <edsp/math/fast.hpp>
 #include <edsp/math/constant.hpp>
 #include <edsp/meta/iterator.hpp>
 #include <cmath>
@@ -54,7 +55,7 @@ namespace edsp { namespace windowing {
         const auto factor = constants<value_type>::two_pi / static_cast<value_type>(size - 1);
         for (size_type i = 0; i < size; ++i, ++first) {
             const value_type tmp = factor * i;
-            *first               = a0 - a1 * std::cos(tmp) + a2 * std::cos(2 * tmp);
+            *first               = a0 - a1 * fast::cos(tmp) + a2 * fast::cos(2 * tmp);
         }
     }
 
@@ -510,4 +510,31 @@ TEST(TestingLogspace, DecreaseOrder) {
     for (auto i = 0ul; i < size; ++i) {
         EXPECT_NEAR(computed[i], expected[i], 0.001);
     }
-}
\ No newline at end of file
+}
+
+TEST(TestingInterleave, RoundTrip) {
+    const auto frames = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    for (auto channels = 1ul; channels <= 9; ++channels) {
+        std::vector<float> interleaved(channels * frames), restored(channels * frames);
+        for (auto& element : interleaved) {
+            element = math::rand<float>(-1, 1);
+        }
+
+        std::vector<std::vector<float>> planar(channels, std::vector<float>(frames));
+        std::vector<float*> outputs;
+        for (auto& channel : planar) {
+            outputs.push_back(channel.data());
+        }
+
+        algorithm::deinterleave(std::cbegin(interleaved), std::cend(interleaved), std::begin(outputs),
+                                std::end(outputs));
+        for (auto i = 0ul; i < frames; ++i) {
+            for (auto c = 0ul; c < channels; ++c) {
+                EXPECT_EQ(planar[c][i], interleaved[i * channels + c]);
+            }
+        }
+
+        algorithm::interleave(std::cbegin(outputs), std::cend(outputs), frames, std::begin(restored));
+        EXPECT_EQ(restored, interleaved);
+    }
+}
@@ -32,12 +32,25 @@ template struct edsp::filter::designer<float, edsp::filter::designer_type::Zolze
 template struct edsp::filter::designer<float, edsp::filter::designer_type::Butterworth, 10>;
 template struct edsp::filter::designer<float, edsp::filter::designer_type::ChebyshevI, 10>;
 template struct edsp::filter::designer<float, edsp::filter::designer_type::ChebyshevII, 10>;
+template struct edsp::filter::designer<float, edsp::filter::designer_type::Elliptic, 10>;
+template struct edsp::filter::designer<float, edsp::filter::designer_type::Bessel, 10>;
+template struct edsp::filter::designer<float, edsp::filter::designer_type::Legendre, 10>;
 template class edsp::filter::moving_median<float>;
 template class edsp::filter::moving_average<float>;
 template class edsp::filter::moving_rms<float>;
+template class edsp::filter::moving_extremum<float, 64, std::greater<float>>;
+template class edsp::filter::moving_extremum<float, 64, std::greater<float>, edsp::filter::extremum_magnitude>;
 
 template class edsp::filter::biquad<float>;
 template class edsp::filter::biquad_cascade<float, 10>;
+template class edsp::filter::dynamic_biquad_cascade<float>;
+template class edsp::filter::fir<float>;
+template class edsp::filter::fir_decimator<float>;
+template class edsp::filter::fir_interpolator<float>;
+template class edsp::filter::smoothed_biquad<float>;
+template class edsp::filter::octave_bank<float>;
+template class edsp::filter::gammatone_bank<float>;
+template class edsp::filter::lookahead_cascade<float>;
 
 TEST(TestingBiquad, InitializeDefault) {
     biquad<float> b{};
@@ -58,4 +71,790 @@ TEST(TestingBiquad, InitializeDefault) {
     for (auto i = 0ul; i < N; ++i) {
         EXPECT_EQ(input[i], output[i]);
     }
-}
\ No newline at end of file
+}
+
+namespace {
+    std::vector<double> convolve(const std::vector<double>& input, const std::vector<double>& coefficients) {
+        std::vector<double> output(input.size(), 0);
+        for (auto n = 0ul; n < input.size(); ++n) {
+            for (auto k = 0ul; k < coefficients.size() && k <= n; ++k) {
+                output[n] += coefficients[k] * input[n - k];
+            }
+        }
+        return output;
+    }
+
+    template <typename Cascade>
+    std::complex<double> response(const Cascade& cascade, double normalized_frequency) {
+        const auto z1 = std::polar(1.0, -2 * edsp::constants<double>::pi * normalized_frequency);
+        const auto z2 = z1 * z1;
+        auto result   = std::complex<double>(1, 0);
+        for (const auto& stage : cascade) {
+            result *= (stage.b0() + stage.b1() * z1 + stage.b2() * z2) / (stage.a0() + stage.a1() * z1 + stage.a2() * z2);
+        }
+        return result;
+    }
+
+    std::vector<double> make_signal(std::size_t size) {
+        std::vector<double> signal(size);
+        for (auto i = 0ul; i < size; ++i) {
+            signal[i] = std::sin(0.05 * i) + 0.3 * std::cos(0.71 * i * i);
+        }
+        return signal;
+    }
+} // namespace
+
+TEST(TestingFir, MatchesConvolution) {
+    // The frequency domain filtering may run in single precision, depending on the FFT library
+    const auto tolerance = 1e-4;
+    for (const auto taps : {1ul, 7ul, 33ul, 200ul}) {
+        const auto coefficients = make_signal(taps + 5);
+        const auto input        = make_signal(3000);
+        const auto expected     = convolve(input, {std::cbegin(coefficients), std::cbegin(coefficients) + taps});
+
+        fir<double> block(std::cbegin(coefficients), std::cbegin(coefficients) + taps);
+        fir<double> sample(std::cbegin(coefficients), std::cbegin(coefficients) + taps);
+        EXPECT_EQ(block.size(), taps);
+
+        // The blocks have different sizes, so both the direct form and the frequency domain can be used
+        std::vector<double> output(input.size());
+        for (auto first = 0ul, size = 1ul; first < input.size(); first += size, size = 3 * size + 1) {
+            const auto last = std::min(first + size, input.size());
+            block.filter(std::cbegin(input) + first, std::cbegin(input) + last, std::begin(output) + first);
+        }
+
+        for (auto i = 0ul; i < input.size(); ++i) {
+            EXPECT_NEAR(output[i], expected[i], tolerance);
+            EXPECT_NEAR(sample(input[i]), expected[i], 1e-9);
+        }
+    }
+}
+
+TEST(TestingFir, Multichannel) {
+    const auto tolerance    = 1e-4;
+    const auto channels     = 3ul;
+    const auto frames       = 1000ul;
+    const auto coefficients = make_signal(100);
+    const auto signal       = make_signal(channels * frames);
+
+    std::vector<double> input(channels * frames);
+    std::vector<std::vector<double>> planar(channels, std::vector<double>(frames));
+    for (auto i = 0ul; i < input.size(); ++i) {
+        planar[i % channels][i / channels] = signal[i];
+        input[i]                           = signal[i];
+    }
+
+    fir<double> filter(std::cbegin(coefficients), std::cend(coefficients), channels);
+    EXPECT_EQ(filter.channels(), channels);
+    std::vector<double> output(input.size());
+    filter.filter(std::cbegin(input), std::cbegin(input) + 150 * channels, std::begin(output));
+    filter.filter(std::cbegin(input) + 150 * channels, std::cend(input), std::begin(output) + 150 * channels);
+
+    for (auto channel = 0ul; channel < channels; ++channel) {
+        const auto expected = convolve(planar[channel], coefficients);
+        for (auto i = 0ul; i < frames; ++i) {
+            EXPECT_NEAR(output[i * channels + channel], expected[i], tolerance);
+        }
+    }
+
+    filter.reset();
+    std::vector<double> restarted(input.size());
+    filter.filter(std::cbegin(input), std::cend(input), std::begin(restarted));
+    EXPECT_TRUE(std::equal(std::cbegin(restarted), std::cend(restarted), std::cbegin(output),
+                           [tolerance](double a, double b) { return std::abs(a - b) < tolerance; }));
+}
+
+TEST(TestingFir, Copy) {
+    const auto tolerance    = 1e-4;
+    const auto coefficients = make_signal(fir<double>::default_fft_threshold + 36);
+    const auto input        = make_signal(2000);
+    const auto expected     = convolve(input, coefficients);
+
+    // The first block builds the frequency domain convolver, which the copies can not share
+    fir<double> original(std::cbegin(coefficients), std::cend(coefficients));
+    std::vector<double> output(input.size());
+    original.filter(std::cbegin(input), std::cbegin(input) + 1000, std::begin(output));
+
+    fir<double> copy(original);
+    fir<double> assigned(std::cbegin(coefficients), std::cbegin(coefficients) + 3);
+    assigned = copy;
+    EXPECT_EQ(assigned.size(), coefficients.size());
+
+    std::vector<double> copied(input.size()), reassigned(input.size());
+    original.filter(std::cbegin(input) + 1000, std::cend(input), std::begin(output) + 1000);
+    copy.filter(std::cbegin(input) + 1000, std::cend(input), std::begin(copied) + 1000);
+    assigned.filter(std::cbegin(input) + 1000, std::cend(input), std::begin(reassigned) + 1000);
+    for (auto i = 1000ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], tolerance);
+        EXPECT_NEAR(copied[i], expected[i], tolerance);
+        EXPECT_NEAR(reassigned[i], expected[i], tolerance);
+    }
+}
+
+TEST(TestingFir, PolyphaseDecimation) {
+    const auto coefficients = make_signal(31);
+    const auto input        = make_signal(1001);
+    const auto expected     = convolve(input, coefficients);
+
+    fir_decimator<double> decimator(std::cbegin(coefficients), std::cend(coefficients), 4);
+    EXPECT_EQ(decimator.factor(), 4);
+    std::vector<double> output(input.size());
+    auto last = decimator.filter(std::cbegin(input), std::cbegin(input) + 10, std::begin(output));
+    last      = decimator.filter(std::cbegin(input) + 10, std::cend(input), last);
+    ASSERT_EQ(std::distance(std::begin(output), last), 251);
+    for (auto i = 0l; i < 251; ++i) {
+        EXPECT_NEAR(output[i], expected[4 * i], 1e-9);
+    }
+}
+
+TEST(TestingFir, PolyphaseInterpolation) {
+    const auto factor       = 3ul;
+    const auto coefficients = make_signal(32);
+    const auto input        = make_signal(400);
+
+    std::vector<double> upsampled(factor * input.size(), 0);
+    for (auto i = 0ul; i < input.size(); ++i) {
+        upsampled[factor * i] = input[i];
+    }
+    const auto expected = convolve(upsampled, coefficients);
+
+    fir_interpolator<double> interpolator(std::cbegin(coefficients), std::cend(coefficients), factor);
+    EXPECT_EQ(interpolator.size(), 32);
+    std::vector<double> output(upsampled.size());
+    const auto last = interpolator.filter(std::cbegin(input), std::cend(input), std::begin(output));
+    ASSERT_EQ(std::distance(std::begin(output), last), upsampled.size());
+    for (auto i = 0ul; i < output.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-9);
+    }
+}
+
+TEST(TestingDynamicCascade, MatchesFixedCascade) {
+    auto fixed = designer<double, designer_type::Butterworth, 100>{}.design<filter_type::LowPass>(4ul, 44100., 1000.);
+    dynamic_biquad_cascade<double> cascade(fixed);
+    ASSERT_EQ(cascade.size(), 2);
+    EXPECT_EQ(cascade.capacity(), 2);
+    EXPECT_EQ(fixed.max_size(), 50);
+
+    const auto input = make_signal(1000);
+    std::vector<double> expected(input.size()), output(input.size());
+    fixed.filter(std::cbegin(input), std::cend(input), std::begin(expected));
+    cascade.filter(std::cbegin(input), std::cbegin(input) + 500, std::begin(output));
+    for (auto i = 500ul; i < input.size(); ++i) {
+        output[i] = cascade.tick(input[i]);
+    }
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-12);
+    }
+
+    // Same coefficients, zero-phase filtering and frequency response as the fixed cascade
+    cascade.reset();
+    fixed.reset();
+    EXPECT_EQ(filtfilt_padding(cascade), filtfilt_padding(fixed));
+    filtfilt(fixed, std::cbegin(input), std::cend(input), std::begin(expected));
+    filtfilt(cascade, std::cbegin(input), std::cend(input), std::begin(output));
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-12);
+    }
+    const auto reference = freqz(fixed, 64), response = freqz(cascade, 64);
+    for (auto k = 0ul; k < 64; ++k) {
+        EXPECT_NEAR(response.magnitude[k], reference.magnitude[k], 1e-12);
+    }
+
+    // Stages can be appended one by one
+    dynamic_biquad_cascade<double> manual;
+    manual.reserve(2);
+    manual.push_back(fixed[0]);
+    manual.emplace_back(fixed[1].a0(), fixed[1].a1(), fixed[1].a2(), fixed[1].b0(), fixed[1].b1(), fixed[1].b2());
+    manual.prime(1);
+    for (auto i = 0; i < 10; ++i) {
+        EXPECT_NEAR(manual.tick(1), 1, 1e-9);
+    }
+    manual.clear();
+    EXPECT_EQ(manual.size(), 0);
+}
+
+TEST(TestingSmoothedBiquad, RampKeepsState) {
+    const auto first  = make_filter<double, designer_type::RBJ, filter_type::LowPass, 1>(1000., 44100., 0.707);
+    const auto second = make_filter<double, designer_type::RBJ, filter_type::LowPass, 1>(5000., 44100., 0.707);
+    const auto input  = make_signal(1000);
+    const auto ramp   = 64ul;
+
+    // Without modulation it behaves as a regular biquad
+    auto reference = first;
+    smoothed_biquad<double> smoothed(first, ramp);
+    std::vector<double> output(input.size());
+    smoothed.filter(std::cbegin(input), std::cbegin(input) + 100, std::begin(output));
+    for (auto i = 0ul; i < 100; ++i) {
+        EXPECT_NEAR(output[i], reference.tick(input[i]), 1e-12);
+    }
+
+    // The ramp is split across blocks and the coefficients end exactly at the target
+    smoothed.set_target(second);
+    EXPECT_TRUE(smoothed.ramping());
+    smoothed.filter(std::cbegin(input) + 100, std::cbegin(input) + 130, std::begin(output) + 100);
+    EXPECT_TRUE(smoothed.ramping());
+    smoothed.filter(std::cbegin(input) + 130, std::cend(input), std::begin(output) + 130);
+    EXPECT_FALSE(smoothed.ramping());
+    EXPECT_EQ(smoothed.current().a1(), second.a1());
+    EXPECT_EQ(smoothed.current().b0(), second.b0());
+
+    // The state is not reset: the output has no jump when the ramp starts
+    EXPECT_LT(std::abs(output[100] - output[99]), 0.5);
+
+    // The same ramp computed sample by sample
+    smoothed_biquad<double> ticked(first, ramp);
+    for (auto i = 0ul; i < input.size(); ++i) {
+        if (i == 100) {
+            ticked.set_target(second);
+        }
+        EXPECT_NEAR(ticked.tick(input[i]), output[i], 1e-12);
+    }
+
+    // Once the ramp is finished, it matches the target filter fed with the same history
+    auto settled = second;
+    std::vector<double> expected(input.size());
+    settled.filter(std::cbegin(input), std::cend(input), std::begin(expected));
+    EXPECT_NEAR(output.back(), expected.back(), 1e-6);
+}
+
+TEST(TestingBiquad, SilentInputHasNoDenormals) {
+    auto filter = make_filter<float, designer_type::RBJ, filter_type::LowPass, 1>(1000.f, 44100.f, 0.707f);
+
+    // The tail of an impulse decays exponentially and would reach the denormal range without protection
+    std::vector<float> input(44100, 0.f), output(input.size());
+    input.front() = 1.f;
+    filter.filter(std::cbegin(input), std::cend(input), std::begin(output));
+    for (const auto value : output) {
+        EXPECT_FALSE(edsp::math::is_denormal(value));
+    }
+
+    // The floating point modes are restored when the block ends
+    volatile float tiny = std::numeric_limits<float>::min();
+    EXPECT_GT(tiny / 2, 0.f);
+}
+
+TEST(TestingDesigner, ConstantExpressions) {
+    // The coefficients are computed by the compiler
+    constexpr auto rbj     = make_filter<double, designer_type::RBJ, filter_type::LowPass, 1>(1000., 44100., 0.707);
+    constexpr auto zoelzer = make_filter<double, designer_type::Zolzer, filter_type::HighShelf, 1>(5000., 44100., 1., -6.);
+    constexpr auto butter  = make_filter<double, designer_type::Butterworth, filter_type::LowPass, 8>(5ul, 44100., 2000.);
+    static_assert(rbj.b0() > 0 && butter.size() == 3, "Expected a design evaluated at compile time");
+
+    const auto omega = 2 * edsp::constants<double>::pi * 1000. / 44100.;
+    const auto alpha = std::sin(omega) / (2 * 0.707);
+    EXPECT_NEAR(rbj.a1(), -2 * std::cos(omega) / (1 + alpha), 1e-15);
+    EXPECT_NEAR(rbj.a2(), (1 - alpha) / (1 + alpha), 1e-15);
+    EXPECT_NEAR(rbj.b0(), (1 - std::cos(omega)) / 2 / (1 + alpha), 1e-15);
+
+    // Gain of the shelf and unity gain at DC
+    EXPECT_NEAR(std::abs(response(std::array<biquad<double>, 1>{{zoelzer}}, 0.5)), std::pow(10, -6. / 20), 1e-9);
+    EXPECT_NEAR(std::abs(response(std::array<biquad<double>, 1>{{zoelzer}}, 0)), 1, 1e-9);
+    const auto boost = make_filter<double, designer_type::Zolzer, filter_type::LowShelf, 1>(500., 44100., 1., 6.);
+    EXPECT_NEAR(std::abs(response(std::array<biquad<double>, 1>{{boost}}, 0)), std::pow(10, 6. / 20), 1e-9);
+
+    // Magnitude of the digital Butterworth low pass: 1 / sqrt(1 + (tan(pi f) / tan(pi fc))^2N)
+    const auto warped = std::tan(edsp::constants<double>::pi * 2000. / 44100.);
+    for (const auto frequency : {0., 0.01, 2000. / 44100., 0.1, 0.3, 0.45}) {
+        const auto ratio = std::tan(edsp::constants<double>::pi * frequency) / warped;
+        EXPECT_NEAR(std::abs(response(butter, frequency)), 1 / std::sqrt(1 + std::pow(ratio, 10)), 1e-9);
+    }
+
+    // Magnitude of the digital Butterworth high pass: 1 / sqrt(1 + (tan(pi fc) / tan(pi f))^2N)
+    constexpr auto high = make_filter<double, designer_type::Butterworth, filter_type::HighPass, 8>(4ul, 44100., 2000.);
+    for (const auto frequency : {0.01, 0.1, 0.3, 0.5}) {
+        const auto ratio = warped / std::tan(edsp::constants<double>::pi * frequency);
+        EXPECT_NEAR(std::abs(response(high, frequency)), 1 / std::sqrt(1 + std::pow(ratio, 8)), 1e-9);
+    }
+}
+
+namespace {
+    // Straightforward implementation, storing the extended signal and its reverse
+    template <typename Filter>
+    std::vector<double> reference_filtfilt(Filter filter, const std::vector<double>& input, std::size_t padding) {
+        const auto size = input.size();
+        std::vector<double> extended;
+        for (auto i = padding; i > 0; --i) {
+            extended.push_back(2 * input.front() - input[i]);
+        }
+        extended.insert(std::end(extended), std::cbegin(input), std::cend(input));
+        for (auto i = 1ul; i <= padding; ++i) {
+            extended.push_back(2 * input.back() - input[size - 1 - i]);
+        }
+
+        filter.reset();
+        filter.prime(extended.front());
+        for (auto& x : extended) {
+            x = filter.tick(x);
+        }
+        std::reverse(std::begin(extended), std::end(extended));
+        filter.reset();
+        filter.prime(extended.front());
+        for (auto& x : extended) {
+            x = filter.tick(x);
+        }
+        std::reverse(std::begin(extended), std::end(extended));
+        return {std::cbegin(extended) + padding, std::cbegin(extended) + padding + size};
+    }
+} // namespace
+
+TEST(TestingDesigner, EllipticMeetsSpecification) {
+    const auto fs = 48000., passband = 1000., stopband = 1500., ripple = 1., attenuation = 60.;
+    const auto order = estimate_order<designer_type::Elliptic, filter_type::LowPass>(fs, passband, stopband, ripple,
+                                                                                       attenuation);
+    EXPECT_EQ(order, 6);
+    EXPECT_EQ((estimate_order<designer_type::Butterworth, filter_type::LowPass>(fs, passband, stopband, ripple,
+                                                                                attenuation)),
+              19);
+    EXPECT_EQ((estimate_order<designer_type::ChebyshevI, filter_type::LowPass>(fs, passband, stopband, ripple,
+                                                                               attenuation)),
+              9);
+
+    const auto worst = [&](const auto& cascade, double first, double last, bool maximum) {
+        auto result = maximum ? -1e9 : 1e9;
+        for (auto f = first; f <= last; f += 5) {
+            const auto gain = 20 * std::log10(std::abs(response(cascade, f / fs)));
+            result          = maximum ? std::max(result, gain) : std::min(result, gain);
+        }
+        return result;
+    };
+
+    const auto cascade = make_filter<double, designer_type::Elliptic, filter_type::LowPass, 8>(order, fs, passband,
+                                                                                               ripple, attenuation);
+    EXPECT_EQ(cascade.size(), 3);
+    EXPECT_GE(worst(cascade, 0, passband, false), -ripple - 1e-6);
+    EXPECT_LE(worst(cascade, 0, passband, true), 1e-6);
+    EXPECT_LE(worst(cascade, stopband, fs / 2, true), -attenuation);
+
+    // The order below the estimated one does not meet the specification
+    const auto lower = make_filter<double, designer_type::Elliptic, filter_type::LowPass, 8>(order - 1, fs, passband,
+                                                                                             ripple, attenuation);
+    EXPECT_GT(worst(lower, stopband, fs / 2, true), -attenuation);
+
+    // High pass, band pass and band stop filters from the same prototype
+    const auto high = make_filter<double, designer_type::Elliptic, filter_type::HighPass, 8>(5ul, fs, 3000., ripple,
+                                                                                             attenuation);
+    EXPECT_GE(worst(high, 3000, fs / 2, false), -ripple - 1e-6);
+    EXPECT_LE(worst(high, 0, 1500, true), -attenuation + 1e-6);
+
+    const auto band = make_filter<double, designer_type::Elliptic, filter_type::BandPass, 4>(4ul, fs, 3000., 2000.,
+                                                                                             ripple, attenuation);
+    EXPECT_GE(worst(band, 2100, 3900, false), -ripple - 1e-6);
+    EXPECT_LE(worst(band, 0, 1000, true), -attenuation + 1e-6);
+    EXPECT_LE(worst(band, 8000, fs / 2, true), -attenuation + 1e-6);
+
+    const auto stop = make_filter<double, designer_type::Elliptic, filter_type::BandStop, 4>(4ul, fs, 3000., 2000.,
+                                                                                             ripple, attenuation);
+    EXPECT_GE(worst(stop, 0, 1000, false), -ripple - 1e-6);
+    EXPECT_GE(worst(stop, 8000, fs / 2, false), -ripple - 1e-6);
+    EXPECT_LE(worst(stop, 2500, 3200, true), -attenuation + 1e-6);
+}
+
+TEST(TestingDesigner, BesselAndLegendre) {
+    const auto fs = 48000., cutoff = 2000.;
+    for (const auto order : {1ul, 2ul, 3ul, 4ul, 7ul}) {
+        const auto bessel   = make_filter<double, designer_type::Bessel, filter_type::LowPass, 8>(order, fs, cutoff);
+        const auto legendre = make_filter<double, designer_type::Legendre, filter_type::LowPass, 8>(order, fs, cutoff);
+        EXPECT_NEAR(std::abs(response(bessel, 0)), 1, 1e-9);
+        EXPECT_NEAR(std::abs(response(legendre, 0)), 1, 1e-9);
+        EXPECT_NEAR(std::abs(response(bessel, cutoff / fs)), edsp::constants<double>::one_div_root_two, 1e-6);
+        EXPECT_NEAR(std::abs(response(legendre, cutoff / fs)), edsp::constants<double>::one_div_root_two, 1e-6);
+
+        // Both responses are monotonic, the Legendre one with the steepest roll-off
+        auto previous = 1.;
+        for (auto f = 100.; f < fs / 2; f += 100) {
+            const auto gain = std::abs(response(legendre, f / fs));
+            EXPECT_LE(gain, previous + 1e-9);
+            previous = gain;
+        }
+        if (order > 1) {
+            EXPECT_LT(std::abs(response(legendre, 2 * cutoff / fs)), std::abs(response(bessel, 2 * cutoff / fs)));
+        }
+    }
+
+    const auto high = make_filter<double, designer_type::Legendre, filter_type::HighPass, 8>(4ul, fs, cutoff);
+    EXPECT_NEAR(std::abs(response(high, 0.5)), 1, 1e-9);
+    EXPECT_NEAR(std::abs(response(high, cutoff / fs)), edsp::constants<double>::one_div_root_two, 1e-6);
+
+    const auto band = make_filter<double, designer_type::Bessel, filter_type::BandPass, 4>(3ul, fs, 3000., 2000.);
+    EXPECT_NEAR(std::abs(response(band, 3000. / fs)), 1, 1e-2);
+    EXPECT_LT(std::abs(response(band, 500. / fs)), 0.01);
+
+    const auto stop = make_filter<double, designer_type::Legendre, filter_type::BandStop, 4>(3ul, fs, 3000., 2000.);
+    EXPECT_NEAR(std::abs(response(stop, 0)), 1, 1e-9);
+    EXPECT_LT(std::abs(response(stop, 3000. / fs)), 0.01);
+
+    // The estimated order is the minimum one of the prototype
+    const auto estimated = estimate_order<designer_type::Legendre, filter_type::LowPass>(fs, 1000., 2000., 1., 40.);
+    EXPECT_LT(estimated, (estimate_order<designer_type::Butterworth, filter_type::LowPass>(fs, 1000., 2000., 1., 40.)));
+    EXPECT_EQ((estimate_order<designer_type::Elliptic, filter_type::BandPass>(fs, 2000., 4000., 1500., 5000., 1., 60.)),
+              5);
+}
+
+TEST(TestingOctaveBank, TonesFallInTheirBands) {
+    const auto fs = 48000.;
+    octave_bank<double> bank(fs, 16000., 10, 3, 0.5);
+    ASSERT_EQ(bank.bands(), 30);
+    EXPECT_NEAR(bank.frequency(29), 16000, 1e-9);
+    EXPECT_NEAR(bank.frequency(26), 8000, 1e-9);
+    EXPECT_NEAR(bank.frequency(0), 16000 * std::pow(2, -29. / 3), 1e-9);
+
+    // A unit sine at the midband frequency of a band, from the highest octave to the lowest one
+    std::vector<double> levels(bank.bands()), other(bank.bands());
+    for (const auto band : {29ul, 17ul, 5ul, 2ul}) {
+        std::vector<double> tone(96000);
+        for (auto i = 0ul; i < tone.size(); ++i) {
+            tone[i] = std::sin(2 * edsp::constants<double>::pi * bank.frequency(band) * i / fs);
+        }
+
+        bank.reset();
+        bank.filter(std::cbegin(tone), std::cend(tone));
+        bank.levels(std::begin(levels));
+        EXPECT_NEAR(levels[band], edsp::constants<double>::one_div_root_two, 0.01);
+        for (auto i = 0ul; i < bank.bands(); ++i) {
+            if (i + 1 < band || i > band + 1) {
+                EXPECT_LT(levels[i], 0.03);
+            }
+        }
+
+        // The levels do not depend on the size of the blocks
+        bank.reset();
+        for (auto i = 0ul; i < tone.size(); i += 1001) {
+            bank.filter(std::cbegin(tone) + i, std::cbegin(tone) + std::min(tone.size(), i + 1001));
+        }
+        bank.levels(std::begin(other));
+        for (auto i = 0ul; i < bank.bands(); ++i) {
+            EXPECT_NEAR(other[i], levels[i], 1e-9);
+        }
+    }
+}
+
+TEST(TestingGammatoneBank, MatchesComplexResonators) {
+    const auto fs = 16000.;
+    gammatone_bank<double> bank(fs, 100., 6000., 24);
+    ASSERT_EQ(bank.bands(), 24);
+    EXPECT_NEAR(bank.frequency(0), 100, 1e-9);
+    EXPECT_NEAR(bank.frequency(23), 6000, 1e-9);
+
+    // The centre frequencies are uniformly spaced on the ERB scale
+    const auto spacing = edsp::auditory::hertz2erb(bank.frequency(1)) - edsp::auditory::hertz2erb(bank.frequency(0));
+    for (auto k = 1ul; k < bank.bands(); ++k) {
+        EXPECT_GT(bank.frequency(k), bank.frequency(k - 1));
+        EXPECT_NEAR(edsp::auditory::hertz2erb(bank.frequency(k)) - edsp::auditory::hertz2erb(bank.frequency(k - 1)),
+                    spacing, 1e-9);
+    }
+
+    const auto input = make_signal(3000);
+    std::vector<double> output(input.size() * bank.bands());
+    const auto end = bank.filter(std::cbegin(input), std::cend(input), std::begin(output));
+    ASSERT_EQ(end, std::end(output));
+
+    // Reference: four complex one-pole resonators per band
+    const auto a_gamma = edsp::constants<double>::pi * 720 / (64 * 36); // pi (2n - 2)! / (2^(2n - 2) ((n - 1)!)^2)
+    for (auto k = 0ul; k < bank.bands(); ++k) {
+        const auto fc     = bank.frequency(k);
+        const auto lambda = std::exp(-2 * edsp::constants<double>::pi * (24.7 + fc / 9.26449) / (a_gamma * fs));
+        const auto pole   = std::polar(lambda, 2 * edsp::constants<double>::pi * fc / fs);
+        std::complex<double> state[4] = {};
+        for (auto i = 0ul; i < input.size(); ++i) {
+            auto value = 2 * std::pow(1 - lambda, 4) * std::complex<double>(input[i], 0);
+            for (auto& stage : state) {
+                stage = value + pole * stage;
+                value = stage;
+            }
+            EXPECT_NEAR(output[i * bank.bands() + k], value.real(), 1e-9);
+        }
+    }
+}
+
+TEST(TestingGammatoneBank, EnvelopeAndDecimation) {
+    const auto fs = 16000.;
+    gammatone_bank<double> bank(fs, 200., 4000., 16);
+
+    // A unit sine at the centre frequency of a band has a unit envelope and fine structure
+    for (const auto band : {0ul, 7ul, 15ul}) {
+        std::vector<double> tone(8000);
+        for (auto i = 0ul; i < tone.size(); ++i) {
+            tone[i] = std::cos(2 * edsp::constants<double>::pi * bank.frequency(band) * i / fs);
+        }
+
+        std::vector<double> envelope(tone.size() * bank.bands()), fine(tone.size() * bank.bands());
+        bank.reset();
+        bank.envelope(std::cbegin(tone), std::cend(tone), std::begin(envelope));
+        bank.reset();
+        bank.fine_structure(std::cbegin(tone), std::cend(tone), std::begin(fine));
+        for (auto i = tone.size() / 2; i < tone.size(); ++i) {
+            EXPECT_NEAR(envelope[i * bank.bands() + band], 1, 0.02);
+            EXPECT_NEAR(fine[i * bank.bands() + band], tone[i], 0.05);
+        }
+
+        // Both outputs in a single pass
+        std::vector<double> both_envelope(envelope.size()), both_fine(fine.size());
+        bank.reset();
+        const auto last = bank.envelope_and_fine_structure(std::cbegin(tone), std::cend(tone),
+                                                           std::begin(both_envelope), std::begin(both_fine));
+        EXPECT_EQ(last.first, std::end(both_envelope));
+        EXPECT_EQ(last.second, std::end(both_fine));
+        EXPECT_EQ(both_envelope, envelope);
+        EXPECT_EQ(both_fine, fine);
+    }
+
+    // The decimated outputs are every D-th frame of the full rate ones, whatever the size of the blocks
+    const auto input = make_signal(1000);
+    std::vector<double> full(input.size() * bank.bands());
+    bank.reset();
+    bank.envelope(std::cbegin(input), std::cend(input), std::begin(full));
+
+    const auto D = 4ul;
+    gammatone_bank<double> decimated(fs, 200., 4000., 16, D);
+    ASSERT_EQ(decimated.decimation(), D);
+    std::vector<double> output(input.size() / D * decimated.bands());
+    auto d_first = std::begin(output);
+    for (auto i = 0ul; i < input.size(); i += 77) {
+        const auto last = std::cbegin(input) + std::min(input.size(), i + 77);
+        d_first         = decimated.envelope(std::cbegin(input) + i, last, d_first);
+    }
+    ASSERT_EQ(d_first, std::end(output));
+    for (auto i = 0ul; i < output.size(); ++i) {
+        const auto frame = i / bank.bands(), k = i % bank.bands();
+        EXPECT_NEAR(output[i], full[frame * D * bank.bands() + k], 1e-12);
+    }
+}
+
+TEST(TestingFiltfilt, MatchesReference) {
+    const auto input   = make_signal(20000);
+    const auto cascade = make_filter<double, designer_type::Butterworth, filter_type::LowPass, 6>(6ul, 1000., 40.);
+    const auto biquad  = make_filter<double, designer_type::RBJ, filter_type::HighPass, 1>(10., 1000., 0.707);
+    EXPECT_EQ(filtfilt_padding(cascade), 21);
+
+    std::vector<double> output(input.size());
+    filtfilt(cascade, std::cbegin(input), std::cend(input), std::begin(output));
+    const auto expected = reference_filtfilt(cascade, input, 21);
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-9);
+    }
+
+    filtfilt(biquad, std::cbegin(input), std::cend(input), std::begin(output), 100);
+    const auto expected_biquad = reference_filtfilt(biquad, input, 100);
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected_biquad[i], 1e-9);
+    }
+
+    // A constant signal goes through a low pass filter without transients
+    const std::vector<double> constant(100, 3.0);
+    std::vector<double> flat(constant.size());
+    filtfilt(cascade, std::cbegin(constant), std::cend(constant), std::begin(flat));
+    for (const auto x : flat) {
+        EXPECT_NEAR(x, 3.0, 1e-9);
+    }
+}
+
+TEST(TestingFiltfilt, ZeroPhaseAndChannels) {
+    // A sinusoid in the passband keeps its phase
+    const auto size = 4000ul;
+    std::vector<double> sine(size);
+    for (auto i = 0ul; i < size; ++i) {
+        sine[i] = std::sin(2 * edsp::constants<double>::pi * 0.01 * i);
+    }
+    const std::vector<double> taps(31, 1.0 / 31);
+    const fir<double> smoother(std::cbegin(taps), std::cend(taps));
+    std::vector<double> smoothed(size);
+    filtfilt(smoother, std::cbegin(sine), std::cend(sine), std::begin(smoothed));
+
+    auto magnitude = std::complex<double>(0, 0);
+    for (auto k = 0ul; k < taps.size(); ++k) {
+        magnitude += taps[k] * std::polar(1.0, -2 * edsp::constants<double>::pi * 0.01 * k);
+    }
+    for (auto i = 500ul; i < size - 500; ++i) {
+        EXPECT_NEAR(smoothed[i], std::norm(magnitude) * sine[i], 1e-9);
+    }
+
+    // Every channel of an interleaved signal is filtered independently
+    const auto channels = 3ul;
+    const auto signal   = make_signal(channels * 3000);
+    const auto filter   = make_filter<double, designer_type::Butterworth, filter_type::HighPass, 4>(4ul, 1000., 5.);
+    std::vector<double> output(signal.size());
+    filtfilt(filter, std::cbegin(signal), std::cend(signal), std::begin(output), channels, 2);
+    for (auto channel = 0ul; channel < channels; ++channel) {
+        std::vector<double> planar(3000), expected(3000);
+        for (auto i = 0ul; i < planar.size(); ++i) {
+            planar[i] = signal[i * channels + channel];
+        }
+        filtfilt(filter, std::cbegin(planar), std::cend(planar), std::begin(expected));
+        for (auto i = 0ul; i < planar.size(); ++i) {
+            EXPECT_EQ(output[i * channels + channel], expected[i]);
+        }
+    }
+}
+
+TEST(TestingMovingAverage, MatchesReference) {
+    const auto channels = 5ul;
+    const auto frames   = 40000ul;
+    const auto window   = 37ul;
+    const auto signal   = make_signal(channels * frames);
+
+    // Blocks of different sizes, some of them crossing the end of the circular window
+    moving_average<double> average(window, channels);
+    moving_rms<double> rms(window, channels);
+    std::vector<double> means(signal.size()), levels(signal.size());
+    for (auto frame = 0ul, block = 1ul; frame < frames; frame += block, block = block * 3 % 101 + 1) {
+        const auto size = std::min(block, frames - frame) * channels;
+        average.filter(std::cbegin(signal) + frame * channels, std::cbegin(signal) + frame * channels + size,
+                       std::begin(means) + frame * channels);
+        rms.filter(std::cbegin(signal) + frame * channels, std::cbegin(signal) + frame * channels + size,
+                   std::begin(levels) + frame * channels);
+    }
+
+    for (auto channel = 0ul; channel < channels; ++channel) {
+        for (auto frame = 0ul; frame < frames; ++frame) {
+            const auto count = std::min(frame + 1, window);
+            auto sum = 0.0, squares = 0.0;
+            for (auto k = frame + 1 - count; k <= frame; ++k) {
+                sum += signal[k * channels + channel];
+                squares += signal[k * channels + channel] * signal[k * channels + channel];
+            }
+            EXPECT_NEAR(means[frame * channels + channel], sum / count, 1e-12);
+            EXPECT_NEAR(levels[frame * channels + channel], std::sqrt(squares / count), 1e-12);
+        }
+    }
+
+    // The single element interface shares the state of the block one
+    moving_average<double> ticked(window);
+    moving_rms<double> ticked_rms(window);
+    std::vector<double> expected(frames);
+    for (auto frame = 0ul; frame < frames; ++frame) {
+        expected[frame] = signal[frame * channels];
+    }
+    ticked.filter(std::cbegin(expected), std::cbegin(expected) + 10, std::begin(means));
+    ticked_rms.filter(std::cbegin(expected), std::cbegin(expected) + 10, std::begin(levels));
+    EXPECT_NEAR(ticked(expected[10]), std::accumulate(std::cbegin(expected), std::cbegin(expected) + 11, 0.0) / 11, 1e-12);
+    EXPECT_NEAR(ticked_rms(0.0), levels[9] * std::sqrt(10.0 / 11), 1e-12);
+
+    ticked.reset();
+    EXPECT_EQ(ticked(2.0), 2.0);
+}
+
+TEST(TestingMovingExtremum, MatchesReference) {
+    const auto channels = 3ul;
+    const auto frames   = 5000ul;
+    const auto window   = 50ul;
+    const auto signal   = make_signal(channels * frames);
+
+    moving_max<double, 64> maximum(window, channels);
+    moving_min<double, 64> minimum(window, channels);
+    moving_peak<double, 64> peak(window, channels);
+    std::vector<double> maxima(signal.size()), minima(signal.size()), peaks(signal.size());
+    for (auto frame = 0ul, block = 1ul; frame < frames; frame += block, block = block * 7 % 97 + 1) {
+        const auto begin = std::cbegin(signal) + frame * channels;
+        const auto end   = begin + std::min(block, frames - frame) * channels;
+        maximum.filter(begin, end, std::begin(maxima) + frame * channels);
+        minimum.filter(begin, end, std::begin(minima) + frame * channels);
+
+        // A copy keeps filtering from the same state
+        auto copy = peak;
+        copy.filter(begin, end, std::begin(peaks) + frame * channels);
+        peak = std::move(copy);
+    }
+
+    for (auto channel = 0ul; channel < channels; ++channel) {
+        for (auto frame = 0ul; frame < frames; ++frame) {
+            const auto count  = std::min(frame + 1, window);
+            auto expected_max = -std::numeric_limits<double>::infinity();
+            auto expected_min = std::numeric_limits<double>::infinity();
+            auto expected_abs = 0.0;
+            for (auto k = frame + 1 - count; k <= frame; ++k) {
+                const auto value = signal[k * channels + channel];
+                expected_max     = std::max(expected_max, value);
+                expected_min     = std::min(expected_min, value);
+                expected_abs     = std::max(expected_abs, std::abs(value));
+            }
+            EXPECT_EQ(maxima[frame * channels + channel], expected_max);
+            EXPECT_EQ(minima[frame * channels + channel], expected_min);
+            EXPECT_EQ(peaks[frame * channels + channel], expected_abs);
+        }
+    }
+
+    // A window of one element follows the input
+    moving_max<double, 64> identity(1);
+    for (auto i = 0ul; i < 100; ++i) {
+        EXPECT_EQ(identity(signal[i]), signal[i]);
+    }
+}
+
+TEST(TestingLookaheadCascade, MatchesRecursion) {
+    const auto input = make_signal(1237);
+    auto cascade     = make_filter<double, designer_type::Butterworth, filter_type::LowPass, 8>(8ul, 1e6, 2e3);
+    std::vector<double> expected(input.size()), output(input.size());
+    cascade.filter(std::cbegin(input), std::cend(input), std::begin(expected));
+
+    // The blocks and the samples left at the end of every range share the same states
+    lookahead_cascade<double, 16> lookahead(cascade);
+    ASSERT_EQ(lookahead.size(), 4);
+    for (auto i = 0ul; i < input.size(); i += 101) {
+        const auto last = std::min(input.size(), i + 101);
+        lookahead.filter(std::cbegin(input) + i, std::cbegin(input) + last, std::begin(output) + i);
+    }
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-9);
+    }
+
+    auto stage = make_filter<double, designer_type::RBJ, filter_type::BandPass, 1>(1e3, 44100., 4.);
+    stage.filter(std::cbegin(input), std::cend(input), std::begin(expected));
+    lookahead_cascade<double> single(stage);
+    single.filter(std::cbegin(input), std::cend(input), std::begin(output));
+    for (auto i = 0ul; i < input.size(); ++i) {
+        EXPECT_NEAR(output[i], expected[i], 1e-9);
+    }
+
+    single.reset();
+    single.filter(std::cbegin(input), std::cend(input), std::begin(output));
+    EXPECT_NEAR(output.back(), expected.back(), 1e-9);
+}
+
+TEST(TestingFreqz, MatchesDirectEvaluation) {
+    const auto K       = 1000ul;
+    const auto cascade = make_filter<double, designer_type::Butterworth, filter_type::LowPass, 6>(6ul, 1000., 100.);
+    const auto result  = freqz(cascade, K);
+    ASSERT_EQ(result.magnitude.size(), K);
+
+    for (auto k = 0ul; k < K; ++k) {
+        const auto expected = response(cascade, 0.5 * k / K);
+        EXPECT_NEAR(result.magnitude[k], std::abs(expected), 1e-9);
+        if (std::abs(expected) > 1e-6) {
+            EXPECT_NEAR(std::remainder(result.phase[k] - std::arg(expected), 2 * edsp::constants<double>::pi), 0, 1e-9);
+        }
+    }
+
+    // The group delay is the derivative of the unwrapped phase
+    const auto step = edsp::constants<double>::pi / K;
+    for (auto k = 1ul; k + 1 < K / 4; ++k) {
+        const auto difference = std::remainder(result.phase[k + 1] - result.phase[k - 1], 2 * edsp::constants<double>::pi);
+        EXPECT_NEAR(result.group_delay[k], -difference / (2 * step), 1e-2);
+    }
+
+    // A symmetric FIR filter has linear phase and a constant group delay
+    const std::vector<double> taps = {0.1, 0.2, 0.4, 0.2, 0.1}, one = {1.0};
+    const auto fir_response        = freqz(std::cbegin(taps), std::cend(taps), std::cbegin(one), std::cend(one), K);
+    for (auto k = 0ul; k < K / 2; ++k) {
+        EXPECT_NEAR(fir_response.group_delay[k], 2.0, 1e-9);
+    }
+}
+
+TEST(TestingFreqz, HighPassZerosAtDirectCurrent) {
+    // The zeros of the high-pass filters lie at z = 1, the first frequency of the grid
+    const auto K      = 1000ul;
+    const auto biquad = make_filter<double, designer_type::RBJ, filter_type::HighPass, 1>(100., 1000., 0.707);
+    const auto high   = make_filter<double, designer_type::Butterworth, filter_type::HighPass, 6>(6ul, 1000., 100.);
+    for (const auto& result : {freqz(biquad, K), freqz(high, K)}) {
+        EXPECT_EQ(result.magnitude[0], 0);
+        for (auto k = 0ul; k < K; ++k) {
+            EXPECT_TRUE(std::isfinite(result.group_delay[k]));
+        }
+        EXPECT_NEAR(result.group_delay[0], result.group_delay[1], 1e-2);
+    }
+
+    // The taps sum to a tiny value instead of zero, the zero at DC is found within the tolerance
+    const std::vector<double> taps = {0.1, -0.3, 0.2}, one = {1.0};
+    ASSERT_NE(taps[0] + taps[1] + taps[2], 0);
+    const auto rounded = freqz(std::cbegin(taps), std::cend(taps), std::cbegin(one), std::cend(one), K);
+    EXPECT_NEAR(rounded.group_delay[0], rounded.group_delay[1], 1e-2);
+}
@@ -21,5 +21,959 @@
 */
 
 #include <edsp/io.hpp>
+#include <edsp/math/constant.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
 
 template class edsp::io::decoder<float>;
+template struct edsp::io::polyphase_resampler<float>;
+template struct edsp::io::mmap_decoder<std::int16_t>;
+
+using namespace edsp;
+
+namespace {
+
+    using bytes = std::vector<std::uint8_t>;
+
+    void append(bytes& data, std::uint64_t value, std::size_t width, io::byte_order order) {
+        for (std::size_t i = 0; i < width; ++i) {
+            const auto shift = 8 * ((order == io::byte_order::little) ? i : width - 1 - i);
+            data.push_back(static_cast<std::uint8_t>(value >> shift));
+        }
+    }
+
+    void append(bytes& data, const char* tag) {
+        data.insert(std::end(data), tag, tag + 4);
+    }
+
+    void save(const std::string& path, const bytes& data) {
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    bytes make_wav(std::uint32_t tag, std::uint32_t bits, std::uint32_t channels, const bytes& samples) {
+        const auto order = io::byte_order::little;
+        bytes data;
+        append(data, "RIFF");
+        append(data, 36 + samples.size(), 4, order);
+        append(data, "WAVE");
+        append(data, "fmt ");
+        append(data, 16, 4, order);
+        append(data, tag, 2, order);
+        append(data, channels, 2, order);
+        append(data, 48000, 4, order);
+        append(data, 48000 * channels * bits / 8, 4, order);
+        append(data, channels * bits / 8, 2, order);
+        append(data, bits, 2, order);
+        append(data, "data");
+        append(data, samples.size(), 4, order);
+        data.insert(std::end(data), std::begin(samples), std::end(samples));
+        return data;
+    }
+
+    bytes make_aiff(std::uint32_t bits, std::uint32_t channels, const bytes& samples) {
+        const auto order = io::byte_order::big;
+        bytes data;
+        append(data, "FORM");
+        append(data, 46 + samples.size(), 4, order);
+        append(data, "AIFF");
+        append(data, "COMM");
+        append(data, 18, 4, order);
+        append(data, channels, 2, order);
+        append(data, samples.size() / (channels * bits / 8), 4, order);
+        append(data, bits, 2, order);
+        append(data, 16383 + 15, 2, order);
+        append(data, std::uint64_t{44100} << 48, 8, order);
+        append(data, "SSND");
+        append(data, 8 + samples.size(), 4, order);
+        append(data, 0, 8, order);
+        data.insert(std::end(data), std::begin(samples), std::end(samples));
+        return data;
+    }
+
+} // namespace
+
+TEST(TestingPolyphaseResampler, ExactOutputLength) {
+    const auto frames = 10000l;
+    for (const auto quality : {io::best_quality, io::sinc_fastest, io::linear}) {
+        io::polyphase_resampler<float> resampler(2, quality, 48000l, 44100l);
+        std::vector<float> input(2 * frames, 1), output(2 * frames);
+
+        auto produced = 0l;
+        for (auto position = 0l, chunk = 37l; position < frames; position += chunk, chunk = chunk * 7 % 1500 + 1) {
+            const auto size     = 2 * std::min(chunk, frames - position);
+            const auto expected = resampler.output_size(size);
+            const auto first    = std::cbegin(input) + 2 * position;
+            const auto computed = resampler.process(first, first + size, std::begin(output) + produced);
+            EXPECT_EQ(computed, expected);
+            produced += computed;
+        }
+        produced += resampler.flush(std::begin(output) + produced);
+        EXPECT_EQ(produced, 2 * static_cast<long>(std::ceil(frames * 44100.0 / 48000.0)));
+    }
+}
+
+TEST(TestingPolyphaseResampler, RationalUpsampling) {
+    const auto frames    = 4096l;
+    const auto frequency = 1000.0;
+    std::vector<float> input(frames), output(3 * frames);
+    for (auto i = 0l; i < frames; ++i) {
+        input[i] = static_cast<float>(std::sin(2 * constants<double>::pi * frequency * i / 16000));
+    }
+
+    io::polyphase_resampler<float> resampler(1, io::best_quality, 16000l, 48000l);
+    auto produced = resampler.process(std::cbegin(input), std::cend(input), std::begin(output));
+    produced += resampler.flush(std::begin(output) + produced);
+    EXPECT_EQ(produced, 3 * frames);
+    for (auto n = produced / 10; n < produced * 9 / 10; ++n) {
+        EXPECT_NEAR(output[n], std::sin(2 * constants<double>::pi * frequency * n / 48000), 1e-4);
+    }
+}
+
+TEST(TestingPolyphaseResampler, StopBandAtDecimation) {
+    const auto frames = 48000l;
+    const auto rms    = [](const std::vector<double>& output, long produced) {
+        auto energy = 0.0;
+        for (auto n = produced / 4; n < produced * 3 / 4; ++n) {
+            energy += output[n] * output[n];
+        }
+        return std::sqrt(energy / static_cast<double>(produced / 2));
+    };
+
+    // From 48 kHz to 12 kHz, a tone just above the new Nyquist frequency has to be rejected
+    const auto attenuation = {1e-4, 1e-4, 1e-3};
+    auto expected          = std::begin(attenuation);
+    for (const auto quality : {io::best_quality, io::medium_quality, io::sinc_fastest}) {
+        for (const auto frequency : {1000.0, 6500.0}) {
+            std::vector<double> input(frames), output(frames);
+            for (auto i = 0l; i < frames; ++i) {
+                input[i] = std::sin(2 * constants<double>::pi * frequency * i / 48000);
+            }
+
+            io::polyphase_resampler<double> resampler(1, quality, 48000l, 12000l);
+            const auto produced = resampler.process(std::cbegin(input), std::cend(input), std::begin(output));
+            if (frequency < 6000) {
+                EXPECT_NEAR(rms(output, produced), std::sqrt(0.5), 1e-2);
+            } else {
+                EXPECT_LT(rms(output, produced), *expected);
+            }
+        }
+        ++expected;
+    }
+}
+
+TEST(TestingPolyphaseResampler, ArbitraryRatio) {
+    const auto frames = 4096l;
+    const auto factor = 1.2345f;
+    std::vector<float> input(frames, 0.5f), output(2 * frames);
+
+    io::resampler<float> resampler(1, io::medium_quality, factor);
+    const auto produced = resampler.process(std::cbegin(input), std::cend(input), std::begin(output));
+    EXPECT_GT(produced, 0);
+    for (auto n = produced / 10; n < produced; ++n) {
+        EXPECT_NEAR(output[n], 0.5f, 1e-4);
+    }
+}
+
+#if !defined(USE_LIBSAMPLERATE) && !defined(USE_LIBRESAMPLE)
+
+TEST(TestingPolyphaseResampler, FacadeFlush) {
+    const auto frames = 5000l;
+    const auto factor = 0.8f;
+    std::vector<float> input(2 * frames, 0.5f), output(2 * frames);
+
+    io::resampler<float> resampler(2, io::medium_quality, factor);
+    const auto expected = resampler.output_size(2 * frames);
+    auto produced       = resampler.process(std::cbegin(input), std::cend(input), std::begin(output));
+    EXPECT_EQ(produced, expected);
+    produced += resampler.flush(std::begin(output) + produced);
+    EXPECT_EQ(produced, 2 * static_cast<long>(std::ceil(frames * factor)));
+}
+
+#endif
+
+#if defined(USE_LIBSAMPLERATE)
+
+namespace {
+
+    std::atomic<std::size_t> allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (auto* pointer = std::malloc(size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC pairs the call to std::free with the operator new inlined in the callers
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#    pragma GCC diagnostic pop
+#endif
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+TEST(TestingLibsamplerateResampler, IteratorConsumesInput) {
+    const auto frames = 10000l;
+    const auto factor = 2.0f;
+    std::vector<float> input(2 * frames, 0.5f), output(2 * 3 * frames);
+
+    // A short output leaves samples buffered in the resampler, which must not drop the input of the next calls
+    io::libsamplerate_resampler<float> resampler(2, io::medium_quality, factor);
+    const auto start =
+        resampler.process(span<const float>(input.data(), 2 * 100), span<float>(output.data(), 2 * 10), false);
+    ASSERT_EQ(start.produced, 2 * 10);
+    auto produced = start.produced;
+    for (auto position = start.consumed / 2; position < frames; position += 100) {
+        const auto first = std::cbegin(input) + 2 * position;
+        const auto last  = std::cbegin(input) + 2 * std::min(position + 100, frames);
+        produced += resampler.process(first, last, std::begin(output) + produced);
+    }
+    const auto tail = resampler.flush(span<float>(output.data() + produced, output.size() - produced));
+    EXPECT_GT(tail, 0);
+    produced += tail;
+    EXPECT_NEAR(produced, 2 * frames * factor, 2 * factor);
+    for (auto n = 0l; n < produced; ++n) {
+        EXPECT_FLOAT_EQ(output[n], 0.5f);
+    }
+}
+
+TEST(TestingLibsamplerateResampler, IteratorBoundedOutput) {
+    const auto frames   = 100l;
+    const auto factor   = 2.0f;
+    const auto capacity = 2 * static_cast<long>(std::ceil(frames * factor) + 1);
+    std::vector<float> input(2 * frames, 0.5f), output(static_cast<std::size_t>(capacity) + 16);
+
+    // The samples held back by a short output span do not fit in the output expected for the next input
+    io::libsamplerate_resampler<float> resampler(2, io::medium_quality, factor);
+    resampler.process(span<const float>(input.data(), input.size()), span<float>(output.data(), 2 * 10), false);
+    auto produced = 0l;
+    for (auto i = 0; i < 4; ++i) {
+        std::fill(std::begin(output), std::end(output), -1.0f);
+        const auto computed = resampler.process(std::cbegin(input), std::cend(input), std::begin(output));
+        EXPECT_LE(computed, capacity);
+        EXPECT_TRUE(std::all_of(std::cbegin(output) + computed, std::cend(output), [](float x) { return x == -1.0f; }));
+        produced += computed;
+    }
+    EXPECT_GT(produced, 0);
+}
+
+TEST(TestingLibsamplerateResampler, SpanProcessAndFlush) {
+    const auto frames = 10000l;
+    const auto factor = 0.75f;
+    std::vector<double> input(frames, 0.25), output(frames);
+
+    io::libsamplerate_resampler<double> resampler(1, io::medium_quality, factor);
+    span<const double> pending(input.data(), input.size());
+    auto produced = 0l;
+
+    // Small output spans force the caller to feed the remaining input again, without allocating memory
+    const auto before = allocations.load();
+    while (!pending.empty()) {
+        const auto available = std::min(output.size() - static_cast<std::size_t>(produced), std::size_t{333});
+        const auto result    = resampler.process(pending, span<double>(output.data() + produced, available));
+        ASSERT_TRUE(result.consumed > 0 || result.produced > 0);
+        pending  = pending.subspan(result.consumed);
+        produced += result.produced;
+    }
+    while (const auto tail = resampler.flush(span<double>(output.data() + produced, output.size() - produced))) {
+        produced += tail;
+    }
+    EXPECT_EQ(allocations.load(), before);
+
+    EXPECT_NEAR(produced, frames * factor, 2);
+    for (auto n = 0l; n < produced; ++n) {
+        EXPECT_NEAR(output[n], 0.25, 1e-6);
+    }
+    EXPECT_EQ(resampler.flush(span<double>(output.data() + produced, output.size() - produced)), 0);
+}
+
+#endif
+
+TEST(TestingAsrc, NominalRatio) {
+    const auto frames = 4096l;
+    std::vector<float> input(2 * frames), output(2 * frames);
+    for (auto i = 0l; i < 2 * frames; ++i) {
+        input[i] = static_cast<float>(std::sin(0.01 * i));
+    }
+
+    io::asrc<float> converter(2, 1.0f, 512, io::best_quality);
+    auto pushed = 0l, pulled = 0l;
+    while (pulled < 2 * (frames - converter.latency())) {
+        const auto count = std::min(2 * 100l, 2 * frames - pushed);
+        pushed += converter.push(std::cbegin(input) + pushed, std::cbegin(input) + pushed + count);
+        pulled += converter.pull(std::begin(output) + pulled, 2 * 64);
+    }
+
+    for (auto n = pulled / 10; n < pulled; ++n) {
+        EXPECT_NEAR(output[n], input[n], 1e-4);
+    }
+}
+
+TEST(TestingAsrc, SmoothRatioChange) {
+    const auto frames    = 48000l;
+    const auto increment = 2 * constants<double>::pi * 100 / 48000;
+    std::vector<float> input(frames), output(2 * frames);
+    for (auto i = 0l; i < frames; ++i) {
+        input[i] = static_cast<float>(std::sin(increment * i));
+    }
+
+    io::asrc<float> converter(1, 1.0f, 1024, io::medium_quality);
+    converter.set_smoothing(256);
+    auto pushed = 0l, pulled = 0l;
+    while (pushed < frames) {
+        pushed += converter.push(std::cbegin(input) + pushed, std::cbegin(input) + std::min(pushed + 128, frames));
+        pulled += converter.pull(std::begin(output) + pulled, 128);
+        if (pulled > frames / 4) {
+            converter.set_ratio(1.05f);
+        }
+    }
+    EXPECT_NEAR(converter.ratio(), 1.05f, 1e-6);
+
+    // The slope of the output can never exceed the slope of the input, any discontinuity would show up here.
+    for (auto n = 1024l; n < pulled; ++n) {
+        EXPECT_LE(std::abs(output[n] - output[n - 1]), increment * 1.001);
+    }
+}
+
+TEST(TestingAsrc, RatioChangeRedesignsFilter) {
+    // The tone is above the Nyquist frequency of the output once the ratio drops to 0.5
+    const auto frames = 8192l;
+    std::vector<float> input(frames), output(frames);
+    for (auto i = 0l; i < frames; ++i) {
+        input[i] = static_cast<float>(std::sin(2 * constants<double>::pi * 0.4 * i));
+    }
+
+    io::asrc<float> converter(1, 1.0f, 1024, io::best_quality);
+    converter.set_smoothing(0);
+    converter.set_ratio(0.5f);
+    auto copy   = converter;
+    auto pushed = 0l, pulled = 0l;
+    while (pushed < frames) {
+        pushed += converter.push(std::cbegin(input) + pushed, std::cbegin(input) + std::min(pushed + 256, frames));
+        pulled += converter.pull(std::begin(output) + pulled, 256);
+    }
+    ASSERT_GT(pulled, frames / 4);
+
+    auto energy = 0.0;
+    for (auto n = pulled / 4; n < pulled; ++n) {
+        energy += static_cast<double>(output[n]) * output[n];
+    }
+    EXPECT_LT(std::sqrt(energy / (pulled - pulled / 4)), 1e-2);
+
+    // The copy keeps its own history and produces the same samples
+    std::vector<float> copied(256);
+    copy.push(std::cbegin(input), std::cbegin(input) + 256);
+    const auto count = copy.pull(std::begin(copied), 256);
+    for (auto n = 0l; n < count; ++n) {
+        EXPECT_EQ(copied[n], output[n]);
+    }
+}
+
+TEST(TestingDriftController, SettlesAtTarget) {
+    const auto block  = 64l;
+    const auto target = 512.0;
+    const auto drift  = 1.0005;
+    std::vector<float> input(block, 0.25f), output(block);
+
+    io::asrc<float> converter(1, 1.0f, 4096);
+    io::drift_controller<double> controller(target, 0.1, 3e-4, 0.01);
+    converter.set_smoothing(0);
+    for (auto i = 0; i < target / block; ++i) {
+        converter.push(std::cbegin(input), std::cend(input));
+    }
+
+    // The producer runs slightly faster than the consumer: the buffer level grows unless the ratio is corrected. The
+    // consumer skips a whole block from time to time, so the correction is checked on average.
+    auto clock = 0.0, average = 0.0;
+    for (auto tick = 0; tick < 10000; ++tick) {
+        converter.push(std::cbegin(input), std::cend(input));
+        for (clock += 1 / drift; clock >= 1; clock -= 1) {
+            EXPECT_EQ(converter.pull(std::begin(output), block), block);
+            converter.set_ratio(static_cast<float>(controller.update(converter.available())));
+        }
+
+        if (tick >= 6000) {
+            EXPECT_NEAR(converter.available(), target, 2 * block);
+            average += controller.correction() / 4000;
+        }
+    }
+    EXPECT_NEAR(average, 1 / drift, 1e-5);
+}
+
+TEST(TestingMmapDecoder, WavFormats) {
+    const auto path     = std::string("testing_mmap_decoder.wav");
+    const auto channels = 2u;
+    const auto samples  = 2 * 1000;
+    std::vector<float> expected(samples);
+    for (auto i = 0; i < samples; ++i) {
+        expected[i] = static_cast<float>(std::sin(0.01 * i) * 0.9);
+    }
+
+    for (const auto bits : {16u, 24u, 32u}) {
+        bytes encoded;
+        for (const auto value : expected) {
+            const auto scale = static_cast<double>(1u << (bits - 1));
+            append(encoded, static_cast<std::uint64_t>(std::lround(value * scale)), bits / 8, io::byte_order::little);
+        }
+        save(path, make_wav(1, bits, channels, encoded));
+
+        io::decoder<float> decoder;
+        ASSERT_TRUE(decoder.open(path));
+        EXPECT_EQ(decoder.channels(), channels);
+        EXPECT_EQ(decoder.frames(), samples / channels);
+        EXPECT_EQ(decoder.samplerate(), 48000);
+
+        std::vector<float> decoded(samples + 1);
+        EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), samples);
+        for (auto i = 0; i < samples; ++i) {
+            EXPECT_NEAR(decoded[i], expected[i], 1.0 / (1u << (bits - 2)));
+        }
+        EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), 0);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TestingMmapDecoder, ZeroCopyView) {
+    const auto path = std::string("testing_mmap_decoder.wav");
+    std::vector<float> expected(512);
+    bytes encoded;
+    for (auto i = 0ul; i < expected.size(); ++i) {
+        expected[i] = static_cast<float>(i) / expected.size();
+        std::uint32_t bits;
+        std::memcpy(&bits, &expected[i], sizeof(bits));
+        append(encoded, bits, 4, io::byte_order::little);
+    }
+    save(path, make_wav(3, 32, 1, encoded));
+
+    io::mmap_decoder<float> decoder;
+    ASSERT_TRUE(decoder.open(path));
+    EXPECT_EQ(decoder.format(), io::pcm_format::float32);
+    const auto view = decoder.view();
+    if (io::native_byte_order() == io::byte_order::little) {
+        ASSERT_EQ(view.size(), static_cast<std::ptrdiff_t>(expected.size()));
+        EXPECT_TRUE(std::equal(std::begin(view), std::end(view), std::begin(expected)));
+    }
+
+    EXPECT_EQ(decoder.seek(500), 500);
+    std::vector<float> tail(100);
+    EXPECT_EQ(decoder.read(tail.data(), tail.data() + tail.size()), 12);
+    EXPECT_TRUE(std::equal(std::begin(tail), std::begin(tail) + 12, std::begin(expected) + 500));
+
+    io::mmap_decoder<double> converter;
+    ASSERT_TRUE(converter.open(path));
+    EXPECT_TRUE(converter.view().empty());
+    std::remove(path.c_str());
+}
+
+TEST(TestingMmapDecoder, ContiguousOutputs) {
+    static_assert(meta::is_contiguous_iterator<float*>::value, "Expected a contiguous iterator");
+    static_assert(meta::is_contiguous_iterator<std::vector<float>::iterator>::value, "Expected a contiguous iterator");
+    static_assert(!meta::is_contiguous_iterator<std::vector<bool>::iterator>::value, "Expected a bit iterator");
+    static_assert(!meta::is_contiguous_iterator<std::back_insert_iterator<std::vector<float>>>::value,
+                  "Expected an output iterator");
+
+    const auto path = std::string("testing_mmap_decoder.wav");
+    std::vector<float> expected(2 * 256);
+    bytes encoded;
+    for (auto i = 0ul; i < expected.size(); ++i) {
+        expected[i] = static_cast<float>(i) / expected.size();
+        std::uint32_t bits;
+        std::memcpy(&bits, &expected[i], sizeof(bits));
+        append(encoded, bits, 4, io::byte_order::little);
+    }
+    save(path, make_wav(3, 32, 2, encoded));
+
+    // The internal buffer can not hold a frame, so the vector has to be decoded in place
+    io::mmap_decoder<float, 1> decoder;
+    ASSERT_TRUE(decoder.open(path));
+    std::vector<float> decoded(expected.size());
+    EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), static_cast<long>(expected.size()));
+    EXPECT_EQ(decoded, expected);
+    EXPECT_EQ(decoder.read(std::begin(decoded), std::begin(decoded)), 0);
+    std::remove(path.c_str());
+}
+
+TEST(TestingMmapDecoder, AiffAndRaw) {
+    const auto path = std::string("testing_mmap_decoder.aiff");
+    std::vector<std::int16_t> expected(300);
+    bytes encoded;
+    for (auto i = 0ul; i < expected.size(); ++i) {
+        expected[i] = static_cast<std::int16_t>(i * 200 - 30000);
+        append(encoded, static_cast<std::uint16_t>(expected[i]), 2, io::byte_order::big);
+    }
+
+    save(path, make_aiff(16, 3, encoded));
+    io::mmap_decoder<std::int16_t> decoder;
+    ASSERT_TRUE(decoder.open(path));
+    EXPECT_EQ(decoder.channels(), 3);
+    EXPECT_EQ(decoder.frames(), 100);
+    EXPECT_EQ(decoder.samplerate(), 44100);
+
+    std::vector<std::int16_t> decoded(expected.size());
+    EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), static_cast<long>(expected.size()));
+    EXPECT_EQ(decoded, expected);
+
+    save(path, encoded);
+    ASSERT_TRUE(decoder.open(path, io::pcm_format::int16, io::byte_order::big, 1, 8000));
+    EXPECT_EQ(decoder.frames(), static_cast<long>(expected.size()));
+    std::fill(std::begin(decoded), std::end(decoded), 0);
+    EXPECT_EQ(decoder.read(decoded.data(), decoded.data() + decoded.size()), static_cast<long>(expected.size()));
+    EXPECT_EQ(decoded, expected);
+    std::remove(path.c_str());
+}
+
+TEST(TestingAsyncDecoder, MatchesSynchronousDecoding) {
+    const auto path     = std::string("testing_async_decoder.wav");
+    const auto channels = 2;
+    const auto frames   = 10000;
+    bytes encoded;
+    for (auto i = 0; i < channels * frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i * 7), 2, io::byte_order::little);
+    }
+    save(path, make_wav(1, 16, channels, encoded));
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(path));
+    std::vector<float> expected(channels * frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), channels * frames);
+
+    io::async_decoder<float> decoder(1000, 3);
+    ASSERT_TRUE(decoder.open(path));
+    EXPECT_EQ(decoder.channels(), channels);
+    EXPECT_EQ(decoder.frames(), frames);
+
+    std::vector<float> decoded(channels * frames);
+    auto total = 0l;
+    for (auto read = 1l; read > 0; total += read) {
+        read = decoder.read(std::begin(decoded) + total, std::begin(decoded) + std::min(total + 333l, 2l * frames));
+    }
+    EXPECT_EQ(total, channels * frames);
+    EXPECT_EQ(decoded, expected);
+    EXPECT_EQ(decoder.current(), frames);
+
+    for (const auto position : {5000l, 123l, 9990l, 0l}) {
+        EXPECT_EQ(decoder.seek(position), position);
+        std::vector<float> chunk(100);
+        const auto read = decoder.read(std::begin(chunk), std::end(chunk));
+        EXPECT_EQ(read, std::min(100l, channels * (frames - position)));
+        EXPECT_TRUE(std::equal(std::begin(chunk), std::begin(chunk) + read, std::begin(expected) + channels * position));
+        EXPECT_EQ(decoder.current(), position + read / channels);
+    }
+
+    // A seek past the end fails without moving the position, as in the synchronous decoder
+    std::vector<float> chunk(100);
+    EXPECT_EQ(decoder.seek(frames + 100), -1);
+    EXPECT_EQ(decoder.current(), 50);
+    EXPECT_EQ(decoder.read(std::begin(chunk), std::end(chunk)), 100);
+    EXPECT_TRUE(std::equal(std::begin(chunk), std::end(chunk), std::begin(expected) + channels * 50));
+    EXPECT_EQ(decoder.seek(frames), frames);
+    EXPECT_EQ(decoder.read(std::begin(chunk), std::end(chunk)), 0);
+    EXPECT_EQ(decoder.seek(10), 10);
+    EXPECT_EQ(decoder.read(std::begin(chunk), std::end(chunk)), 100);
+    EXPECT_TRUE(std::equal(std::begin(chunk), std::end(chunk), std::begin(expected) + channels * 10));
+
+    decoder.close();
+    EXPECT_FALSE(decoder.is_open());
+    std::remove(path.c_str());
+}
+
+TEST(TestingMmapDecoder, PlanarRead) {
+    const auto path     = std::string("testing_mmap_decoder.wav");
+    const auto channels = 6;
+    const auto frames   = 3000;
+    bytes encoded;
+    for (auto i = 0; i < channels * frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i), 2, io::byte_order::little);
+    }
+    save(path, make_wav(1, 16, channels, encoded));
+
+    io::decoder<std::int16_t, 512> decoder;
+    ASSERT_TRUE(decoder.open(path));
+    std::vector<std::vector<std::int16_t>> planar(channels, std::vector<std::int16_t>(frames + 10));
+    std::vector<std::vector<std::int16_t>::iterator> outputs;
+    for (auto& channel : planar) {
+        outputs.push_back(std::begin(channel));
+    }
+
+    EXPECT_EQ(decoder.read_planar(std::begin(outputs), std::end(outputs), frames + 10), frames);
+    for (auto c = 0; c < channels; ++c) {
+        for (auto i = 0; i < frames; ++i) {
+            EXPECT_EQ(planar[c][i], static_cast<std::int16_t>(i * channels + c));
+        }
+    }
+
+    // The samples have to be converted, so they are split from the blocks decoded in the internal buffer
+    io::decoder<float, 512> converter;
+    ASSERT_TRUE(converter.open(path));
+    std::vector<std::vector<float>> converted(channels, std::vector<float>(frames));
+    std::vector<float*> pointers;
+    for (auto& channel : converted) {
+        pointers.push_back(channel.data());
+    }
+    EXPECT_EQ(converter.read_planar(std::begin(pointers), std::end(pointers), 1000), 1000);
+    for (auto& pointer : pointers) {
+        pointer += 1000;
+    }
+    EXPECT_EQ(converter.read_planar(std::begin(pointers), std::end(pointers), frames), frames - 1000);
+    for (auto c = 0; c < channels; ++c) {
+        for (auto i = 0; i < frames; ++i) {
+            EXPECT_FLOAT_EQ(converted[c][i], static_cast<std::int16_t>(i * channels + c) / 32768.0f);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TestingEncoder, Quantization) {
+    const auto size = 4096ul;
+    std::vector<float> data(size);
+    std::vector<std::int32_t> quantized(size), dithered(size);
+    for (auto i = 0ul; i < size; ++i) {
+        data[i] = static_cast<float>(std::sin(0.001 * i) * 1.1);
+    }
+
+    io::tpdf_dither dither;
+    io::quantize_pcm(data.data(), size, 16, quantized.data());
+    io::quantize_pcm(data.data(), size, 16, dithered.data(), &dither);
+    auto mean = 0.0;
+    for (auto i = 0ul; i < size; ++i) {
+        const auto scaled   = std::min(std::max(data[i] * 32768.0, -32768.0), 32767.0);
+        const auto expected = std::round(scaled);
+        EXPECT_EQ(quantized[i] >> 16, expected);
+        EXPECT_EQ(quantized[i] & 0xFFFF, 0);
+        EXPECT_LE(std::abs((dithered[i] >> 16) - expected), 1);
+        mean += ((dithered[i] >> 16) - scaled) / size;
+    }
+    EXPECT_NEAR(mean, 0, 0.1);
+}
+
+TEST(TestingEncoder, RoundTrip) {
+    const auto path     = std::string("testing_encoder.wav");
+    const auto channels = 2;
+    const auto frames   = 20000;
+    std::vector<float> data(channels * frames);
+    for (auto i = 0; i < channels * frames; ++i) {
+        data[i] = static_cast<float>(std::sin(0.003 * i) * 0.8);
+    }
+
+    for (const auto depth : {0l, 3l}) {
+        for (const auto format : {io::pcm_format::int16, io::pcm_format::int24, io::pcm_format::float32}) {
+            io::encoder<float> encoder(1000, depth);
+            ASSERT_TRUE(encoder.open(path, channels, 44100, format));
+            for (auto position = 0; position < channels * frames; position += 2 * 777) {
+                const auto last = std::min(position + 2 * 777, channels * frames);
+                EXPECT_EQ(encoder.write(std::cbegin(data) + position, std::cbegin(data) + last), last - position);
+            }
+            EXPECT_EQ(encoder.frames(), frames);
+            encoder.close();
+
+            io::decoder<float> decoder;
+            ASSERT_TRUE(decoder.open(path));
+            EXPECT_EQ(decoder.frames(), frames);
+            EXPECT_EQ(decoder.channels(), channels);
+            EXPECT_EQ(decoder.samplerate(), 44100);
+
+            const auto tolerance = (format == io::pcm_format::int16) ? 2.0 / 32768 : 2.0 / 8388608;
+            std::vector<float> decoded(channels * frames);
+            EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), channels * frames);
+            for (auto i = 0; i < channels * frames; ++i) {
+                EXPECT_NEAR(decoded[i], data[i], tolerance);
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TestingEncoder, WavLayout) {
+    const auto path = std::string("testing_layout.wav");
+    const auto read = [&path]() {
+        std::ifstream file(path, std::ios::binary);
+        return bytes(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    const auto le = [](const bytes& data, std::size_t position, std::size_t width) {
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            value |= static_cast<std::uint32_t>(data[position + i]) << (8 * i);
+        }
+        return value;
+    };
+
+    // Odd sized data is padded, and 24 bits need the extensible format
+    const std::vector<float> mono = {0.25f, -0.5f, 0.75f};
+    io::encoder<float> encoder;
+    ASSERT_TRUE(encoder.open(path, 1, 48000, io::pcm_format::int24));
+    EXPECT_EQ(encoder.write(std::cbegin(mono), std::cend(mono)), 3);
+    encoder.close();
+
+    auto data = read();
+    ASSERT_EQ(data.size(), 68 + 9 + 1);
+    EXPECT_EQ(le(data, 4, 4), data.size() - 8);
+    EXPECT_EQ(le(data, 16, 4), 40);
+    EXPECT_EQ(le(data, 20, 2), 0xFFFE);
+    EXPECT_EQ(le(data, 38, 2), 24);
+    EXPECT_EQ(le(data, 44, 2), 1);
+    EXPECT_EQ(le(data, 64, 4), 9);
+
+    io::decoder<float> decoder;
+    ASSERT_TRUE(decoder.open(path));
+    EXPECT_EQ(decoder.frames(), 3);
+    std::vector<float> decoded(3);
+    EXPECT_EQ(decoder.read(std::begin(decoded), std::end(decoded)), 3);
+    for (auto i = 0ul; i < mono.size(); ++i) {
+        EXPECT_NEAR(decoded[i], mono[i], 1e-6);
+    }
+    decoder.close();
+
+    // A frame larger than the internal buffer of the encoder
+    constexpr auto channels = 5000l;
+    std::vector<float> wide(2 * channels);
+    for (auto i = 0ul; i < wide.size(); ++i) {
+        wide[i] = static_cast<float>(i % 100) / 100;
+    }
+    ASSERT_TRUE(encoder.open(path, channels, 48000, io::pcm_format::float32));
+    EXPECT_EQ(encoder.write(std::cbegin(wide), std::cend(wide)), 2 * channels);
+    encoder.close();
+
+    data = read();
+    ASSERT_EQ(data.size(), 68 + wide.size() * 4);
+    EXPECT_EQ(le(data, 20, 2), 0xFFFE);
+    EXPECT_EQ(le(data, 44, 2), 3);
+    io::decoder<float, 2 * channels> wide_decoder;
+    ASSERT_TRUE(wide_decoder.open(path));
+    EXPECT_EQ(wide_decoder.channels(), channels);
+    decoded.resize(wide.size());
+    EXPECT_EQ(wide_decoder.read(std::begin(decoded), std::end(decoded)), static_cast<long>(wide.size()));
+    EXPECT_EQ(decoded, wide);
+    wide_decoder.close();
+    std::remove(path.c_str());
+}
+
+TEST(TestingParallelDecoder, MatchesSequentialDecoding) {
+    const auto path     = std::string("testing_parallel_decoder.wav");
+    const auto channels = 3;
+    const auto frames   = 10000;
+    bytes encoded;
+    for (auto i = 0; i < channels * frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i * 13), 2, io::byte_order::little);
+    }
+    save(path, make_wav(1, 16, channels, encoded));
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(path));
+    std::vector<float> expected(channels * frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), channels * frames);
+
+    io::parallel_decoder<float> decoder(4, 777);
+    ASSERT_TRUE(decoder.open(path));
+    EXPECT_EQ(decoder.channels(), channels);
+    EXPECT_EQ(decoder.frames(), frames);
+
+    std::vector<float> decoded(channels * frames);
+    EXPECT_EQ(decoder.read(0, std::begin(decoded), std::end(decoded)), channels * frames);
+    EXPECT_EQ(decoded, expected);
+
+    // The range is truncated at the end of the file
+    std::vector<float> tail(channels * 1000);
+    EXPECT_EQ(decoder.read(frames - 300, std::begin(tail), std::end(tail)), channels * 300);
+    EXPECT_TRUE(std::equal(std::begin(tail), std::begin(tail) + channels * 300,
+                           std::begin(expected) + channels * (frames - 300)));
+
+    std::vector<float> chunked(channels * frames);
+    const auto position = 1234;
+    const auto total    = decoder.for_each(position, frames, [&](std::ptrdiff_t start, const float* first,
+                                                                      const float* last) {
+        std::copy(first, last, std::begin(chunked) + channels * (start - position));
+    });
+    EXPECT_EQ(total, channels * (frames - position));
+    EXPECT_TRUE(std::equal(std::begin(chunked), std::begin(chunked) + total, std::begin(expected) + channels * position));
+    std::remove(path.c_str());
+}
+
+TEST(TestingParallelDecoder, ShortReads) {
+    const auto path     = std::string("testing_parallel_decoder_short.wav");
+    const auto channels = 2;
+    const auto frames   = 10000;
+    bytes encoded;
+    for (auto i = 0; i < channels * frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i * 17), 2, io::byte_order::little);
+    }
+    auto data = make_wav(1, 16, channels, encoded);
+    save(path, data);
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(path));
+    std::vector<float> expected(channels * frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), channels * frames);
+    reference.close();
+
+    io::parallel_decoder<float> decoder(4, 1000);
+    ASSERT_TRUE(decoder.open(path));
+
+    // Empty requests do not start any thread
+    std::vector<float> decoded(channels * frames), empty;
+    EXPECT_EQ(decoder.read(100, std::begin(empty), std::end(empty)), 0);
+    EXPECT_EQ(decoder.for_each(100, 0, [](std::ptrdiff_t, const float*, const float*) { FAIL(); }), 0);
+
+    // The file is shorter than announced by its header: the count stops at the first incomplete chunk
+    const auto available = 6500;
+    data.resize(data.size() - (frames - available) * channels * 2);
+    save(path, data);
+    EXPECT_EQ(decoder.read(0, std::begin(decoded), std::end(decoded)), channels * available);
+    EXPECT_TRUE(std::equal(std::begin(decoded), std::begin(decoded) + channels * available, std::begin(expected)));
+
+    // The handles of the workers cannot be opened anymore
+    std::remove(path.c_str());
+    EXPECT_EQ(decoder.read(0, std::begin(decoded), std::end(decoded)), 0);
+}
+
+TEST(TestingCachedReader, RandomAccess) {
+    const auto path     = std::string("testing_cached_reader.wav");
+    const auto channels = 2;
+    const auto frames   = 10000;
+    bytes encoded;
+    for (auto i = 0; i < channels * frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i * 11), 2, io::byte_order::little);
+    }
+    save(path, make_wav(1, 16, channels, encoded));
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(path));
+    std::vector<float> expected(channels * frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), channels * frames);
+
+    // Budget for four blocks
+    const auto block_bytes = 1000 * channels * sizeof(float);
+    io::cached_reader<float> reader(1000, 4 * block_bytes);
+    const auto file = reader.open(path);
+    ASSERT_GE(file, 0);
+    EXPECT_EQ(reader.channels(file), channels);
+    EXPECT_EQ(reader.frames(file), frames);
+    EXPECT_EQ(reader.open("missing_file.wav"), -1);
+
+    // The window crosses two blocks
+    std::vector<float> window(channels * 300);
+    EXPECT_EQ(reader.read(file, 1850, window), channels * 300);
+    EXPECT_TRUE(std::equal(std::begin(window), std::end(window), std::begin(expected) + channels * 1850));
+    EXPECT_EQ(reader.misses(), 2);
+    EXPECT_EQ(reader.hits(), 0);
+
+    EXPECT_EQ(reader.read(file, 1900, window), channels * 300);
+    EXPECT_TRUE(std::equal(std::begin(window), std::end(window), std::begin(expected) + channels * 1900));
+    EXPECT_EQ(reader.misses(), 2);
+    EXPECT_EQ(reader.hits(), 2);
+
+    // Least recently used blocks are evicted to keep the memory budget
+    for (const auto position : {5000, 7000, 9000, 3000, 1000}) {
+        EXPECT_EQ(reader.read(file, position, window), channels * 300);
+        EXPECT_TRUE(std::equal(std::begin(window), std::end(window), std::begin(expected) + channels * position));
+        EXPECT_LE(reader.memory_usage(), reader.memory_budget());
+    }
+    EXPECT_EQ(reader.misses(), 7);
+    EXPECT_EQ(reader.hits(), 2);
+
+    // Zero-copy views inside a block
+    const auto view = reader.view(file, 9100, 50);
+    ASSERT_EQ(view.size(), channels * 50);
+    EXPECT_TRUE(std::equal(std::begin(view), std::end(view), std::begin(expected) + channels * 9100));
+    EXPECT_EQ(reader.view(file, 9100, 50).data(), view.data());
+    EXPECT_TRUE(reader.view(file, 9950, 100).empty());
+    EXPECT_EQ(reader.view(file, 9950, 50).size(), channels * 50);
+
+    // Reads are truncated at the end of the file
+    EXPECT_EQ(reader.read(file, frames - 100, window), channels * 100);
+    EXPECT_EQ(reader.read(file, frames + 100, window), 0);
+
+    reader.close(file);
+    EXPECT_FALSE(reader.is_open(file));
+    EXPECT_EQ(reader.memory_usage(), 0);
+    std::remove(path.c_str());
+}
+
+TEST(TestingCachedReader, SequentialPrefetch) {
+    const auto path   = std::string("testing_cached_reader_prefetch.wav");
+    const auto frames = 8000;
+    bytes encoded;
+    for (auto i = 0; i < frames; ++i) {
+        append(encoded, static_cast<std::uint16_t>(i * 5), 2, io::byte_order::little);
+    }
+    save(path, make_wav(1, 16, 1, encoded));
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(path));
+    std::vector<float> expected(frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), frames);
+
+    io::cached_reader<float> reader(500, 8 * 500 * sizeof(float), 3);
+    const auto file = reader.open(path);
+    ASSERT_GE(file, 0);
+
+    std::vector<float> window(250);
+    for (auto position = 0; position < frames; position += 250) {
+        EXPECT_EQ(reader.read(file, position, window), 250);
+        EXPECT_TRUE(std::equal(std::begin(window), std::end(window), std::begin(expected) + position));
+    }
+
+    // Every miss decodes the next three blocks
+    EXPECT_EQ(reader.misses() + reader.prefetched(), 16);
+    EXPECT_EQ(reader.misses(), 4);
+    EXPECT_EQ(reader.hits(), 32 - 4);
+    std::remove(path.c_str());
+}
+
+TEST(TestingCachedReader, MixedChannelCounts) {
+    const auto wide_path   = std::string("testing_cached_reader_wide.wav");
+    const auto narrow_path = std::string("testing_cached_reader_narrow.wav");
+    const auto frames      = 4000;
+    bytes wide, narrow;
+    for (auto i = 0; i < 8 * frames; ++i) {
+        append(wide, static_cast<std::uint16_t>(i * 3), 2, io::byte_order::little);
+    }
+    for (auto i = 0; i < frames; ++i) {
+        append(narrow, static_cast<std::uint16_t>(i * 7), 2, io::byte_order::little);
+    }
+    save(wide_path, make_wav(1, 16, 8, wide));
+    save(narrow_path, make_wav(1, 16, 1, narrow));
+
+    io::decoder<float> reference;
+    ASSERT_TRUE(reference.open(narrow_path));
+    std::vector<float> expected(frames);
+    ASSERT_EQ(reference.read(std::begin(expected), std::end(expected)), frames);
+
+    // The budget holds a single block of the wide file, or eight blocks of the narrow one
+    io::cached_reader<float> reader(500, 8 * 500 * sizeof(float), 3);
+    const auto wide_file   = reader.open(wide_path);
+    const auto narrow_file = reader.open(narrow_path);
+    ASSERT_GE(wide_file, 0);
+    ASSERT_GE(narrow_file, 0);
+
+    std::vector<float> frame(8), window(250);
+    for (auto position = 0; position < frames; position += 250) {
+        EXPECT_EQ(reader.read(wide_file, position, frame), 8);
+        EXPECT_LE(reader.memory_usage(), reader.memory_budget());
+
+        // The storage evicted from the wide file is not reused, and the prefetch keeps the requested block
+        EXPECT_EQ(reader.read(narrow_file, position, window), 250);
+        EXPECT_TRUE(std::equal(std::begin(window), std::end(window), std::begin(expected) + position));
+        EXPECT_LE(reader.memory_usage(), reader.memory_budget());
+    }
+    std::remove(wide_path.c_str());
+    std::remove(narrow_path.c_str());
+}
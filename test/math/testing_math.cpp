@@ -0,0 +1,163 @@
+/*
+ * eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+ * Copyright (C) 2018 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along withº
+ * this program.  If not, see <http://www.gnu.org/licenses/>
+
+ * File: testing_math.cpp
+ * Author Mohammed Boujemaoui Boulaghmoudi on 21/10/18.
+ */
+
+#include <edsp/math.hpp>
+#include <edsp/math/compile_time.hpp>
+#include <edsp/converter/mag2db.hpp>
+#include <edsp/converter/db2mag.hpp>
+#include <edsp/windowing/hamming.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+static const auto MINIMUM_SIZE = 16ul;
+static const auto MAXIMUM_SIZE = 2048ul;
+
+using namespace edsp;
+
+namespace {
+
+    double ulp_error(float value, double reference) {
+        const auto rounded = static_cast<float>(reference);
+        const auto ulp     = std::nextafter(std::abs(rounded), std::numeric_limits<float>::infinity()) - std::abs(rounded);
+        return std::abs(value - reference) / ulp;
+    }
+
+} // namespace
+
+TEST(TestingCompileTimeMath, MatchesStandardLibrary) {
+    constexpr auto sine = compile_time::sin(0.5);
+    static_assert(sine > 0.479 && sine < 0.48, "Expected a constant expression");
+
+    const auto ulp = [](double value, double reference) {
+        const auto step = std::nextafter(std::abs(reference), std::numeric_limits<double>::infinity()) -
+                          std::abs(reference);
+        return std::abs(value - reference) / step;
+    };
+
+    const auto size = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    for (auto i = 0ul; i < size; ++i) {
+        const auto x = math::rand<double>(-10, 10);
+        EXPECT_LE(ulp(compile_time::sin(x), std::sin(x)), 1);
+        EXPECT_LE(ulp(compile_time::cos(x), std::cos(x)), 1);
+        EXPECT_LE(ulp(compile_time::tan(x), std::tan(x)), 1);
+        EXPECT_LE(ulp(compile_time::exp(x), std::exp(x)), 1);
+
+        const auto y = math::rand<double>(1e-20, 1e20);
+        EXPECT_LE(ulp(compile_time::log(y), std::log(y)), 1);
+        EXPECT_LE(ulp(compile_time::log10(y), std::log10(y)), 1);
+        EXPECT_LE(ulp(compile_time::sqrt(y), std::sqrt(y)), 1);
+        EXPECT_LE(ulp(compile_time::pow(y, x / 10), std::pow(y, x / 10)), 1);
+    }
+
+    EXPECT_TRUE(std::isnan(compile_time::sqrt(-1.0)));
+    EXPECT_TRUE(std::isnan(compile_time::log(-1.0)));
+    EXPECT_EQ(compile_time::log(0.0), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(compile_time::pow(-2.0, 3.0), -8.0);
+    EXPECT_EQ(compile_time::exp(1000.0), std::numeric_limits<double>::infinity());
+}
+
+TEST(TestingFastMath, ExponentialAndLogarithm) {
+    const auto size = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    for (auto i = 0ul; i < size; ++i) {
+        const auto x = math::rand<float>(-80, 80);
+        EXPECT_LE(ulp_error(fast::exp(x), std::exp(static_cast<double>(x))), 2);
+
+        const auto y = math::rand<float>(1e-20f, 1e20f);
+        EXPECT_LE(ulp_error(fast::log(y), std::log(static_cast<double>(y))), 2);
+        EXPECT_LE(ulp_error(fast::log2(y), std::log2(static_cast<double>(y))), 4);
+        EXPECT_LE(ulp_error(fast::log10(y), std::log10(static_cast<double>(y))), 4);
+    }
+}
+
+TEST(TestingFastMath, Trigonometric) {
+    const auto size = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    for (auto i = 0ul; i < size; ++i) {
+        const auto x = math::rand<float>(-constants<float>::pi, constants<float>::pi);
+        EXPECT_LE(ulp_error(fast::sin(x), std::sin(static_cast<double>(x))), 2);
+        EXPECT_LE(ulp_error(fast::cos(x), std::cos(static_cast<double>(x))), 2);
+
+        const auto y = math::rand<float>(-100, 100);
+        EXPECT_LE(ulp_error(fast::atan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x))), 3);
+    }
+}
+
+TEST(TestingFastMath, SpecialValues) {
+    EXPECT_EQ(fast::log(0.0f), -std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(fast::log(-1.0f)));
+    EXPECT_EQ(fast::log(std::numeric_limits<float>::infinity()), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(fast::exp(-200.0f), 0.0f);
+    EXPECT_EQ(fast::exp(200.0f), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(fast::exp(0.0f), 1.0f);
+    EXPECT_EQ(fast::cos(0.0f), 1.0f);
+    EXPECT_FLOAT_EQ(fast::atan2(0.0f, -1.0f), constants<float>::pi);
+    EXPECT_EQ(fast::pow(0.5f, 0.0f), 1.0f);
+
+    const auto inf = std::numeric_limits<float>::infinity();
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    for (const auto x : {inf, -inf, nan, 1e10f, -1e10f}) {
+        EXPECT_EQ(std::isnan(fast::sin(x)), std::isnan(std::sin(x)));
+        EXPECT_EQ(std::isnan(fast::cos(x)), std::isnan(std::cos(x)));
+    }
+    for (const auto x : {-1.0f, -1e-40f, -inf, nan}) {
+        EXPECT_TRUE(std::isnan(fast::log(x)));
+        EXPECT_TRUE(std::isnan(fast::log2(x)));
+        EXPECT_TRUE(std::isnan(fast::log10(x)));
+    }
+    EXPECT_EQ(fast::log2(1e-40f), std::log2(1e-40f));
+    EXPECT_EQ(fast::pow(1.0f, inf), 1.0f);
+    EXPECT_EQ(fast::pow(1.0f, -inf), 1.0f);
+    EXPECT_EQ(fast::pow(1.0f, nan), 1.0f);
+    EXPECT_EQ(fast::pow(nan, 0.0f), 1.0f);
+    EXPECT_EQ(fast::pow(0.5f, inf), 0.0f);
+    EXPECT_EQ(fast::pow(2.0f, inf), inf);
+    EXPECT_EQ(fast::pow(0.0f, -1.0f), inf);
+    EXPECT_TRUE(std::isnan(fast::pow(2.0f, nan)));
+    EXPECT_TRUE(std::isnan(fast::exp(nan)));
+    EXPECT_EQ(fast::exp(-inf), 0.0f);
+    EXPECT_EQ(fast::exp2(inf), inf);
+}
+
+TEST(TestingFastMath, BlockConverters) {
+    const auto size = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    std::vector<float> data(size), db(size), magnitude(size);
+    for (auto& element : data) {
+        element = math::rand<float>(1e-6f, 1e6f);
+    }
+
+    converter::mag2db(std::cbegin(data), std::cend(data), std::begin(db));
+    converter::db2mag(std::cbegin(db), std::cend(db), std::begin(magnitude));
+    for (auto i = 0ul; i < size; ++i) {
+        EXPECT_NEAR(db[i], converter::mag2db(data[i]), 1e-4);
+        EXPECT_NEAR(magnitude[i] / data[i], 1, 1e-5);
+    }
+}
+
+TEST(TestingFastMath, FloatWindow) {
+    const auto size = math::rand(MINIMUM_SIZE, MAXIMUM_SIZE);
+    std::vector<float> window(size);
+    std::vector<double> reference(size);
+    windowing::hamming(std::begin(window), std::end(window));
+    windowing::hamming(std::begin(reference), std::end(reference));
+    for (auto i = 0ul; i < size; ++i) {
+        EXPECT_NEAR(window[i], reference[i], 1e-6);
+    }
+}
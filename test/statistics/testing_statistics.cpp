@@ -22,6 +22,10 @@
 
 #include <edsp/statistics.hpp>
 #include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
 
 using namespace edsp::statistics;
 
@@ -197,4 +201,135 @@ TEST(TestingStatistics, ComputeHammingWindowPeak) {
     const auto maximum_abs   = ::maxabs(std::cbegin(hamming_reference), std::cend(hamming_reference));
     EXPECT_EQ(candidate_abs.second, maximum_abs);
     EXPECT_EQ(hamming_reference[candidate_abs.first], maximum_abs);
-}
\ No newline at end of file
+}
+
+namespace {
+    // Two passes over the data with the mean subtracted first
+    std::array<double, 4> central_moments(const std::vector<double>& data) {
+        auto mean = 0.0;
+        for (const auto x : data) {
+            mean += x;
+        }
+        mean /= static_cast<double>(data.size());
+        std::array<double, 4> result = {{mean, 0, 0, 0}};
+        for (const auto x : data) {
+            const auto d = x - mean;
+            result[1] += d * d;
+            result[2] += d * d * d;
+            result[3] += d * d * d * d;
+        }
+        for (auto i = 1ul; i < result.size(); ++i) {
+            result[i] /= static_cast<double>(data.size());
+        }
+        return result;
+    }
+} // namespace
+
+TEST(TestingStatistics, MomentsAccumulatorSinglePass) {
+    // A large offset, which makes the raw sums of powers useless, and limits the accuracy of any method to ~1e-10
+    std::vector<double> data(5003);
+    for (auto i = 0ul; i < data.size(); ++i) {
+        data[i] = 1e6 + std::sin(0.1 * i) + 0.5 * std::cos(0.37 * i * i) + 0.001 * i;
+    }
+    const auto reference = central_moments(data);
+
+    moments_accumulator<double> block;
+    block.push(std::cbegin(data), std::cend(data));
+    ASSERT_EQ(block.count(), data.size());
+    EXPECT_NEAR(block.mean(), reference[0], 1e-6);
+    EXPECT_NEAR(block.variance(), reference[1], 1e-8);
+    EXPECT_NEAR(block.standard_deviation(), std::sqrt(reference[1]), 1e-8);
+    EXPECT_NEAR(block.skewness(), reference[2] / std::pow(reference[1], 1.5), 1e-7);
+    EXPECT_NEAR(block.kurtosis(), reference[3] / (reference[1] * reference[1]), 1e-8);
+
+    // One value at a time with the update of Welford
+    moments_accumulator<double> single;
+    for (const auto x : data) {
+        single.push(x);
+    }
+    EXPECT_NEAR(single.mean(), block.mean(), 1e-6);
+    EXPECT_NEAR(single.variance(), block.variance(), 1e-8);
+    EXPECT_NEAR(single.skewness(), block.skewness(), 1e-7);
+    EXPECT_NEAR(single.kurtosis(), block.kurtosis(), 1e-8);
+
+    // Partial results of uneven blocks, as computed by different threads
+    moments_accumulator<double> merged, empty;
+    for (auto i = 0ul; i < data.size(); i += 777) {
+        moments_accumulator<double> partial;
+        partial.push(std::cbegin(data) + i, std::cbegin(data) + std::min(data.size(), i + 777));
+        merged.merge(partial);
+    }
+    merged.merge(empty);
+    ASSERT_EQ(merged.count(), data.size());
+    EXPECT_NEAR(merged.mean(), block.mean(), 1e-6);
+    EXPECT_NEAR(merged.variance(), block.variance(), 1e-8);
+    EXPECT_NEAR(merged.skewness(), block.skewness(), 1e-7);
+    EXPECT_NEAR(merged.kurtosis(), block.kurtosis(), 1e-8);
+
+    merged.reset();
+    EXPECT_EQ(merged.count(), 0);
+}
+
+TEST(TestingStatistics, MomentsMatchFreeFunctions) {
+    std::vector<double> data(1000);
+    for (auto i = 0ul; i < data.size(); ++i) {
+        data[i] = std::exp(std::sin(0.05 * i));
+    }
+    const auto reference = central_moments(data);
+    EXPECT_NEAR(::moment<2>(std::cbegin(data), std::cend(data)), reference[1], 1e-12);
+    EXPECT_NEAR(::moment<3>(std::cbegin(data), std::cend(data)), reference[2], 1e-12);
+    EXPECT_NEAR(::moment<4>(std::cbegin(data), std::cend(data)), reference[3], 1e-12);
+    EXPECT_NEAR(::variance(std::cbegin(data), std::cend(data)), reference[1], 1e-12);
+    EXPECT_NEAR(::skewness(std::cbegin(data), std::cend(data)), reference[2] / std::pow(reference[1], 1.5), 1e-12);
+    EXPECT_NEAR(::kurtosis(std::cbegin(data), std::cend(data)), reference[3] / (reference[1] * reference[1]), 1e-12);
+}
+
+TEST(TestingStatistics, ExecutionPoliciesAreReproducible) {
+    std::vector<double> data(100003);
+    for (auto i = 0ul; i < data.size(); ++i) {
+        data[i] = 1.5 + std::sin(0.001 * i) + 0.25 * std::cos(0.37 * i);
+    }
+    data[4242] = data[77777] = 10;
+
+    const auto first = std::cbegin(data);
+    const auto last  = std::cend(data);
+    const execution::sequenced_policy seq{1000};
+    for (const auto threads : {1ul, 3ul, 8ul}) {
+        const execution::parallel_policy par{threads, 1000};
+        EXPECT_EQ(mean(par, first, last), mean(seq, first, last));
+        EXPECT_EQ(norm(par, first, last), norm(seq, first, last));
+        EXPECT_EQ(generalized_mean(par, first, last, 3), generalized_mean(seq, first, last, 3));
+        EXPECT_EQ(geometric_mean(par, first, last), geometric_mean(seq, first, last));
+        EXPECT_EQ(harmonic_mean(par, first, last), harmonic_mean(seq, first, last));
+        EXPECT_EQ(entropy(par, first, last), entropy(seq, first, last));
+        EXPECT_EQ(peak(par, first, last), peak(seq, first, last));
+        EXPECT_EQ(min(par, first, last), min(seq, first, last));
+    }
+
+    EXPECT_NEAR(mean(execution::par, first, last), ::mean(first, last), 1e-12);
+    EXPECT_NEAR(norm(execution::par, first, last), ::norm(first, last), 1e-9);
+    EXPECT_NEAR(generalized_mean(execution::par, first, last, 3), ::generalized_mean(first, last, 3), 1e-12);
+    const auto logarithms = std::accumulate(first, last, 0.0, [](double acc, double x) { return acc + std::log(x); });
+    EXPECT_NEAR(geometric_mean(execution::par, first, last), std::exp(logarithms / data.size()), 1e-12);
+    EXPECT_NEAR(harmonic_mean(execution::par, first, last), ::harmonic_mean(first, last), 1e-12);
+    EXPECT_NEAR(entropy(execution::par, first, last), ::entropy(first, last), 1e-9);
+    EXPECT_EQ(max(execution::par, first, last), ::max(first, last));
+    EXPECT_EQ(min(execution::par, first, last), ::min(first, last));
+    EXPECT_EQ(maxabs(execution::par, first, last), ::maxabs(first, last));
+    EXPECT_EQ(minabs(execution::par, first, last), ::minabs(first, last));
+    EXPECT_EQ(peakabs(execution::par, first, last), ::peakabs(first, last));
+
+    // The first of two equal maxima in different chunks
+    const auto result = peak(execution::parallel_policy{4, 1000}, first, last);
+    EXPECT_EQ(result.first, 4242);
+    EXPECT_EQ(result.second, 10);
+}
+
+TEST(TestingStatistics, ReduceEmptyRange) {
+    const std::vector<double> data;
+    const auto partial = [](std::vector<double>::const_iterator first, std::vector<double>::const_iterator last,
+                            std::size_t) { return std::accumulate(first, last, 1.0); };
+    const auto combine = [](double left, double right) { return left + right; };
+    EXPECT_EQ(reduce(execution::seq, std::cbegin(data), std::cend(data), partial, combine), 0);
+    EXPECT_EQ(reduce(execution::par, std::cbegin(data), std::cend(data), partial, combine), 0);
+}
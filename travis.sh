@@ -35,7 +35,8 @@ showinfo "Building the library..."
 cd ${TRAVIS_BUILD_DIR}
 mkdir -p build
 cd build
-cmake -DCMAKE_BUILD_TYPE=Debug -DUSE_LIBFFTW=ON -DBUILD_BENCHMARKS=ON -DBUILD_TESTS=ON -DBUILD_EXTENSIONS=ON -DBUILD_DOCS=OFF -DENABLE_DEBUG_INFORMATION=ON -DBUILD_EXAMPLES=ON -DENABLE_COVERAGE=ON ..
+# Unoptimized on purpose: the missing definitions of the ODR-used constants only show up at link time at -O0
+cmake -DCMAKE_BUILD_TYPE=Debug -DCMAKE_CXX_FLAGS_DEBUG="-O0 -g" -DUSE_LIBFFTW=ON -DUSE_LIBSAMPLERATE=ON -DBUILD_BENCHMARKS=ON -DBUILD_TESTS=ON -DBUILD_EXTENSIONS=ON -DBUILD_DOCS=OFF -DENABLE_DEBUG_INFORMATION=ON -DBUILD_EXAMPLES=ON -DENABLE_COVERAGE=ON ..
 make -j8
 if [ $? -ne 0 ]; then
     error "Error: there are compile errors!"